@@ -83,3 +83,30 @@ assert.eq({_id: 1}, t.find({_id: 1}).returnKey().next());
 
 // Non-simple: .returnKey() overrides other projections.
 assert.eq({_id: 1}, t.find({_id: 1}, {a: 1}).returnKey().next());
+
+//
+// Point reads by _id answered directly from the _id index by the find command.
+//
+
+// A single matching document is returned in one batch without a cursor.
+var res = assert.commandWorked(db.runCommand({find: t.getName(), filter: {_id: 1}}));
+assert.eq([{_id: 1, a: 1, b: [{c: 3}, {c: 4}]}], res.cursor.firstBatch);
+assert.eq(0, res.cursor.id);
+
+// A missing _id returns an empty batch.
+res = assert.commandWorked(db.runCommand({find: t.getName(), filter: {_id: 5}}));
+assert.eq([], res.cursor.firstBatch);
+assert.eq(0, res.cursor.id);
+
+// A batch size of zero still returns an empty first batch and an open cursor.
+res = assert.commandWorked(db.runCommand({find: t.getName(), filter: {_id: 1}, batchSize: 0}));
+assert.eq([], res.cursor.firstBatch);
+assert.neq(0, res.cursor.id);
+assert.eq(1, new DBCommandCursor(db, res).itcount());
+
+// $isolated is still rejected by the find command.
+assert.commandFailed(db.runCommand({find: t.getName(), filter: {_id: 1, $isolated: 1}}));
+
+// A missing collection returns an empty batch.
+res = assert.commandWorked(db.runCommand({find: "idhack_missing", filter: {_id: 1}}));
+assert.eq([], res.cursor.firstBatch);
@@ -56,6 +56,11 @@ load('./jstests/libs/chunk_manipulation_util.js');
                                         {"_id": {"$maxKey": 1}},
                                         coll + "");
 
+    // Every active migration is also listed, which here is just the one.
+    assert.eq(1, shard0ServerStatus.sharding.activeMigrations.length);
+    assert.eq(shard0ServerStatus.sharding.migrations,
+              shard0ServerStatus.sharding.activeMigrations[0]);
+
     // Destination shard should not return any migration status.
     var shard1ServerStatus = st.shard1.getDB('admin').runCommand({serverStatus: 1});
     assert(!shard1ServerStatus.sharding.migrations);
@@ -265,6 +265,16 @@ public:
         const int ntoskip = -1;
         beginQueryOp(opCtx, nss, cmdObj, ntoreturn, ntoskip);
 
+        AutoGetCollectionOrViewForReadCommand ctx(opCtx, nss, std::move(dbSLock));
+        Collection* collection = ctx.getCollection();
+
+        // Point reads by _id are answered straight from the _id index, without a CanonicalQuery
+        // or a PlanExecutor.
+        if (!ctx.getView() && isExpressIdQuery(opCtx, collection, nss, *qr)) {
+            runExpressIdQuery(opCtx, collection, nss, *qr, &result);
+            return true;
+        }
+
         // Finish the parsing step by using the QueryRequest to create a CanonicalQuery.
         ExtensionsCallbackReal extensionsCallback(opCtx, &nss);
         const boost::intrusive_ptr<ExpressionContext> expCtx;
@@ -280,8 +290,6 @@ public:
         }
         std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
 
-        AutoGetCollectionOrViewForReadCommand ctx(opCtx, nss, std::move(dbSLock));
-        Collection* collection = ctx.getCollection();
         if (ctx.getView()) {
             // Relinquish locks. The aggregation command will re-acquire them.
             ctx.releaseLocksForView();
@@ -47,6 +47,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/platform/process_id.h"
+#include "mongo/transport/message_buffer_pool.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/util/log.h"
@@ -94,6 +95,9 @@ public:
              BSONObjBuilder& result) {
         _runCalled = true;
 
+        // Monitoring must keep working when the server is saturated.
+        opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kImmediate);
+
         const auto service = opCtx->getServiceContext();
         const auto clock = service->getFastClockSource();
         const auto runStart = clock->now();
@@ -299,6 +303,7 @@ public:
         BSONObjBuilder b;
         networkCounter.append(b);
         appendMessageCompressionStats(&b);
+        transport::MessageBufferPool::get().appendStats(&b);
         auto executor = opCtx->getServiceContext()->getServiceExecutor();
         if (executor)
             executor->appendStats(&b);
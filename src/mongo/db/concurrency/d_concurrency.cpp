@@ -36,6 +36,7 @@
 #include <vector>
 
 #include "mongo/db/concurrency/global_lock_acquisition_tracker.h"
+#include "mongo/db/concurrency/lock_contention_tracker.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
@@ -206,6 +207,7 @@ Lock::DBLock::DBLock(OperationContext* opCtx, StringData db, LockMode mode)
         _mode = MODE_X;
     }
 
+    LockContentionTracker::ScopedResourceName resourceName(_id, db);
     invariant(LOCK_OK == _opCtx->lockState()->lock(_id, _mode));
 }
 
@@ -244,6 +246,7 @@ Lock::CollectionLock::CollectionLock(Locker* lockState, StringData ns, LockMode
 
     dassert(_lockState->isDbLockedForMode(nsToDatabaseSubstring(ns),
                                           isSharedLockMode(mode) ? MODE_IS : MODE_IX));
+    LockContentionTracker::ScopedResourceName resourceName(_id, ns);
     if (supportsDocLocking()) {
         _lockState->lock(_id, mode);
     } else {
@@ -1002,6 +1002,27 @@ TEST_F(DConcurrencyTestFixture, Throttling) {
     ASSERT(!overlongWait);
 }
 
+TEST_F(DConcurrencyTestFixture, ImmediateAdmissionBypassesThrottling) {
+    auto clientOpctxPairs = makeKClientsWithLockers<DefaultLockerImpl>(2);
+    auto opctx1 = clientOpctxPairs[0].second.get();
+    auto opctx2 = clientOpctxPairs[1].second.get();
+    UseGlobalThrottling throttle(opctx1, 1);
+
+    Lock::GlobalRead R1(opctx1, 0);
+    ASSERT(R1.isLocked());
+
+    {
+        Lock::GlobalRead R2(opctx2, 0);
+        ASSERT(!R2.isLocked());
+    }
+
+    opctx2->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kImmediate);
+    {
+        Lock::GlobalRead R2(opctx2, 0);
+        ASSERT(R2.isLocked());
+    }
+}
+
 TEST_F(DConcurrencyTestFixture, CompatibleFirstWithSXIS) {
     auto clientOpctxPairs = makeKClientsWithLockers<DefaultLockerImpl>(3);
     auto opctx1 = clientOpctxPairs[0].second.get();
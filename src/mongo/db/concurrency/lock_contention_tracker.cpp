@@ -0,0 +1,240 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/lock_contention_tracker.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/platform/bits.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+namespace {
+
+MONGO_EXPORT_SERVER_PARAMETER(lockContentionTrackingEnabled, bool, false);
+
+// Number of resources reported by LockContentionTracker::report in serverStatus.
+MONGO_EXPORT_SERVER_PARAMETER(lockContentionTrackingTopN, int, 10);
+
+LockContentionTracker globalLockContentionTracker;
+
+// The resource named by the innermost ScopedResourceName on this thread.
+thread_local ResourceId currentResourceId;
+thread_local StringData currentResourceName;
+
+}  // namespace
+
+int LatencyHistogram::bucketFor(uint64_t micros) {
+    if (micros < static_cast<uint64_t>(kSubBuckets))
+        return static_cast<int>(micros);
+
+    const int exponent = 63 - countLeadingZeros64(micros);
+    if (exponent >= kMaxExponent)
+        return kNumBuckets - 1;
+
+    const int subBucket = (micros >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < kSubBuckets)
+        return bucket;
+
+    const int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    const uint64_t subBucket = bucket % kSubBuckets;
+    const uint64_t subBucketWidth = 1ULL << (exponent - kSubBucketBits);
+    return (1ULL << exponent) + (subBucket + 1) * subBucketWidth - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    _counts[bucketFor(micros)]++;
+    _count++;
+    _max = std::max(_max, micros);
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const {
+    if (_count == 0)
+        return 0;
+
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(_count * percentile / 100));
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < kNumBuckets; ++bucket) {
+        seen += _counts[bucket];
+        if (seen >= rank)
+            return std::min(bucketUpperBound(bucket), _max);
+    }
+    return _max;
+}
+
+void LatencyHistogram::append(BSONObjBuilder* builder) const {
+    builder->append("count", static_cast<long long>(_count));
+    builder->append("p50", static_cast<long long>(percentile(50)));
+    builder->append("p90", static_cast<long long>(percentile(90)));
+    builder->append("p99", static_cast<long long>(percentile(99)));
+    builder->append("max", static_cast<long long>(_max));
+}
+
+LockContentionTracker& LockContentionTracker::get() {
+    return globalLockContentionTracker;
+}
+
+bool LockContentionTracker::isEnabled() {
+    return lockContentionTrackingEnabled.load();
+}
+
+LockContentionTracker::ScopedResourceName::ScopedResourceName(ResourceId resId, StringData name)
+    : _previousResourceId(currentResourceId), _previousResourceName(currentResourceName) {
+    currentResourceId = resId;
+    currentResourceName = name;
+}
+
+LockContentionTracker::ScopedResourceName::~ScopedResourceName() {
+    currentResourceId = _previousResourceId;
+    currentResourceName = _previousResourceName;
+}
+
+void LockContentionTracker::recordWait(ResourceId resId, LockMode mode, uint64_t waitMicros) {
+    auto& shard = _getShard(resId);
+    stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+
+    auto& entry = shard.entries[resId];
+    if (!entry) {
+        if (_numTracked.fetchAndAdd(1) >= kMaxTrackedResources) {
+            _numTracked.fetchAndSubtract(1);
+            shard.entries.erase(resId);
+            _untrackedWaits.fetchAndAdd(1);
+            return;
+        }
+        entry = stdx::make_unique<Entry>();
+    }
+
+    if (entry->name.empty() && currentResourceId == resId) {
+        entry->name = currentResourceName.toString();
+    }
+
+    entry->waitsByMode[mode]++;
+    entry->totalWaitMicros += waitMicros;
+    entry->histogram.record(waitMicros);
+}
+
+std::string LockContentionTracker::getResourceName(ResourceId resId) const {
+    auto& shard = _getShard(resId);
+    stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+
+    auto it = shard.entries.find(resId);
+    return it == shard.entries.end() ? std::string() : it->second->name;
+}
+
+void LockContentionTracker::report(size_t topN, BSONObjBuilder* builder) const {
+    // Rank the resources by their wait time first and only copy the entries being reported, so
+    // that each sample holds the shard locks for as little as possible.
+    std::vector<std::pair<uint64_t, ResourceId>> waitTimes;
+    waitTimes.reserve(_numTracked.load());
+    for (auto& shard : _shards) {
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+        for (const auto& entry : shard.entries) {
+            waitTimes.emplace_back(entry.second->totalWaitMicros, entry.first);
+        }
+    }
+
+    const auto byWaitTime = [](const auto& a, const auto& b) { return a.first > b.first; };
+    topN = std::min(topN, waitTimes.size());
+    std::partial_sort(waitTimes.begin(), waitTimes.begin() + topN, waitTimes.end(), byWaitTime);
+
+    std::vector<std::pair<ResourceId, Entry>> entries;
+    entries.reserve(topN);
+    for (size_t i = 0; i < topN; ++i) {
+        const auto resId = waitTimes[i].second;
+        auto& shard = _getShard(resId);
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+
+        // The tracker may have been reset in the meantime.
+        auto it = shard.entries.find(resId);
+        if (it != shard.entries.end()) {
+            entries.emplace_back(resId, *it->second);
+        }
+    }
+
+    // Waits recorded since the ranking may have reordered the copied entries slightly.
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.second.totalWaitMicros > b.second.totalWaitMicros;
+    });
+
+    builder->append("trackedResources", static_cast<long long>(waitTimes.size()));
+    builder->append("untrackedWaits", _untrackedWaits.load());
+
+    BSONArrayBuilder topBuilder(builder->subarrayStart("top"));
+    for (const auto& resIdAndEntry : entries) {
+        const auto& resId = resIdAndEntry.first;
+        const auto& entry = resIdAndEntry.second;
+
+        BSONObjBuilder resourceBuilder(topBuilder.subobjStart());
+        resourceBuilder.append("type", resourceTypeName(resId.getType()));
+        if (!entry.name.empty()) {
+            resourceBuilder.append("name", entry.name);
+        }
+        resourceBuilder.append("resourceId", resId.toString());
+        resourceBuilder.append("totalWaitMicros", static_cast<long long>(entry.totalWaitMicros));
+
+        BSONObjBuilder modesBuilder(resourceBuilder.subobjStart("waits"));
+        for (int mode = 1; mode < LockModesCount; ++mode) {
+            if (entry.waitsByMode[mode]) {
+                modesBuilder.append(modeName(static_cast<LockMode>(mode)),
+                                    static_cast<long long>(entry.waitsByMode[mode]));
+            }
+        }
+        modesBuilder.done();
+
+        BSONObjBuilder latencyBuilder(resourceBuilder.subobjStart("waitMicros"));
+        entry.histogram.append(&latencyBuilder);
+    }
+}
+
+void LockContentionTracker::reset() {
+    for (auto& shard : _shards) {
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+        _numTracked.fetchAndSubtract(shard.entries.size());
+        shard.entries.clear();
+    }
+    _untrackedWaits.store(0);
+}
+
+LockContentionTracker::Shard& LockContentionTracker::_getShard(ResourceId resId) const {
+    return _shards[std::hash<ResourceId>()(resId) % kNumShards];
+}
+
+size_t getLockContentionTrackingTopN() {
+    return std::max(lockContentionTrackingTopN.load(), 0);
+}
+
+}  // namespace mongo
@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/concurrency/lock_manager_defs.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Log-linear histogram of latencies in microseconds, in the style of HdrHistogram. Every power of
+ * two is split into kSubBuckets equally sized buckets, so each recorded value is known to within
+ * 25% while the whole range up to 2^kMaxExponent micros (about 12 days) takes a few hundred
+ * counters. Not synchronized.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 2;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxExponent = 40;
+    static constexpr int kNumBuckets = kMaxExponent * kSubBuckets;
+
+    void record(uint64_t micros);
+
+    uint64_t count() const {
+        return _count;
+    }
+
+    uint64_t max() const {
+        return _max;
+    }
+
+    /**
+     * Returns the upper bound of the bucket holding the value below which 'percentile' percent
+     * of the recorded values fall, or 0 if nothing was recorded.
+     */
+    uint64_t percentile(double percentile) const;
+
+    /**
+     * Appends the count, the maximum and the 50th, 90th and 99th percentiles.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+    static int bucketFor(uint64_t micros);
+    static uint64_t bucketUpperBound(int bucket);
+
+private:
+    std::array<uint64_t, kNumBuckets> _counts{};
+    uint64_t _count = 0;
+    uint64_t _max = 0;
+};
+
+/**
+ * Profiles lock waits per ResourceId, so that the individual databases and collections behind
+ * the per-type numbers in LockStats can be identified. Only acquisitions that had to wait are
+ * recorded, and nothing is recorded unless the lockContentionTrackingEnabled server parameter is
+ * set, so uncontended locking does not pay for it.
+ */
+class LockContentionTracker {
+    MONGO_DISALLOW_COPYING(LockContentionTracker);
+
+public:
+    // Waits on resources beyond this many are only counted in aggregate.
+    static constexpr int64_t kMaxTrackedResources = 4096;
+
+    /**
+     * Gives the resource this thread is about to lock a human readable name for as long as it is
+     * in scope. Resource ids are hashes, so without a name a resource can only be reported by its
+     * id. The name is only picked up by recordWait, so uncontended acquisitions don't pay more
+     * than setting a thread local. 'name' must outlive this object. Scopes nest: the name that was
+     * in effect when this object was constructed is restored when it goes out of scope.
+     */
+    class ScopedResourceName {
+        MONGO_DISALLOW_COPYING(ScopedResourceName);
+
+    public:
+        ScopedResourceName(ResourceId resId, StringData name);
+        ~ScopedResourceName();
+
+    private:
+        const ResourceId _previousResourceId;
+        const StringData _previousResourceName;
+    };
+
+    LockContentionTracker() = default;
+
+    static LockContentionTracker& get();
+
+    /**
+     * Whether waits should be recorded in the global tracker.
+     */
+    static bool isEnabled();
+
+    /**
+     * Records a wait for 'resId', naming the resource if this thread has a ScopedResourceName for
+     * it in scope.
+     */
+    void recordWait(ResourceId resId, LockMode mode, uint64_t waitMicros);
+
+    /**
+     * Returns the name recorded for 'resId', or an empty string if it has none.
+     */
+    std::string getResourceName(ResourceId resId) const;
+
+    /**
+     * Appends the 'topN' resources with the most total wait time.
+     */
+    void report(size_t topN, BSONObjBuilder* builder) const;
+
+    void reset();
+
+private:
+    struct Entry {
+        std::string name;
+        std::array<uint64_t, LockModesCount> waitsByMode{};
+        uint64_t totalWaitMicros = 0;
+        LatencyHistogram histogram;
+    };
+
+    struct Shard {
+        stdx::mutex mutex;
+        stdx::unordered_map<ResourceId, std::unique_ptr<Entry>> entries;
+    };
+
+    static constexpr int kNumShards = 16;
+
+    Shard& _getShard(ResourceId resId) const;
+
+    mutable std::array<Shard, kNumShards> _shards;
+    AtomicInt64 _numTracked;
+    AtomicInt64 _untrackedWaits;
+};
+
+/**
+ * Number of resources to report in serverStatus, from the lockContentionTrackingTopN parameter.
+ */
+size_t getLockContentionTrackingTopN();
+
+}  // namespace mongo
@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/lock_contention_tracker.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(LatencyHistogram, BucketBoundsContainTheirValues) {
+    for (uint64_t value : {0ULL, 1ULL, 3ULL, 4ULL, 7ULL, 8ULL, 100ULL, 1000ULL, 123456ULL}) {
+        const int bucket = LatencyHistogram::bucketFor(value);
+        ASSERT_LESS_THAN(bucket, LatencyHistogram::kNumBuckets);
+        ASSERT_LESS_THAN_OR_EQUALS(value, LatencyHistogram::bucketUpperBound(bucket));
+        if (bucket > 0) {
+            ASSERT_GREATER_THAN(value, LatencyHistogram::bucketUpperBound(bucket - 1));
+        }
+    }
+
+    ASSERT_EQUALS(LatencyHistogram::kNumBuckets - 1, LatencyHistogram::bucketFor(~0ULL));
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram histogram;
+    ASSERT_EQUALS(0U, histogram.percentile(50));
+
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(10);
+    }
+    histogram.record(10000);
+
+    ASSERT_EQUALS(100U, histogram.count());
+    ASSERT_EQUALS(10000U, histogram.max());
+
+    // Reported values are bucket upper bounds, within 25% of the recorded value
+    ASSERT_GREATER_THAN_OR_EQUALS(histogram.percentile(50), 10U);
+    ASSERT_LESS_THAN_OR_EQUALS(histogram.percentile(50), 12U);
+    ASSERT_LESS_THAN_OR_EQUALS(histogram.percentile(99), 12U);
+    ASSERT_EQUALS(10000U, histogram.percentile(100));
+}
+
+TEST(LockContentionTracker, ReportsMostContendedResourcesFirst) {
+    const ResourceId hot(RESOURCE_COLLECTION, std::string("LockContentionTracker.hot"));
+    const ResourceId cold(RESOURCE_COLLECTION, std::string("LockContentionTracker.cold"));
+
+    LockContentionTracker tracker;
+    tracker.recordWait(cold, MODE_IS, 5);
+    tracker.recordWait(hot, MODE_X, 1000);
+    {
+        // Only a wait recorded while the resource is named picks the name up
+        LockContentionTracker::ScopedResourceName resourceName(hot, "LockContentionTracker.hot");
+        tracker.recordWait(hot, MODE_IX, 2000);
+    }
+
+    ASSERT_EQUALS("LockContentionTracker.hot", tracker.getResourceName(hot));
+    ASSERT_EQUALS("", tracker.getResourceName(cold));
+
+    BSONObjBuilder builder;
+    tracker.report(1, &builder);
+    const BSONObj report = builder.obj();
+
+    ASSERT_EQUALS(2, report["trackedResources"].numberLong());
+    const auto top = report["top"].Array();
+    ASSERT_EQUALS(1U, top.size());
+    ASSERT_EQUALS("LockContentionTracker.hot", top[0]["name"].String());
+    ASSERT_EQUALS(3000, top[0]["totalWaitMicros"].numberLong());
+    ASSERT_EQUALS(1, top[0]["waits"]["X"].numberLong());
+    ASSERT_EQUALS(1, top[0]["waits"]["IX"].numberLong());
+    ASSERT_EQUALS(2, top[0]["waitMicros"]["count"].numberLong());
+
+    // A name in scope for another resource is not applied
+    const ResourceId other(RESOURCE_COLLECTION, std::string("LockContentionTracker.other"));
+    {
+        LockContentionTracker::ScopedResourceName resourceName(other,
+                                                               "LockContentionTracker.other");
+        tracker.recordWait(cold, MODE_IS, 5);
+    }
+    ASSERT_EQUALS("", tracker.getResourceName(cold));
+
+    // An inner name going out of scope restores the outer one
+    {
+        LockContentionTracker::ScopedResourceName outer(cold, "LockContentionTracker.cold");
+        {
+            LockContentionTracker::ScopedResourceName inner(other, "LockContentionTracker.other");
+        }
+        tracker.recordWait(cold, MODE_IS, 5);
+    }
+    ASSERT_EQUALS("LockContentionTracker.cold", tracker.getResourceName(cold));
+
+    tracker.reset();
+    BSONObjBuilder afterReset;
+    tracker.report(1, &afterReset);
+    ASSERT_EQUALS(0, afterReset.obj()["trackedResources"].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
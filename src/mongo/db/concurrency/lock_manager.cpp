@@ -34,6 +34,10 @@
 
 #include <third_party/murmurhash3/MurmurHash3.h>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/data_type_endian.h"
 #include "mongo/base/data_view.h"
 #include "mongo/base/static_assert.h"
@@ -41,6 +45,7 @@
 #include "mongo/config.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stringutils.h"
@@ -410,11 +415,20 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+// Balance scalability of intent locks against potential added cost of conflicting locks. There
+// should be at least one partition per CPU, since requests pick their partition by CPU; beyond
+// that the exact value doesn't appear very important, but should be power of two.
+unsigned computeNumPartitions() {
+    unsigned numPartitions = 32;
+    while (numPartitions < stdx::thread::hardware_concurrency()) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
+}  // namespace
 
-LockManager::LockManager() {
+LockManager::LockManager() : _numPartitions(computeNumPartitions()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -441,6 +455,7 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     // For intent modes, try the PartitionedLockHead
     if (request->partitioned) {
+        _assignPartition(request);
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
 
@@ -810,7 +825,21 @@ LockManager::LockBucket* LockManager::_getBucket(ResourceId resId) const {
 }
 
 LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
-    return &_partitions[request->locker->getId() % _numPartitions];
+    return &_partitions[request->partitionId];
+}
+
+void LockManager::_assignPartition(LockRequest* request) const {
+    // Only one thread runs on a CPU at a time, so choosing the partition by CPU means that a
+    // partition mutex is contended only when a thread is preempted or migrated while holding it.
+    // Fall back to spreading requests by locker where the current CPU is not known.
+    unsigned hint = static_cast<unsigned>(request->locker->getId());
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        hint = static_cast<unsigned>(cpu);
+    }
+#endif
+    request->partitionId = hint & (_numPartitions - 1);
 }
 
 void LockManager::dump() const {
@@ -1170,6 +1199,7 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
 
     lock = nullptr;
     partitionedLock = nullptr;
+    partitionId = 0;
     prev = nullptr;
     next = nullptr;
     status = STATUS_NEW;
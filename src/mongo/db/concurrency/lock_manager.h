@@ -147,9 +147,9 @@ private:
         LockHead* findOrInsert(ResourceId resId);
     };
 
-    // Each locker maps to a partition that is used for resources acquired in intent modes
-    // modes and potentially other modes that don't conflict with themselves. This avoids
-    // contention on the regular LockHead in the lock manager.
+    // Each request for a resource in intent modes (and potentially other modes that don't
+    // conflict with themselves) maps to a partition, chosen by the CPU the request is made on.
+    // This avoids contention on the regular LockHead in the lock manager.
     struct Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
@@ -166,10 +166,16 @@ private:
 
 
     /**
-     * Retrieves the Partition that a particular LockRequest should use for intent locking.
+     * Retrieves the Partition that a particular LockRequest uses for intent locking, as chosen by
+     * _assignPartition.
      */
     Partition* _getPartition(LockRequest* request) const;
 
+    /**
+     * Picks the partition for a new partitioned request, based on the current CPU.
+     */
+    void _assignPartition(LockRequest* request) const;
+
     /**
      * Prints the contents of a bucket to the log.
      */
@@ -214,7 +220,7 @@ private:
     static const unsigned _numLockBuckets;
     LockBucket* _lockBuckets;
 
-    static const unsigned _numPartitions;
+    const unsigned _numPartitions;
     Partition* _partitions;
 };
 
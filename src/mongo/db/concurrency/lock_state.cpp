@@ -34,6 +34,7 @@
 
 #include <vector>
 
+#include "mongo/db/concurrency/lock_contention_tracker.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/compiler.h"
@@ -239,6 +240,19 @@ void CondVarLockGrantNotification::notify(ResourceId resId, LockResult result) {
 
 namespace {
 TicketHolder* ticketHolders[LockModesCount] = {};
+
+TicketHolder::Priority toTicketPriority(Locker::AdmissionPriority priority) {
+    switch (priority) {
+        case Locker::AdmissionPriority::kLow:
+            return TicketHolder::Priority::kLow;
+        case Locker::AdmissionPriority::kNormal:
+            return TicketHolder::Priority::kNormal;
+        case Locker::AdmissionPriority::kHigh:
+        case Locker::AdmissionPriority::kImmediate:
+            return TicketHolder::Priority::kHigh;
+    }
+    MONGO_UNREACHABLE;
+}
 }  // namespace
 
 
@@ -307,18 +321,22 @@ LockResult LockerImpl<IsForMMAPV1>::_lockGlobalBegin(LockMode mode, Milliseconds
     dassert(isLocked() == (_modeForTicket != MODE_NONE));
     if (_modeForTicket == MODE_NONE) {
         const bool reader = isSharedLockMode(mode);
-        auto holder = ticketHolders[mode];
+        const auto admissionPriority = getAdmissionPriority();
+        auto holder = admissionPriority == AdmissionPriority::kImmediate ? nullptr
+                                                                         : ticketHolders[mode];
         if (holder) {
+            const auto priority = toTicketPriority(admissionPriority);
             _clientState.store(reader ? kQueuedReader : kQueuedWriter);
             if (timeout == Milliseconds::max()) {
-                holder->waitForTicket();
-            } else if (!holder->waitForTicketUntil(Date_t::now() + timeout)) {
+                holder->waitForTicket(priority);
+            } else if (!holder->waitForTicketUntil(Date_t::now() + timeout, priority)) {
                 _clientState.store(kInactive);
                 return LOCK_TIMEOUT;
             }
         }
         _clientState.store(reader ? kActiveReader : kActiveWriter);
         _modeForTicket = mode;
+        _ticketHolder = holder;
     }
     const LockResult result = lockBegin(resourceIdGlobal, mode);
     if (result == LOCK_OK)
@@ -785,6 +803,11 @@ LockResult LockerImpl<IsForMMAPV1>::lockComplete(ResourceId resId,
         }
     }
 
+    if (LockContentionTracker::isEnabled()) {
+        LockContentionTracker::get().recordWait(
+            resId, mode, curTimeMicros64() - startOfTotalWaitTime);
+    }
+
     // Cleanup the state, since this is an unused lock now.
     // Note: in case of the _notify object returning LOCK_TIMEOUT, it is possible to find that the
     // lock was still granted after all, but we don't try to take advantage of that and will return
@@ -808,8 +831,9 @@ bool LockerImpl<IsForMMAPV1>::_unlockImpl(LockRequestsMap::Iterator* it) {
     if (globalLockManager.unlock(it->objAddr())) {
         if (it->key() == resourceIdGlobal) {
             invariant(_modeForTicket != MODE_NONE);
-            auto holder = ticketHolders[_modeForTicket];
+            auto holder = _ticketHolder;
             _modeForTicket = MODE_NONE;
+            _ticketHolder = nullptr;
             if (holder) {
                 holder->release();
             }
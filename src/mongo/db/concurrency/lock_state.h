@@ -37,6 +37,8 @@
 
 namespace mongo {
 
+class TicketHolder;
+
 /**
  * Notfication callback, which stores the last notification result and signals a condition
  * variable, which can be waited on.
@@ -228,6 +230,10 @@ private:
     // Mode for which the Locker acquired a ticket, or MODE_NONE if no ticket was acquired.
     LockMode _modeForTicket = MODE_NONE;
 
+    // Holder the current ticket was taken from, or nullptr if the global lock was acquired
+    // without one (unthrottled mode or AdmissionPriority::kImmediate).
+    TicketHolder* _ticketHolder = nullptr;
+
     // Indicates whether the client is active reader/writer or is queued.
     AtomicWord<ClientState> _clientState{kInactive};
 
@@ -70,6 +70,15 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Priority with which global lock attempts obtain their ticket. Background work (TTL
+     * deletes, range deletion, chunk migration) runs at kLow so that it cannot starve user
+     * operations, and replication's oplog application runs at kHigh so that secondaries keep up
+     * under load. kImmediate skips the tickets altogether and is meant for short commands that
+     * must stay responsive when the server is saturated, such as heartbeats and isMaster.
+     */
+    enum class AdmissionPriority { kLow, kNormal, kHigh, kImmediate };
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
@@ -328,11 +337,23 @@ public:
         return _shouldConflictWithSecondaryBatchApplication;
     }
 
+    /**
+     * Sets the priority used for tickets taken by subsequent global lock acquisitions. Does not
+     * affect a ticket that is already held.
+     */
+    void setAdmissionPriority(AdmissionPriority priority) {
+        _admissionPriority = priority;
+    }
+    AdmissionPriority getAdmissionPriority() const {
+        return _admissionPriority;
+    }
+
 protected:
     Locker() {}
 
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
+    AdmissionPriority _admissionPriority = AdmissionPriority::kNormal;
 };
 
 }  // namespace mongo
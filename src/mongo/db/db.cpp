@@ -105,6 +105,7 @@
 #include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/db/repl/topology_coordinator.h"
 #include "mongo/db/s/balancer/balancer.h"
+#include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_initialization_mongod.h"
 #include "mongo/db/s/sharding_state.h"
@@ -1007,6 +1008,11 @@ ExitCode _initAndListen(int listenPort) {
     runner->startup().transitional_ignore();
     serviceContext->setPeriodicRunner(std::move(runner));
 
+    // Periodically decay the per-chunk write counts which the balancer reads from this shard
+    if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
+        CollectionShardingState::startHotChunksDecay(serviceContext);
+    }
+
     SessionKiller::set(serviceContext,
                        std::make_shared<SessionKiller>(serviceContext, killSessionsLocal));
 
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/base/static_assert.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/client/constants.h"
@@ -39,6 +41,7 @@
 
 namespace mongo {
 
+class DeferredResponse;
 class OperationContext;
 
 /* db response format
@@ -446,6 +449,9 @@ Message makeGetMoreMessage(StringData ns, long long cursorId, int nToReturn, int
 struct DbResponse {
     Message response;       // If empty, nothing will be returned to the client.
     std::string exhaustNS;  // Namespace of cursor if exhaust mode, else "".
+
+    // If set, 'response' is empty and the reply comes from 'deferred' once it is ready.
+    std::shared_ptr<DeferredResponse> deferred;
 };
 
 /**
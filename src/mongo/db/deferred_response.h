@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/client.h"
+#include "mongo/db/dbmessage.h"
+#include "mongo/stdx/functional.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * The part of a request that cannot complete until some event happens elsewhere in the server,
+ * such as a write being replicated to a majority of the replica set.
+ *
+ * Rather than block its thread until then, a ServiceEntryPoint may return a DbResponse carrying
+ * a DeferredResponse in place of a reply. The ServiceStateMachine then parks the session without
+ * holding a thread, and once the DeferredResponse is ready produces the reply from whichever
+ * thread the ServiceExecutor picks to resume it.
+ */
+class DeferredResponse {
+public:
+    virtual ~DeferredResponse() = default;
+
+    /**
+     * Whether requests from 'client' may be answered with a DeferredResponse. Only sessions run
+     * by an asynchronous ServiceExecutor allow it, since otherwise there is no thread to free.
+     */
+    static bool isAllowed(Client* client);
+    static void setAllowed(Client* client, bool allowed);
+
+    /**
+     * Arranges for 'onReady' to be called exactly once when finish() can produce the reply
+     * without blocking. It may be called from any thread, including this one before whenReady()
+     * returns, and must not block.
+     */
+    virtual void whenReady(stdx::function<void()> onReady) = 0;
+
+    /**
+     * Produces the reply, with a new OperationContext for the Client that sent the request. Must
+     * only be called after 'onReady' has run.
+     */
+    virtual DbResponse finish(OperationContext* opCtx) = 0;
+};
+
+}  // namespace mongo
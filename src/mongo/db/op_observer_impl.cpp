@@ -382,11 +382,17 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
 
     if (args.nss != NamespaceString::kSessionTransactionsTableNamespace) {
         if (!args.fromMigrate) {
+            // In-place updates don't change the size of the document and only carry the pre-image
+            // when it is requested for the oplog
+            const int preImageDocSize =
+                args.preImageDoc ? args.preImageDoc->objsize() : args.updatedDoc.objsize();
+
             auto css = CollectionShardingState::get(opCtx, args.nss);
             css->onUpdateOp(opCtx,
                             args.criteria,
                             args.update,
                             args.updatedDoc,
+                            preImageDocSize,
                             opTime.writeOpTime,
                             opTime.prePostImageOpTime);
         }
@@ -36,6 +36,7 @@
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
@@ -43,13 +44,17 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -155,6 +160,89 @@ void endQueryOp(OperationContext* opCtx,
     }
 }
 
+bool isExpressIdQuery(OperationContext* opCtx,
+                      Collection* collection,
+                      const NamespaceString& nss,
+                      const QueryRequest& qr) {
+    if (!internalQueryExecEnableExpressIdLookup.load() || !collection) {
+        return false;
+    }
+
+    // The filter must be nothing but the _id equality; $isolated is rejected by the find command
+    // and must still reach canonicalization to produce the usual error.
+    const BSONObj& filter = qr.getFilter();
+    if (filter.nFields() != 1 || !CanonicalQuery::isSimpleIdQuery(filter)) {
+        return false;
+    }
+
+    if (!qr.getProj().isEmpty() || !qr.getSort().isEmpty() || !qr.getHint().isEmpty() ||
+        !qr.getCollation().isEmpty() || !qr.getMin().isEmpty() || !qr.getMax().isEmpty() ||
+        qr.getSkip() || qr.getMaxScan() || qr.returnKey() || qr.showRecordId() ||
+        qr.isSnapshot() || qr.isTailable() || qr.isOplogReplay() || qr.isExhaust() ||
+        qr.isExplain()) {
+        return false;
+    }
+
+    // A batch size or limit of zero asks for an empty first batch and a cursor.
+    if ((qr.getBatchSize() && *qr.getBatchSize() == 0) || (qr.getLimit() && *qr.getLimit() == 0)) {
+        return false;
+    }
+
+    // Comparing _id values in the index only agrees with the query's semantics under the simple
+    // collation.
+    if (collection->getDefaultCollator()) {
+        return false;
+    }
+
+    // Sharded collections need the shard filter to hide orphaned documents.
+    if (CollectionShardingState::get(opCtx, nss)->getMetadata()) {
+        return false;
+    }
+
+    return collection->getIndexCatalog()->findIdIndex(opCtx) != nullptr;
+}
+
+void runExpressIdQuery(OperationContext* opCtx,
+                       Collection* collection,
+                       const NamespaceString& nss,
+                       const QueryRequest& qr,
+                       BSONObjBuilder* result) {
+    const IndexDescriptor* idIndex = collection->getIndexCatalog()->findIdIndex(opCtx);
+    invariant(idIndex);
+
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        CurOp::get(opCtx)->setPlanSummary_inlock(std::string("IDHACK"));
+    }
+
+    PlanSummaryStats summaryStats;
+    summaryStats.totalKeysExamined = 1;
+    summaryStats.indexesUsed.insert(idIndex->indexName());
+
+    CursorResponseBuilder firstBatch(/*isInitialResponse*/ true, result);
+    const RecordId recordId =
+        collection->getIndexCatalog()->getIndex(idIndex)->findSingle(opCtx, qr.getFilter());
+    Snapshotted<BSONObj> doc;
+    if (!recordId.isNull() && collection->findDoc(opCtx, recordId, &doc)) {
+        summaryStats.totalDocsExamined = 1;
+        summaryStats.nReturned = 1;
+        firstBatch.append(doc.value());
+    }
+
+    // Ensure the read happened with the expected collection version, as the planned path does
+    // before returning its first batch.
+    CollectionShardingState::get(opCtx, nss)->checkShardVersionOrThrow(opCtx);
+
+    auto curOp = CurOp::get(opCtx);
+    curOp->debug().nreturned = summaryStats.nReturned;
+    curOp->debug().cursorid = -1;
+    curOp->debug().cursorExhausted = true;
+    curOp->debug().setPlanSummaryMetrics(summaryStats);
+    collection->infoCache()->notifyOfQuery(opCtx, summaryStats.indexesUsed);
+
+    firstBatch.done(0, nss.ns());
+}
+
 namespace {
 
 /**
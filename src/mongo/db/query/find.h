@@ -85,6 +85,28 @@ void endQueryOp(OperationContext* opCtx,
                 long long numResults,
                 CursorId cursorId);
 
+/**
+ * Returns true if 'qr' is a point read by _id on 'collection' that runExpressIdQuery() can answer:
+ * an equality to a scalar _id with no projection, sort, skip, hint, collation or other option
+ * that needs the query system, on an unsharded collection with an _id index and the simple
+ * default collation.
+ */
+bool isExpressIdQuery(OperationContext* opCtx,
+                      Collection* collection,
+                      const NamespaceString& nss,
+                      const QueryRequest& qr);
+
+/**
+ * Answers a query accepted by isExpressIdQuery() with a single lookup in the _id index followed
+ * by a single record store read, skipping canonicalization, planning and plan stage allocation.
+ * Appends the single batch cursor response to 'result' and fills out CurOp as endQueryOp() would.
+ */
+void runExpressIdQuery(OperationContext* opCtx,
+                       Collection* collection,
+                       const NamespaceString& nss,
+                       const QueryRequest& qr,
+                       BSONObjBuilder* result);
+
 /**
  * Constructs a PlanExecutor for a query with the oplogReplay option set to true,
  * for the query 'cq' over the collection 'collection'. The PlanExecutor will
@@ -534,6 +534,7 @@ SolutionCacheData* SolutionCacheData::clone() const {
     }
     other->solnType = this->solnType;
     other->wholeIXSolnDir = this->wholeIXSolnDir;
+    other->wholeIXSolnCovered = this->wholeIXSolnCovered;
     other->indexFilterApplied = this->indexFilterApplied;
     return other;
 }
@@ -544,6 +545,7 @@ std::string SolutionCacheData::toString() const {
             verify(this->tree.get());
             return str::stream() << "(whole index scan solution: "
                                  << "dir=" << this->wholeIXSolnDir << "; "
+                                 << "covered=" << this->wholeIXSolnCovered << "; "
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
@@ -151,6 +151,7 @@ struct SolutionCacheData {
         : tree(nullptr),
           solnType(USE_INDEX_TAGS_SOLN),
           wholeIXSolnDir(1),
+          wholeIXSolnCovered(false),
           indexFilterApplied(false) {}
 
     // Make a deep copy.
@@ -184,6 +185,10 @@ struct SolutionCacheData {
     // for WHOLE_IXSCAN_SOLN.
     int wholeIXSolnDir;
 
+    // True if the whole index scan was planned to answer a covered projection, and so applies the
+    // query predicates to the index keys rather than fetching. Used only for WHOLE_IXSCAN_SOLN.
+    bool wholeIXSolnCovered;
+
     // True if index filter was applied.
     bool indexFilterApplied;
 };
@@ -1044,6 +1044,22 @@ TEST_F(CachePlanSelectionTest, ReverseScanForSort) {
         "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {_id: 1}}}}}");
 }
 
+TEST_F(CachePlanSelectionTest, CoveredWholeIndexScanWithFilter) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1), "a_1_b_1_c_1");
+    BSONObj query = fromjson("{b: {$gt: 5}, c: 3}");
+    BSONObj proj = fromjson("{_id: 0, a: 1}");
+    runQuerySortProj(query, BSONObj(), proj);
+
+    // The predicates must still be applied to the index keys, without a fetch.
+    assertPlanCacheRecoversSolution(query,
+                                    BSONObj(),
+                                    proj,
+                                    BSONObj(),
+                                    "{proj: {spec: {_id: 0, a: 1}, node: {ixscan: {filter: "
+                                    "{b: {$gt: 5}, c: 3}, pattern: {a: 1, b: 1, c: 1}}}}}");
+}
+
 //
 // Caching collection scans.
 //
@@ -1263,6 +1263,27 @@ QuerySolutionNode* QueryPlannerAccess::buildIndexedDataAccess(const CanonicalQue
     return NULL;
 }
 
+// static
+bool QueryPlannerAccess::filterIsCoveredByIndex(const MatchExpression* filter,
+                                                const IndexEntry& index) {
+    if (INDEX_BTREE != index.type || index.multikey) {
+        return false;
+    }
+
+    if (MatchExpression::AND == filter->matchType()) {
+        for (size_t i = 0; i < filter->numChildren(); ++i) {
+            if (!filterIsCoveredByIndex(filter->getChild(i), index)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return filter->getCategory() == MatchExpression::MatchCategory::kLeaf &&
+        index.keyPattern.hasField(filter->path()) &&
+        IndexBoundsBuilder::canUseCoveredMatching(filter, index);
+}
+
 QuerySolutionNode* QueryPlannerAccess::scanWholeIndex(const IndexEntry& index,
                                                       const CanonicalQuery& query,
                                                       const QueryPlannerParams& params,
@@ -1287,9 +1308,13 @@ QuerySolutionNode* QueryPlannerAccess::scanWholeIndex(const IndexEntry& index,
     // If it's find({}) remove the no-op root.
     if (MatchExpression::AND == filter->matchType() && (0 == filter->numChildren())) {
         solnRoot = isn.release();
+    } else if ((params.options & QueryPlannerParams::NO_UNCOVERED_PROJECTIONS) &&
+               filterIsCoveredByIndex(filter.get(), index)) {
+        // The caller wants a plan that reads only the index, and the predicates can be answered
+        // from the index keys.
+        isn->filter = std::move(filter);
+        solnRoot = isn.release();
     } else {
-        // TODO: We may not need to do the fetch if the predicates in root are covered.  But
-        // for now it's safe (though *maybe* slower).
         unique_ptr<FetchNode> fetch = make_unique<FetchNode>();
         fetch->filter = std::move(filter);
         fetch->children.push_back(isn.release());
@@ -189,8 +189,18 @@ public:
                                                                  bool tailable,
                                                                  const QueryPlannerParams& params);
 
+    /**
+     * Returns true if 'filter' can be applied to the keys of 'index' alone, without fetching the
+     * documents. That is the case when 'filter' is a conjunction of predicates over fields of the
+     * key pattern that all support covered matching, and 'index' is a non-multikey btree index.
+     */
+    static bool filterIsCoveredByIndex(const MatchExpression* filter, const IndexEntry& index);
+
     /**
      * Return a plan that uses the provided index as a proxy for a collection scan.
+     *
+     * When 'params' forbids uncovered projections and the query predicates are covered by the
+     * index, they are applied to the index keys and no FETCH is added for them.
      */
     static QuerySolutionNode* scanWholeIndex(const IndexEntry& index,
                                              const CanonicalQuery& query,
@@ -110,6 +110,10 @@ extern AtomicInt32 internalQueryExecYieldIterations;
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// Answer point reads by _id in the find command by probing the _id index directly, without
+// canonicalizing or planning the query.
+extern AtomicBool internalQueryExecEnableExpressIdLookup;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
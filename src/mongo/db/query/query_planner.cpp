@@ -447,9 +447,17 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
     const SolutionCacheData& winnerCacheData = *cachedSoln.plannerData[0];
 
     if (SolutionCacheData::WHOLE_IXSCAN_SOLN == winnerCacheData.solnType) {
-        // The solution can be constructed by a scan over the entire index.
-        auto soln = buildWholeIXSoln(
-            *winnerCacheData.tree->entry, query, params, winnerCacheData.wholeIXSolnDir);
+        // The solution can be constructed by a scan over the entire index. A scan that answered a
+        // covered projection must be rebuilt with the same parameters it was planned with, or the
+        // predicates would be applied after a fetch instead of to the index keys.
+        QueryPlannerParams paramsForCoveredIxScan;
+        paramsForCoveredIxScan.options =
+            params.options | QueryPlannerParams::NO_UNCOVERED_PROJECTIONS;
+        auto soln = buildWholeIXSoln(*winnerCacheData.tree->entry,
+                                     query,
+                                     winnerCacheData.wholeIXSolnCovered ? paramsForCoveredIxScan
+                                                                        : params,
+                                     winnerCacheData.wholeIXSolnDir);
         if (!soln) {
             return Status(ErrorCodes::BadValue,
                           "plan cache error: soln that uses index to provide sort");
@@ -1026,15 +1034,18 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     }
 
     // If a projection exists, there may be an index that allows for a covered plan, even if none
-    // were considered earlier.
+    // were considered earlier. Scanning such an index reads just the projected fields, which is
+    // much cheaper than a collection scan over wide documents. The query predicates must be
+    // answerable from the index keys as well.
     const auto projection = query.getProj();
     if (params.options & QueryPlannerParams::GENERATE_COVERED_IXSCANS && out.size() == 0 &&
-        query.getQueryObj().isEmpty() && projection && !projection->requiresDocument()) {
+        projection && !projection->requiresDocument()) {
 
         const auto* indicesToConsider = hintIndex.isEmpty() ? &params.indices : &relevantIndices;
         for (auto&& index : *indicesToConsider) {
             if (index.type != INDEX_BTREE || index.multikey || index.sparse || index.filterExpr ||
-                !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+                !CollatorInterface::collatorsMatch(index.collator, query.getCollator()) ||
+                !QueryPlannerAccess::filterIsCoveredByIndex(query.root(), index)) {
                 continue;
             }
 
@@ -1051,6 +1062,7 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
                 scd->tree.reset(indexTree);
                 scd->solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
                 scd->wholeIXSolnDir = 1;
+                scd->wholeIXSolnCovered = true;
                 soln->cacheData.reset(scd);
 
                 out.push_back(std::move(soln));
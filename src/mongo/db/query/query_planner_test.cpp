@@ -5538,6 +5538,39 @@ TEST_F(QueryPlannerTest, EmptyQueryWithProjectionUsesCollscanIfIndexIsText) {
         "{cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest, QueryWithProjectionUsesCoveredIxscanIfPredicatesAreCovered) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {b: {$gt: 5}, c: 3}, projection: {_id: 0, a: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: "
+        "{ixscan: {filter: {b: {$gt: 5}, c: 3}, pattern: {a: 1, b: 1, c: 1}, bounds:"
+        "{a: [['MinKey', 'MaxKey', true, true]], b: [['MinKey', 'MaxKey', true, true]],"
+        "c: [['MinKey', 'MaxKey', true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, QueryWithProjectionUsesCollscanIfPredicateIsNotIndexed) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQueryAsCommand(fromjson("{find: 'testns', filter: {d: 1}, projection: {_id: 0, a: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: "
+        "{cscan: {dir: 1, filter: {d: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, QueryWithProjectionUsesCollscanIfPredicateNeedsFetch) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQueryAsCommand(fromjson("{find: 'testns', filter: {b: null}, projection: {_id: 0, a: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: "
+        "{cscan: {dir: 1, filter: {b: null}}}}}");
+}
+
 TEST_F(QueryPlannerTest, EmptyQueryWithProjectionUsesCollscanIfIndexIsGeo) {
     params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     addIndex(BSON("a"
@@ -722,6 +722,9 @@ public:
             sleepsecs(data["delay"].numberInt());
         }
 
+        // A heartbeat stuck behind user operations looks like a dead member.
+        opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kImmediate);
+
         LOG_FOR_HEARTBEATS(2) << "Received heartbeat request from " << cmdObj.getStringField("from")
                               << ", " << cmdObj;
 
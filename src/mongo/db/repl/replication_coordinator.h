@@ -37,6 +37,7 @@
 #include "mongo/db/repl/member_state.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/sync_source_selector.h"
+#include "mongo/stdx/functional.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/time_support.h"
 
@@ -198,6 +199,23 @@ public:
                                                const OpTime& opTime,
                                                const WriteConcernOptions& writeConcern) = 0;
 
+    /**
+     * Non-blocking counterpart to awaitReplication(). Arranges for 'onReady' to be called exactly
+     * once, as soon as a call to awaitReplication() with the same arguments would no longer
+     * block: when "opTime" satisfies "writeConcern", when 'deadline' passes, or when the wait
+     * can no longer succeed because of a stepdown or shutdown. The caller is expected to then
+     * call awaitReplication() to learn the outcome.
+     *
+     * 'onReady' may be called before this returns, and may be called from any thread while
+     * internal locks are held, so it must not block or call back into the coordinator.
+     * Implementations may also call it right away whenever they cannot wait asynchronously, in
+     * which case awaitReplication() simply blocks as before.
+     */
+    virtual void registerReplicationWaiter(const OpTime& opTime,
+                                           const WriteConcernOptions& writeConcern,
+                                           Date_t deadline,
+                                           stdx::function<void()> onReady) = 0;
+
     /**
      * Causes this node to relinquish being primary for at least 'stepdownTime'.  If 'force' is
      * false, before doing so it will wait for 'waitTime' for one other node to be within 10
@@ -224,6 +224,22 @@ void ReplicationCoordinatorImpl::CallbackWaiter::notify_inlock() {
 }
 
 
+ReplicationCoordinatorImpl::AsyncWaiter::AsyncWaiter(OpTime _opTime,
+                                                     const WriteConcernOptions& _writeConcern,
+                                                     stdx::function<void()> _onReady)
+    : Waiter(_opTime, &ownedWriteConcern),
+      ownedWriteConcern(_writeConcern),
+      onReady(std::move(_onReady)) {}
+
+void ReplicationCoordinatorImpl::AsyncWaiter::notify_inlock() {
+    invariant(onReady);
+    auto keepAlive = std::move(self);
+    if (timeoutCbh) {
+        executor->cancel(timeoutCbh);
+    }
+    onReady();
+}
+
 class ReplicationCoordinatorImpl::WaiterGuard {
 public:
     /**
@@ -1559,6 +1575,56 @@ Status ReplicationCoordinatorImpl::_awaitReplication_inlock(
     return _checkIfWriteConcernCanBeSatisfied_inlock(writeConcern);
 }
 
+void ReplicationCoordinatorImpl::registerReplicationWaiter(const OpTime& opTime,
+                                                           const WriteConcernOptions& writeConcern,
+                                                           Date_t deadline,
+                                                           stdx::function<void()> onReady) {
+    // Master/slave waits are rare enough that they are left to block in awaitReplication().
+    if (getReplicationMode() != modeReplSet || opTime.isNull()) {
+        onReady();
+        return;
+    }
+
+    auto waiter = std::make_shared<AsyncWaiter>(
+        opTime, populateUnsetWriteConcernOptionsSyncMode(writeConcern), std::move(onReady));
+
+    stdx::unique_lock<stdx::mutex> lock(_mutex);
+
+    // In each of these cases _awaitReplication_inlock() returns without waiting.
+    if (_inShutdown || !_memberState.primary() || opTime.getTerm() != _topCoord->getTerm() ||
+        _topCoord->isSteppingDown() || deadline <= _replExecutor->now() ||
+        _doneWaitingForReplication_inlock(opTime, waiter->ownedWriteConcern)) {
+        lock.unlock();
+        waiter->onReady();
+        return;
+    }
+
+    if (deadline != Date_t::max()) {
+        std::weak_ptr<AsyncWaiter> weakWaiter = waiter;
+        waiter->executor = _replExecutor.get();
+        waiter->timeoutCbh = _scheduleWorkAt(deadline, [this, weakWaiter](const CallbackArgs&) {
+            auto waiter = weakWaiter.lock();
+            if (!waiter) {
+                return;
+            }
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (_replicationWaiterList.remove_inlock(waiter.get())) {
+                waiter->notify_inlock();
+            }
+        });
+
+        if (!waiter->timeoutCbh) {
+            // The executor is shutting down.
+            lock.unlock();
+            waiter->onReady();
+            return;
+        }
+    }
+
+    waiter->self = waiter;
+    _replicationWaiterList.add_inlock(waiter.get());
+}
+
 void ReplicationCoordinatorImpl::waitForStepDownAttempt_forTest() {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     while (!_topCoord->isSteppingDown()) {
@@ -123,6 +123,11 @@ public:
     virtual ReplicationCoordinator::StatusAndDuration awaitReplication(
         OperationContext* opCtx, const OpTime& opTime, const WriteConcernOptions& writeConcern);
 
+    virtual void registerReplicationWaiter(const OpTime& opTime,
+                                           const WriteConcernOptions& writeConcern,
+                                           Date_t deadline,
+                                           stdx::function<void()> onReady) override;
+
     virtual Status stepDown(OperationContext* opCtx,
                             bool force,
                             const Milliseconds& waitTime,
@@ -503,6 +508,22 @@ private:
         FinishFunc finishCallback = nullptr;
     };
 
+    // Used by registerReplicationWaiter(). Nobody blocks on behalf of an AsyncWaiter, so it owns
+    // a copy of its write concern and keeps itself alive until it has been notified. Notifying it
+    // cancels its timeout callback, if any, and then calls onReady.
+    struct AsyncWaiter : public Waiter {
+        AsyncWaiter(OpTime _opTime,
+                    const WriteConcernOptions& _writeConcern,
+                    stdx::function<void()> _onReady);
+        void notify_inlock() override;
+
+        WriteConcernOptions ownedWriteConcern;
+        stdx::function<void()> onReady;
+        executor::TaskExecutor* executor = nullptr;
+        executor::TaskExecutor::CallbackHandle timeoutCbh;
+        std::shared_ptr<AsyncWaiter> self;
+    };
+
     class WaiterGuard;
 
     class WaiterList {
@@ -1186,6 +1186,67 @@ TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBefo
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeCallsReplicationWaiterOnceAWriteConcernIsSatisfiedOrTimesOut) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id"
+                                               << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id"
+                                                  << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id"
+                                                  << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    getReplCoord()->setMyLastAppliedOpTime(OpTimeWithTermOne(100, 0));
+    getReplCoord()->setMyLastDurableOpTime(OpTimeWithTermOne(100, 0));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+    getReplCoord()->setMyLastAppliedOpTime(time2);
+    getReplCoord()->setMyLastDurableOpTime(time2);
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcern.wNumNodes = 2;
+
+    // The waiter is called once another node has time1.
+    bool ready = false;
+    getReplCoord()->registerReplicationWaiter(
+        time1, writeConcern, Date_t::max(), [&ready] { ready = true; });
+    ASSERT_FALSE(ready);
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time1));
+    ASSERT_TRUE(ready);
+
+    // The write concern is already satisfied, so the waiter is called right away.
+    ready = false;
+    getReplCoord()->registerReplicationWaiter(
+        time1, writeConcern, Date_t::max(), [&ready] { ready = true; });
+    ASSERT_TRUE(ready);
+
+    // No other node has time2, so the waiter is called at the deadline.
+    ready = false;
+    const Date_t deadline = getNet()->now() + Milliseconds(50);
+    getReplCoord()->registerReplicationWaiter(
+        time2, writeConcern, deadline, [&ready] { ready = true; });
+    ASSERT_FALSE(ready);
+    {
+        NetworkInterfaceMock::InNetworkGuard inNet(getNet());
+        getNet()->runUntil(deadline);
+        ASSERT_EQUALS(deadline, getNet()->now());
+    }
+    ASSERT_TRUE(ready);
+}
+
 TEST_F(ReplCoordTest,
        NodeReturnsShutDownInProgressWhenANodeShutsDownPriorToSatisfyingAWriteConcern) {
     assertStartSuccess(BSON("_id"
@@ -116,6 +116,13 @@ ReplicationCoordinator::StatusAndDuration ReplicationCoordinatorMock::awaitRepli
     return _awaitReplicationReturnValueFunction(opTime);
 }
 
+void ReplicationCoordinatorMock::registerReplicationWaiter(const OpTime& opTime,
+                                                           const WriteConcernOptions& writeConcern,
+                                                           Date_t deadline,
+                                                           stdx::function<void()> onReady) {
+    onReady();
+}
+
 void ReplicationCoordinatorMock::setAwaitReplicationReturnValueFunction(
     AwaitReplicationReturnValueFunction returnValueFunction) {
     _awaitReplicationReturnValueFunction = std::move(returnValueFunction);
@@ -85,6 +85,11 @@ public:
     virtual ReplicationCoordinator::StatusAndDuration awaitReplication(
         OperationContext* opCtx, const OpTime& opTime, const WriteConcernOptions& writeConcern);
 
+    virtual void registerReplicationWaiter(const OpTime& opTime,
+                                           const WriteConcernOptions& writeConcern,
+                                           Date_t deadline,
+                                           stdx::function<void()> onReady);
+
     virtual Status stepDown(OperationContext* opCtx,
                             bool force,
                             const Milliseconds& waitTime,
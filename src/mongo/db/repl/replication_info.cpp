@@ -242,6 +242,10 @@ public:
             LastError::get(opCtx->getClient()).disable();
         }
 
+        // Drivers and other members rely on isMaster for server selection and failure detection,
+        // so it must not queue behind user operations for a storage engine ticket.
+        opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kImmediate);
+
         transport::Session::TagMask sessionTagsToSet = 0;
         transport::Session::TagMask sessionTagsToUnset = 0;
 
@@ -497,6 +497,7 @@ void scheduleWritesToOplog(OperationContext* opCtx,
             const auto opCtxHolder = cc().makeOperationContext();
             const auto opCtx = opCtxHolder.get();
             opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+            opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kHigh);
             UnreplicatedWritesBlock uwb(opCtx);
 
             std::vector<InsertStatement> docs;
@@ -556,6 +557,7 @@ void scheduleTxnTableUpdates(OperationContext* opCtx,
             const auto opCtxHolder = cc().makeOperationContext();
             const auto opCtx = opCtxHolder.get();
             opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+            opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kHigh);
 
             Session::updateSessionRecordOnSecondary(opCtx, record);
         });
@@ -1238,6 +1240,10 @@ Status multiSyncApply_noAbort(OperationContext* opCtx,
     // Allow us to get through the magic barrier.
     opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
 
+    // Oplog application is what keeps secondaries current; let it go ahead of user operations
+    // waiting for a storage engine ticket.
+    opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kHigh);
+
     // Sort the oplog entries by namespace, so that entries from the same namespace will be next to
     // each other in the list.
     if (oplogEntryPointers->size() > 1) {
@@ -1431,6 +1437,7 @@ Status multiInitialSyncApply_noAbort(OperationContext* opCtx,
 
     // allow us to get through the magic barrier
     opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+    opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kHigh);
 
     for (auto it = ops->begin(); it != ops->end(); ++it) {
         auto& entry = **it;
@@ -42,27 +42,30 @@ namespace mongo {
 ActiveMigrationsRegistry::ActiveMigrationsRegistry() = default;
 
 ActiveMigrationsRegistry::~ActiveMigrationsRegistry() {
-    invariant(!_activeMoveChunkState);
+    invariant(_activeMoveChunkStates.empty());
 }
 
 StatusWith<ScopedRegisterDonateChunk> ActiveMigrationsRegistry::registerDonateChunk(
     const MoveChunkRequest& args) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    if (_activeReceiveChunkState) {
+    if (_activeReceiveChunkState && _activeReceiveChunkState->nss == args.getNss()) {
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
-        if (_activeMoveChunkState->args == args) {
-            return {ScopedRegisterDonateChunk(nullptr, false, _activeMoveChunkState->notification)};
+    auto it = _activeMoveChunkStates.find(args.getNss());
+    if (it != _activeMoveChunkStates.end()) {
+        const auto& activeMoveChunkState = it->second;
+        if (activeMoveChunkState.args == args) {
+            return {ScopedRegisterDonateChunk(
+                nullptr, false, activeMoveChunkState.notification, args.getNss())};
         }
 
-        return _activeMoveChunkState->constructErrorStatus();
+        return activeMoveChunkState.constructErrorStatus();
     }
 
-    _activeMoveChunkState.emplace(args);
+    it = _activeMoveChunkStates.emplace(args.getNss(), ActiveMoveChunkState(args)).first;
 
-    return {ScopedRegisterDonateChunk(this, true, _activeMoveChunkState->notification)};
+    return {ScopedRegisterDonateChunk(this, true, it->second.notification, args.getNss())};
 }
 
 StatusWith<ScopedRegisterReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
@@ -72,8 +75,9 @@ StatusWith<ScopedRegisterReceiveChunk> ActiveMigrationsRegistry::registerReceive
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->constructErrorStatus();
+    auto it = _activeMoveChunkStates.find(nss);
+    if (it != _activeMoveChunkStates.end()) {
+        return it->second.constructErrorStatus();
     }
 
     _activeReceiveChunkState.emplace(nss, chunkRange, fromShardId);
@@ -81,46 +85,46 @@ StatusWith<ScopedRegisterReceiveChunk> ActiveMigrationsRegistry::registerReceive
     return {ScopedRegisterReceiveChunk(this)};
 }
 
-boost::optional<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNss() {
+std::vector<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNamespaces() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->args.getNss();
+
+    std::vector<NamespaceString> namespaces;
+    namespaces.reserve(_activeMoveChunkStates.size());
+
+    for (const auto& entry : _activeMoveChunkStates) {
+        namespaces.push_back(entry.first);
     }
 
-    return boost::none;
+    return namespaces;
 }
 
-BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContext* opCtx) {
-    boost::optional<NamespaceString> nss;
-    {
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
+std::vector<BSONObj> ActiveMigrationsRegistry::getActiveMigrationStatusReports(
+    OperationContext* opCtx) {
+    const auto namespaces = getActiveDonateChunkNamespaces();
 
-        if (_activeMoveChunkState) {
-            nss = _activeMoveChunkState->args.getNss();
-        }
-    }
+    std::vector<BSONObj> reports;
+    reports.reserve(namespaces.size());
 
     // The state of the MigrationSourceManager could change between taking and releasing the mutex
     // above and then taking the collection lock here, but that's fine because it isn't important to
     // return information on a migration that just ended or started. This is just best effort and
     // desireable for reporting, and then diagnosing, migrations that are stuck.
-    if (nss) {
+    for (const auto& nss : namespaces) {
         // Lock the collection so nothing changes while we're getting the migration report.
-        AutoGetCollection autoColl(opCtx, nss.get(), MODE_IS);
+        AutoGetCollection autoColl(opCtx, nss, MODE_IS);
 
-        auto css = CollectionShardingState::get(opCtx, nss.get());
+        auto css = CollectionShardingState::get(opCtx, nss);
         if (css->getMigrationSourceManager()) {
-            return css->getMigrationSourceManager()->getMigrationStatusReport();
+            reports.push_back(css->getMigrationSourceManager()->getMigrationStatusReport());
         }
     }
 
-    return BSONObj();
+    return reports;
 }
 
-void ActiveMigrationsRegistry::_clearDonateChunk() {
+void ActiveMigrationsRegistry::_clearDonateChunk(const NamespaceString& nss) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    invariant(_activeMoveChunkState);
-    _activeMoveChunkState.reset();
+    invariant(_activeMoveChunkStates.erase(nss));
 }
 
 void ActiveMigrationsRegistry::_clearReceiveChunk() {
@@ -154,16 +158,18 @@ Status ActiveMigrationsRegistry::ActiveReceiveChunkState::constructErrorStatus()
 ScopedRegisterDonateChunk::ScopedRegisterDonateChunk(
     ActiveMigrationsRegistry* registry,
     bool forUnregister,
-    std::shared_ptr<Notification<Status>> completionNotification)
+    std::shared_ptr<Notification<Status>> completionNotification,
+    NamespaceString nss)
     : _registry(registry),
       _forUnregister(forUnregister),
-      _completionNotification(std::move(completionNotification)) {}
+      _completionNotification(std::move(completionNotification)),
+      _nss(std::move(nss)) {}
 
 ScopedRegisterDonateChunk::~ScopedRegisterDonateChunk() {
     if (_registry && _forUnregister) {
         // If this is a newly started migration the caller must always signal on completion
         invariant(*_completionNotification);
-        _registry->_clearDonateChunk();
+        _registry->_clearDonateChunk(_nss);
     }
 }
 
@@ -177,6 +183,7 @@ ScopedRegisterDonateChunk& ScopedRegisterDonateChunk::operator=(ScopedRegisterDo
         other._registry = nullptr;
         _forUnregister = other._forUnregister;
         _completionNotification = std::move(other._completionNotification);
+        _nss = std::move(other._nss);
     }
 
     return *this;
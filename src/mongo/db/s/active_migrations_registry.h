@@ -29,6 +29,8 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <map>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/s/migration_session_id.h"
@@ -46,8 +48,9 @@ template <typename T>
 class StatusWith;
 
 /**
- * Thread-safe object, which keeps track of the active migrations running on a node and limits them
- * to only one per-shard. There is only one instance of this object per shard.
+ * Thread-safe object, which keeps track of the active migrations running on a node. A shard can
+ * donate chunks of different collections concurrently, but only one chunk per collection, and can
+ * receive only one chunk at a time. There is only one instance of this object per shard.
  */
 class ActiveMigrationsRegistry {
     MONGO_DISALLOW_COPYING(ActiveMigrationsRegistry);
@@ -57,22 +60,22 @@ public:
     ~ActiveMigrationsRegistry();
 
     /**
-     * If there are no migrations running on this shard, registers an active migration with the
-     * specified arguments and returns a ScopedRegisterDonateChunk, which must be signaled by the
-     * caller before it goes out of scope.
+     * If there are no migrations of the same collection running on this shard, registers an active
+     * migration with the specified arguments and returns a ScopedRegisterDonateChunk, which must be
+     * signaled by the caller before it goes out of scope.
      *
-     * If there is an active migration already running on this shard and it has the exact same
-     * arguments, returns a ScopedRegisterDonateChunk, which can be used to join the already running
-     * migration.
+     * If there is an active migration of the same collection already running on this shard and it
+     * has the exact same arguments, returns a ScopedRegisterDonateChunk, which can be used to join
+     * the already running migration.
      *
      * Otherwise returns a ConflictingOperationInProgress error.
      */
     StatusWith<ScopedRegisterDonateChunk> registerDonateChunk(const MoveChunkRequest& args);
 
     /**
-     * If there are no migrations running on this shard, registers an active receive operation with
-     * the specified session id and returns a ScopedRegisterReceiveChunk, which will unregister it
-     * when it goes out of scope.
+     * If there are no chunks being received by this shard and no chunks of the same collection
+     * being donated, registers an active receive operation with the specified session id and
+     * returns a ScopedRegisterReceiveChunk, which will unregister it when it goes out of scope.
      *
      * Otherwise returns a ConflictingOperationInProgress error.
      */
@@ -81,18 +84,18 @@ public:
                                                                 const ShardId& fromShardId);
 
     /**
-     * If a migration has been previously registered through a call to registerDonateChunk returns
-     * that namespace. Otherwise returns boost::none.
+     * Returns the namespaces of all the migrations, which have been previously registered through a
+     * call to registerDonateChunk and are still active.
      */
-    boost::optional<NamespaceString> getActiveDonateChunkNss();
+    std::vector<NamespaceString> getActiveDonateChunkNamespaces();
 
     /**
-     * Returns a report on the active migration if there currently is one. Otherwise, returns an
-     * empty BSONObj.
+     * Returns a report on each of the active migrations, which this shard is donating, in order of
+     * namespace. Returns an empty vector if there are none.
      *
-     * Takes an IS lock on the namespace of the active migration, if one is active.
+     * Takes an IS lock on the namespace of each active migration in turn.
      */
-    BSONObj getActiveMigrationStatusReport(OperationContext* opCtx);
+    std::vector<BSONObj> getActiveMigrationStatusReports(OperationContext* opCtx);
 
 private:
     friend class ScopedRegisterDonateChunk;
@@ -137,9 +140,9 @@ private:
 
     /**
      * Unregisters a previously registered namespace with ongoing migration. Must only be called if
-     * a previous call to registerDonateChunk has succeeded.
+     * a previous call to registerDonateChunk for that namespace has succeeded.
      */
-    void _clearDonateChunk();
+    void _clearDonateChunk(const NamespaceString& nss);
 
     /**
      * Unregisters a previously registered incoming migration. Must only be called if a previous
@@ -150,9 +153,9 @@ private:
     // Protects the state below
     stdx::mutex _mutex;
 
-    // If there is an active moveChunk operation going on, this field contains the request, which
-    // initiated it
-    boost::optional<ActiveMoveChunkState> _activeMoveChunkState;
+    // Contains the requests, which initiated the currently active moveChunk operations, keyed by
+    // the namespace of the chunk being donated
+    std::map<NamespaceString, ActiveMoveChunkState> _activeMoveChunkStates;
 
     // If there is an active receive of a chunk going on, this field contains the session id, which
     // initiated it
@@ -170,7 +173,8 @@ class ScopedRegisterDonateChunk {
 public:
     ScopedRegisterDonateChunk(ActiveMigrationsRegistry* registry,
                               bool forUnregister,
-                              std::shared_ptr<Notification<Status>> completionNotification);
+                              std::shared_ptr<Notification<Status>> completionNotification,
+                              NamespaceString nss);
     ~ScopedRegisterDonateChunk();
 
     ScopedRegisterDonateChunk(ScopedRegisterDonateChunk&&);
@@ -206,6 +210,9 @@ private:
 
     // This is the future, which will be signaled at the end of a migration
     std::shared_ptr<Notification<Status>> _completionNotification;
+
+    // Namespace of the chunk being donated
+    NamespaceString _nss;
 };
 
 /**
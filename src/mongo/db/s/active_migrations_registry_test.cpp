@@ -64,7 +64,9 @@ protected:
     ActiveMigrationsRegistry _registry;
 };
 
-MoveChunkRequest createMoveChunkRequest(const NamespaceString& nss) {
+MoveChunkRequest createMoveChunkRequest(
+    const NamespaceString& nss,
+    const ChunkRange& chunkRange = ChunkRange(BSON("Key" << -100), BSON("Key" << 100))) {
     const ChunkVersion chunkVersion(1, 2, OID::gen());
 
     BSONObjBuilder builder;
@@ -75,7 +77,7 @@ MoveChunkRequest createMoveChunkRequest(const NamespaceString& nss) {
         assertGet(ConnectionString::parse("TestConfigRS/CS1:12345,CS2:12345,CS3:12345")),
         ShardId("shard0001"),
         ShardId("shard0002"),
-        ChunkRange(BSON("Key" << -100), BSON("Key" << 100)),
+        chunkRange,
         1024,
         MigrationSecondaryThrottleOptions::create(MigrationSecondaryThrottleOptions::kOff),
         true);
@@ -99,31 +101,74 @@ TEST_F(MoveChunkRegistration, ScopedRegisterDonateChunkMoveConstructorAndAssignm
 }
 
 TEST_F(MoveChunkRegistration, GetActiveMigrationNamespace) {
-    ASSERT(!_registry.getActiveDonateChunkNss());
+    ASSERT(_registry.getActiveDonateChunkNamespaces().empty());
 
     const NamespaceString nss("TestDB", "TestColl");
 
     auto originalScopedRegisterDonateChunk =
         assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss)));
 
-    ASSERT_EQ(nss.ns(), _registry.getActiveDonateChunkNss()->ns());
+    const auto namespaces = _registry.getActiveDonateChunkNamespaces();
+    ASSERT_EQ(1U, namespaces.size());
+    ASSERT_EQ(nss.ns(), namespaces[0].ns());
 
     // Need to signal the registered migration so the destructor doesn't invariant
     originalScopedRegisterDonateChunk.complete(Status::OK());
 }
 
 TEST_F(MoveChunkRegistration, SecondMigrationReturnsConflictingOperationInProgress) {
-    auto originalScopedRegisterDonateChunk = assertGet(_registry.registerDonateChunk(
-        createMoveChunkRequest(NamespaceString("TestDB", "TestColl1"))));
+    const NamespaceString nss("TestDB", "TestColl");
+
+    auto originalScopedRegisterDonateChunk =
+        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss)));
 
     auto secondScopedRegisterDonateChunkStatus = _registry.registerDonateChunk(
-        createMoveChunkRequest(NamespaceString("TestDB", "TestColl2")));
+        createMoveChunkRequest(nss, ChunkRange(BSON("Key" << 100), BSON("Key" << 200))));
     ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
               secondScopedRegisterDonateChunkStatus.getStatus());
 
     originalScopedRegisterDonateChunk.complete(Status::OK());
 }
 
+TEST_F(MoveChunkRegistration, MigrationsOfDifferentCollectionsRunConcurrently) {
+    auto firstScopedRegisterDonateChunk = assertGet(_registry.registerDonateChunk(
+        createMoveChunkRequest(NamespaceString("TestDB", "TestColl1"))));
+    ASSERT(firstScopedRegisterDonateChunk.mustExecute());
+
+    auto secondScopedRegisterDonateChunk = assertGet(_registry.registerDonateChunk(
+        createMoveChunkRequest(NamespaceString("TestDB", "TestColl2"))));
+    ASSERT(secondScopedRegisterDonateChunk.mustExecute());
+
+    ASSERT_EQ(2U, _registry.getActiveDonateChunkNamespaces().size());
+
+    firstScopedRegisterDonateChunk.complete(Status::OK());
+    secondScopedRegisterDonateChunk.complete(Status::OK());
+}
+
+TEST_F(MoveChunkRegistration, ReceiveChunkOfDonatedCollectionReturnsConflictingOperation) {
+    const NamespaceString nss("TestDB", "TestColl1");
+
+    auto scopedRegisterDonateChunk =
+        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss)));
+
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+              _registry
+                  .registerReceiveChunk(nss,
+                                        ChunkRange(BSON("Key" << 100), BSON("Key" << 200)),
+                                        ShardId("shard0002"))
+                  .getStatus());
+
+    {
+        auto scopedRegisterReceiveChunk =
+            assertGet(_registry.registerReceiveChunk(NamespaceString("TestDB", "TestColl2"),
+                                                     ChunkRange(BSON("Key" << 100),
+                                                                BSON("Key" << 200)),
+                                                     ShardId("shard0002")));
+    }
+
+    scopedRegisterDonateChunk.complete(Status::OK());
+}
+
 TEST_F(MoveChunkRegistration, SecondMigrationWithSameArgumentsJoinsFirst) {
     auto originalScopedRegisterDonateChunk = assertGet(_registry.registerDonateChunk(
         createMoveChunkRequest(NamespaceString("TestDB", "TestColl"))));
@@ -32,10 +32,12 @@
 
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy_impl.h"
 
+#include <map>
 #include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog/type_collection.h"
@@ -254,7 +256,15 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     }
 
     MigrateInfoVector candidateChunks;
+
+    // Shards which cannot take part in any more migrations during this round. A shard can only
+    // receive one chunk at a time, but it may donate chunks of different collections concurrently,
+    // up to the configured limit.
     std::set<ShardId> usedShards;
+    std::map<ShardId, int> donatedMigrationsCount;
+
+    const int maxConcurrentMigrationsPerShard =
+        Grid::get(opCtx)->getBalancerConfiguration()->getMaxConcurrentMigrationsPerShard();
 
     for (const auto& coll : collections) {
         if (coll.getDropped()) {
@@ -268,8 +278,11 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
+        // Within a single collection each shard can take part in at most one migration
+        std::set<ShardId> usedShardsForCollection(usedShards);
+
         auto candidatesStatus = _getMigrateCandidatesForCollection(
-            opCtx, nss, shardStats, aggressiveBalanceHint, &usedShards);
+            opCtx, nss, shardStats, aggressiveBalanceHint, &usedShardsForCollection);
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
             // Namespace got dropped before we managed to get to it, so just skip it
             continue;
@@ -279,6 +292,14 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
+        for (const auto& migrateInfo : candidatesStatus.getValue()) {
+            usedShards.insert(migrateInfo.to);
+
+            if (++donatedMigrationsCount[migrateInfo.from] >= maxConcurrentMigrationsPerShard) {
+                usedShards.insert(migrateInfo.from);
+            }
+        }
+
         candidateChunks.insert(candidateChunks.end(),
                                std::make_move_iterator(candidatesStatus.getValue().begin()),
                                std::make_move_iterator(candidatesStatus.getValue().end()));
@@ -469,7 +490,17 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         }
     }
 
-    return BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint, usedShards);
+    auto migrations =
+        BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint, usedShards);
+
+    if (Grid::get(opCtx)->getBalancerConfiguration()->balanceByLoad()) {
+        auto loadMigrations = BalancerPolicy::balanceByLoad(shardStats, distribution, usedShards);
+        migrations.insert(migrations.end(),
+                          std::make_move_iterator(loadMigrations.begin()),
+                          std::make_move_iterator(loadMigrations.end()));
+    }
+
+    return migrations;
 }
 
 }  // namespace mongo
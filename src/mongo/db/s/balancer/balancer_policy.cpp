@@ -32,6 +32,8 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <algorithm>
+
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog/type_tags.h"
 #include "mongo/util/log.h"
@@ -52,6 +54,11 @@ namespace {
 const size_t kDefaultImbalanceThreshold = 2;
 const size_t kAggressiveImbalanceThreshold = 1;
 
+// When balancing by load, the busiest shard must serve at least this many operations per second and
+// at least this many times more operations than the receiving shard for a migration to be initiated
+const uint64_t kMinOpsPerSecondForLoadBalancing = 1000;
+const uint64_t kLoadImbalanceFactor = 2;
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
@@ -265,6 +272,31 @@ ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector
     return best;
 }
 
+const ClusterStatistics::ShardStatistics* BalancerPolicy::_getLeastBusyReceiverShard(
+    const ShardStatisticsVector& shardStats,
+    const string& tag,
+    const set<ShardId>& excludedShards) {
+    const ClusterStatistics::ShardStatistics* best = nullptr;
+
+    for (const auto& stat : shardStats) {
+        if (excludedShards.count(stat.shardId))
+            continue;
+
+        auto status = isShardSuitableReceiver(stat, tag);
+        if (!status.isOK()) {
+            continue;
+        }
+
+        if (best && stat.opsPerSecond >= best->opsPerSecond) {
+            continue;
+        }
+
+        best = &stat;
+    }
+
+    return best;
+}
+
 ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& shardStats,
                                                 const DistributionStatus& distribution,
                                                 const string& chunkTag,
@@ -437,6 +469,90 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
     return migrations;
 }
 
+vector<MigrateInfo> BalancerPolicy::balanceByLoad(const ShardStatisticsVector& shardStats,
+                                                  const DistributionStatus& distribution,
+                                                  std::set<ShardId>* usedShards) {
+    vector<MigrateInfo> migrations;
+
+    const ClusterStatistics::ShardStatistics* busiest = nullptr;
+
+    for (const auto& stat : shardStats) {
+        if (stat.isDraining || usedShards->count(stat.shardId))
+            continue;
+
+        if (!busiest || stat.opsPerSecond > busiest->opsPerSecond) {
+            busiest = &stat;
+        }
+    }
+
+    if (!busiest || busiest->opsPerSecond < kMinOpsPerSecondForLoadBalancing ||
+        !busiest->totalChunkWriteOps) {
+        return migrations;
+    }
+
+    const vector<ChunkType>& chunks = distribution.getChunks(busiest->shardId);
+
+    // The hot chunks are reported in decreasing order of writes, so the first one, which can be
+    // moved, is the one which takes the most load off of the busiest shard
+    for (const auto& chunkLoad : busiest->hotChunks) {
+        if (chunkLoad.ns != distribution.nss().ns())
+            continue;
+
+        const auto chunkIt = std::find_if(chunks.begin(), chunks.end(), [&](const ChunkType& c) {
+            return SimpleBSONObjComparator::kInstance.evaluate(c.getMin() == chunkLoad.min);
+        });
+
+        // The shard may report chunks, which it no longer owns according to the config server
+        if (chunkIt == chunks.end())
+            continue;
+
+        const ChunkType& chunk = *chunkIt;
+
+        if (chunk.getJumbo()) {
+            LOG(1) << "Chunk " << redact(chunk.toString()) << " is hot, but it is jumbo and "
+                   << "cannot be moved";
+            continue;
+        }
+
+        const string tag = distribution.getTagForChunk(chunk);
+
+        const auto receiver = _getLeastBusyReceiverShard(shardStats, tag, *usedShards);
+        if (!receiver || receiver->shardId == busiest->shardId)
+            continue;
+
+        if (busiest->opsPerSecond < kLoadImbalanceFactor * receiver->opsPerSecond)
+            continue;
+
+        // Assume the chunk accounts for the same share of the shard's operations as it does of
+        // the writes tracked by the shard
+        const uint64_t chunkOpsPerSecond = static_cast<uint64_t>(
+            static_cast<double>(busiest->opsPerSecond) * chunkLoad.writeOps /
+            busiest->totalChunkWriteOps);
+
+        // Moving the chunk must leave the receiver less busy than the donor, otherwise it would
+        // just move the hot spot from one shard to the other
+        if (receiver->opsPerSecond + 2 * chunkOpsPerSecond >= busiest->opsPerSecond) {
+            LOG(1) << "Chunk " << redact(chunk.toString()) << " carries too much of the load of "
+                   << busiest->shardId << " to be moved to " << receiver->shardId
+                   << " without moving the hot spot along with it";
+            continue;
+        }
+
+        LOG(1) << "collection : " << distribution.nss().ns();
+        LOG(1) << "zone       : " << tag;
+        LOG(1) << "donor      : " << busiest->shardId << " ops/sec " << busiest->opsPerSecond;
+        LOG(1) << "receiver   : " << receiver->shardId << " ops/sec " << receiver->opsPerSecond;
+        LOG(1) << "chunk      : " << redact(chunk.toString()) << " ops/sec " << chunkOpsPerSecond;
+
+        migrations.emplace_back(receiver->shardId, chunk);
+        invariant(usedShards->insert(busiest->shardId).second);
+        invariant(usedShards->insert(receiver->shardId).second);
+        break;
+    }
+
+    return migrations;
+}
+
 boost::optional<MigrateInfo> BalancerPolicy::balanceSingleChunk(
     const ChunkType& chunk,
     const ShardStatisticsVector& shardStats,
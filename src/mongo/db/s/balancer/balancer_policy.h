@@ -192,6 +192,20 @@ public:
                                             bool shouldAggressivelyBalance,
                                             std::set<ShardId>* usedShards);
 
+    /**
+     * Returns at most one suggested migration, which moves one of the most written chunks of the
+     * collection off of the shard serving the most operations onto the one serving the least. Only
+     * suggests a migration if the busiest shard serves sufficiently more operations than the
+     * receiver and if moving the chunk, based on its estimated share of the load of its shard,
+     * would even out the load of the two shards rather than just move the hot spot.
+     *
+     * The usedShards parameter has the same meaning as for balance() and is updated with the
+     * shards used by the returned migration.
+     */
+    static std::vector<MigrateInfo> balanceByLoad(const ShardStatisticsVector& shardStats,
+                                                  const DistributionStatus& distribution,
+                                                  std::set<ShardId>* usedShards);
+
     /**
      * Using the specified distribution information, returns a suggested better location for the
      * specified chunk if one is available.
@@ -210,6 +224,15 @@ private:
                                                 const std::string& tag,
                                                 const std::set<ShardId>& excludedShards);
 
+    /**
+     * Return the shard with the specified tag, which serves the least operations per second. If the
+     * tag is empty, considers all shards. Returns nullptr if there is no suitable shard.
+     */
+    static const ClusterStatistics::ShardStatistics* _getLeastBusyReceiverShard(
+        const ShardStatisticsVector& shardStats,
+        const std::string& tag,
+        const std::set<ShardId>& excludedShards);
+
     /**
      * Return the shard which has the least number of chunks with the specified tag. If the tag is
      * empty, considers all chunks.
@@ -110,6 +110,36 @@ std::pair<ShardStatisticsVector, ShardToChunksMap> generateCluster(
     return std::make_pair(std::move(shardStats), std::move(chunkMap));
 }
 
+/**
+ * Constructs shard statistics for a shard, which serves the specified number of operations per
+ * second and has tracked the specified number of writes against the chunks of the test namespace
+ * with the given min values.
+ */
+ShardStatistics makeLoadedShardStats(const ShardId& shardId,
+                                     uint64_t opsPerSecond,
+                                     uint64_t totalChunkWriteOps,
+                                     const vector<std::pair<BSONObj, uint64_t>>& hotChunks) {
+    ShardStatistics stats(shardId, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion);
+    stats.opsPerSecond = opsPerSecond;
+    stats.totalChunkWriteOps = totalChunkWriteOps;
+
+    for (const auto& hotChunk : hotChunks) {
+        ClusterStatistics::ChunkLoad chunkLoad;
+        chunkLoad.ns = kNamespace.ns();
+        chunkLoad.min = hotChunk.first;
+        chunkLoad.writeOps = hotChunk.second;
+        stats.hotChunks.push_back(std::move(chunkLoad));
+    }
+
+    return stats;
+}
+
+std::vector<MigrateInfo> balanceChunksByLoad(const ShardStatisticsVector& shardStats,
+                                             const DistributionStatus& distribution) {
+    std::set<ShardId> usedShards;
+    return BalancerPolicy::balanceByLoad(shardStats, distribution, &usedShards);
+}
+
 std::vector<MigrateInfo> balanceChunks(const ShardStatisticsVector& shardStats,
                                        const DistributionStatus& distribution,
                                        bool shouldAggressivelyBalance) {
@@ -760,5 +790,63 @@ TEST(DistributionStatus, ChunkTagsSelectorWithMinMaxKeys) {
     }
 }
 
+TEST(BalancerPolicy, BalanceByLoadMovesHottestChunk) {
+    auto cluster = generateCluster(
+        {{makeLoadedShardStats(kShardId0, 10000, 100, {{BSON("x" << 2), 40}, {BSON("x" << 1), 30}}),
+          4},
+         {makeLoadedShardStats(kShardId1, 1000, 0, {}), 4}});
+
+    const auto migrations(
+        balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second)));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(BSON("x" << 2), migrations[0].minKey);
+}
+
+TEST(BalancerPolicy, BalanceByLoadDoesNotMoveTheHotSpot) {
+    // The hottest chunk carries most of the load of its shard, so moving it would just make the
+    // receiver the busiest shard. The next hottest chunk should be moved instead.
+    auto cluster = generateCluster(
+        {{makeLoadedShardStats(kShardId0, 10000, 100, {{BSON("x" << 2), 90}, {BSON("x" << 1), 10}}),
+          4},
+         {makeLoadedShardStats(kShardId1, 1000, 0, {}), 4}});
+
+    const auto migrations(
+        balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second)));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(BSON("x" << 1), migrations[0].minKey);
+}
+
+TEST(BalancerPolicy, BalanceByLoadNoMigrationWhenLoadIsEven) {
+    auto cluster = generateCluster(
+        {{makeLoadedShardStats(kShardId0, 10000, 100, {{BSON("x" << 2), 40}}), 4},
+         {makeLoadedShardStats(kShardId1, 6000, 100, {{BSON("x" << 5), 40}}), 4}});
+
+    ASSERT(balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second))
+               .empty());
+}
+
+TEST(BalancerPolicy, BalanceByLoadNoMigrationWhenLoadIsLow) {
+    auto cluster =
+        generateCluster({{makeLoadedShardStats(kShardId0, 500, 100, {{BSON("x" << 2), 40}}), 4},
+                         {makeLoadedShardStats(kShardId1, 0, 0, {}), 4}});
+
+    ASSERT(balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second))
+               .empty());
+}
+
+TEST(BalancerPolicy, BalanceByLoadSkipsChunksNotOwnedByTheShard) {
+    // The shard reports a chunk, which the config server knows to be on another shard
+    auto cluster = generateCluster(
+        {{makeLoadedShardStats(kShardId0, 10000, 100, {{BSON("x" << 6), 40}}), 4},
+         {makeLoadedShardStats(kShardId1, 1000, 0, {}), 4}});
+
+    ASSERT(balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second))
+               .empty());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -34,11 +34,11 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/s/client/shard.h"
 
 namespace mongo {
 
-class BSONObj;
 class OperationContext;
 template <typename T>
 class StatusWith;
@@ -52,6 +52,21 @@ class ClusterStatistics {
     MONGO_DISALLOW_COPYING(ClusterStatistics);
 
 public:
+    /**
+     * Structure, which describes the writes a shard has tracked against one of its chunks.
+     */
+    struct ChunkLoad {
+        // The namespace of the collection to which the chunk belongs
+        std::string ns;
+
+        // The min key of the chunk
+        BSONObj min;
+
+        // Decayed count of the writes the shard has applied to the chunk. The shard halves the
+        // count every time it reports it, so recent writes weigh more than older ones.
+        uint64_t writeOps{0};
+    };
+
     /**
      * Structure, which describes the statistics of a single shard host.
      */
@@ -92,6 +107,17 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Rate of operations served by this shard's primary, measured between the two most recent
+        // statistics snapshots. Zero if not known yet.
+        uint64_t opsPerSecond{0};
+
+        // Total decayed count of the writes the shard has tracked against all of its chunks
+        uint64_t totalChunkWriteOps{0};
+
+        // The chunks of the shard with the most writes tracked against them, in decreasing order of
+        // writes
+        std::vector<ChunkLoad> hotChunks;
     };
 
     virtual ~ClusterStatistics();
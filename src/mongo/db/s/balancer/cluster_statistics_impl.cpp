@@ -51,16 +51,22 @@ using std::vector;
 namespace {
 
 const char kVersionField[] = "version";
+const char kOpCountersField[] = "opcounters";
+const char kHotChunksField[] = "hotChunks";
+
+// Minimum amount of time between two op counter samples of a shard for the difference between them
+// to be used as the shard's operation rate. Statistics may be requested several times per balancer
+// round and samples taken too close together would give a very noisy rate.
+const Milliseconds kMinOpCountSampleInterval = Seconds(5);
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard, including the sections needed to
+ * obtain the version of the running MongoD service and its operation load.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Returns the serverStatus response or an error. Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx, ShardId shardId) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -72,7 +78,7 @@ StatusWith<string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId s
         shard->runCommandWithFixedRetryAttempts(opCtx,
                                                 ReadPreferenceSetting{ReadPreference::PrimaryOnly},
                                                 "admin",
-                                                BSON("serverStatus" << 1),
+                                                BSON("serverStatus" << 1 << kHotChunksField << 1),
                                                 Shard::RetryPolicy::kIdempotent);
     if (!commandResponse.isOK()) {
         return commandResponse.getStatus();
@@ -81,15 +87,59 @@ StatusWith<string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId s
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
+    return std::move(commandResponse.getValue().response);
+}
+
+/**
+ * Returns the total number of operations of all types reported by a serverStatus response.
+ */
+long long getTotalOpCount(const BSONObj& serverStatus) {
+    const BSONElement opCountersElem = serverStatus[kOpCountersField];
+    if (opCountersElem.type() != Object) {
+        return 0;
+    }
 
-    string version;
-    Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
-    if (!status.isOK()) {
-        return status;
+    long long totalOpCount = 0;
+    for (const auto& opCounter : opCountersElem.Obj()) {
+        if (opCounter.isNumber()) {
+            totalOpCount += opCounter.safeNumberLong();
+        }
     }
 
-    return version;
+    return totalOpCount;
+}
+
+/**
+ * Extracts the per-chunk write statistics reported by a shard's serverStatus response.
+ */
+void extractHotChunks(const BSONObj& serverStatus, ClusterStatistics::ShardStatistics* stat) {
+    const BSONElement hotChunksElem = serverStatus[kHotChunksField];
+    if (hotChunksElem.type() != Object) {
+        return;
+    }
+
+    const BSONObj hotChunks = hotChunksElem.Obj();
+    stat->totalChunkWriteOps = hotChunks["totalWriteOps"].safeNumberLong();
+
+    const BSONElement chunksElem = hotChunks["chunks"];
+    if (chunksElem.type() != Array) {
+        return;
+    }
+
+    for (const auto& chunkElem : chunksElem.Obj()) {
+        if (chunkElem.type() != Object)
+            continue;
+
+        const BSONObj chunk = chunkElem.Obj();
+        if (chunk["min"].type() != Object)
+            continue;
+
+        ClusterStatistics::ChunkLoad chunkLoad;
+        chunkLoad.ns = chunk["ns"].str();
+        chunkLoad.min = chunk["min"].Obj().getOwned();
+        chunkLoad.writeOps = chunk["writeOps"].safeNumberLong();
+        stat->hotChunks.push_back(std::move(chunkLoad));
+    }
 }
 
 }  // namespace
@@ -134,8 +184,27 @@ StatusWith<vector<ShardStatistics>> ClusterStatisticsImpl::getStats(OperationCon
         }
 
         string mongoDVersion;
+        BSONObj serverStatus;
+
+        auto serverStatusStatus = retrieveShardServerStatus(opCtx, shard.getName());
+        if (serverStatusStatus.isOK()) {
+            serverStatus = std::move(serverStatusStatus.getValue());
+        }
+
+        auto mongoDVersionStatus = [&]() -> StatusWith<string> {
+            if (!serverStatusStatus.isOK()) {
+                return serverStatusStatus.getStatus();
+            }
+
+            string version;
+            Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            return version;
+        }();
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
         if (mongoDVersionStatus.isOK()) {
             mongoDVersion = std::move(mongoDVersionStatus.getValue());
         } else {
@@ -157,9 +226,44 @@ StatusWith<vector<ShardStatistics>> ClusterStatisticsImpl::getStats(OperationCon
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+
+        // The load statistics are only used by the load balancing policy, which treats missing
+        // information as an idle shard, so don't fail the round if they are not available either
+        if (serverStatusStatus.isOK()) {
+            auto& stat = stats.back();
+            stat.opsPerSecond = _sampleOpsPerSecond(stat.shardId, getTotalOpCount(serverStatus));
+            extractHotChunks(serverStatus, &stat);
+        }
     }
 
     return stats;
 }
 
+uint64_t ClusterStatisticsImpl::_sampleOpsPerSecond(const ShardId& shardId,
+                                                    long long totalOpCount) {
+    const Date_t now = Date_t::now();
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = _opCountSamples.find(shardId);
+    if (it == _opCountSamples.end() || totalOpCount < it->second.totalOpCount) {
+        // Either the first sample for the shard or its counters were reset by a restart, so there
+        // is nothing to compare against yet
+        _opCountSamples[shardId] = {totalOpCount, now, 0};
+        return 0;
+    }
+
+    auto& sample = it->second;
+
+    const auto elapsed = now - sample.sampledAt;
+    if (elapsed >= kMinOpCountSampleInterval) {
+        sample.opsPerSecond = (totalOpCount - sample.totalOpCount) * 1000 /
+            durationCount<Milliseconds>(elapsed);
+        sample.totalOpCount = totalOpCount;
+        sample.sampledAt = now;
+    }
+
+    return sample.opsPerSecond;
+}
+
 }  // namespace mongo
@@ -28,14 +28,19 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 /**
  * Default implementation for the cluster statistics gathering utility. Uses a blocking method to
- * fetch the statistics and does not perform any caching. If any of the shards fails to report
- * statistics fails the entire refresh.
+ * fetch the statistics and does not perform any caching, except for the previous operation counter
+ * sample of each shard, which is needed to compute its operation rate. If any of the shards fails
+ * to report statistics fails the entire refresh.
  */
 class ClusterStatisticsImpl final : public ClusterStatistics {
 public:
@@ -43,6 +48,30 @@ public:
     ~ClusterStatisticsImpl();
 
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
+
+private:
+    struct OpCountSample {
+        // Total operation count reported by the shard at the time of the sample
+        long long totalOpCount;
+
+        // When the sample was taken
+        Date_t sampledAt;
+
+        // Rate computed from this sample and the one preceding it
+        uint64_t opsPerSecond;
+    };
+
+    /**
+     * Records the total operation count just reported by the specified shard and returns the
+     * shard's most recently measured operation rate.
+     */
+    uint64_t _sampleOpsPerSecond(const ShardId& shardId, long long totalOpCount);
+
+    // Protects the state below
+    stdx::mutex _mutex;
+
+    // The op counter sample against which the next rate of each shard will be computed
+    std::map<ShardId, OpCountSample> _opCountSamples;
 };
 
 }  // namespace mongo
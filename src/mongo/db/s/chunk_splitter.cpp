@@ -47,6 +47,7 @@
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/chunk_manager.h"
 #include "mongo/s/config_server_client.h"
+#include "mongo/s/chunk.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/assert_util.h"
@@ -305,27 +306,49 @@ void ChunkSplitter::_runAutosplit(const NamespaceString& nss,
 
         const uint64_t maxChunkSizeBytes = balancerConfig->getMaxChunkSizeBytes();
 
+        // The size of the chunk is established through a single scan of its range the first time it
+        // is considered for splitting and is kept up to date by the write paths afterwards, so the
+        // shard key index does not need to be scanned every time the chunk is written to
+        uassertStatusOK(ensureChunkDataSizeTracked(
+            opCtx.get(), nss, cm->getShardKeyPattern().toBSON(), chunk.get()));
+
+        const long long dataSizeBytes = chunk->getDataSizeBytes();
+
         LOG(1) << "about to initiate autosplit: " << redact(chunk->toString())
                << " dataWritten since last check: " << dataWritten
+               << " dataSizeBytes: " << dataSizeBytes
                << " maxChunkSizeBytes: " << maxChunkSizeBytes;
 
-        auto splitPoints = uassertStatusOK(splitVector(opCtx.get(),
-                                                       nss,
-                                                       cm->getShardKeyPattern().toBSON(),
-                                                       chunk->getMin(),
-                                                       chunk->getMax(),
-                                                       false,
-                                                       boost::none,
-                                                       boost::none,
-                                                       boost::none,
-                                                       maxChunkSizeBytes));
-
-        if (splitPoints.size() <= 1) {
-            // No split points means there isn't enough data to split on; 1 split point means we
-            // have between half the chunk size to full chunk size so there is no need to split yet
+        if (dataSizeBytes < static_cast<long long>(maxChunkSizeBytes)) {
+            // The chunk has not grown beyond the maximum chunk size yet
             return;
         }
 
+        auto splitPoints = selectSplitPointsFromSample(
+            chunk->getSampledKeys(), chunk->getMin(), dataSizeBytes, maxChunkSizeBytes);
+
+        if (splitPoints.empty()) {
+            // The sampled keys are not diverse enough to choose split points from, so fall back to
+            // scanning the shard key index
+            splitPoints = uassertStatusOK(splitVector(opCtx.get(),
+                                                      nss,
+                                                      cm->getShardKeyPattern().toBSON(),
+                                                      chunk->getMin(),
+                                                      chunk->getMax(),
+                                                      false,
+                                                      boost::none,
+                                                      boost::none,
+                                                      boost::none,
+                                                      maxChunkSizeBytes));
+
+            if (splitPoints.size() <= 1) {
+                // No split points means there isn't enough data to split on; 1 split point means
+                // we have between half the chunk size to full chunk size so there is no need to
+                // split yet
+                return;
+            }
+        }
+
         // We assume that if the chunk being split is the first (or last) one on the collection,
         // this chunk is likely to see more insertions. Instead of splitting mid-chunk, we use the
         // very first (or last) key as a split point.
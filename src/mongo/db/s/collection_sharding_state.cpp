@@ -32,12 +32,15 @@
 
 #include "mongo/db/s/collection_sharding_state.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/catalog/catalog_raii.h"
 #include "mongo/db/client.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/chunk_splitter.h"
 #include "mongo/db/s/migration_chunk_cloner_source.h"
 #include "mongo/db/s/migration_source_manager.h"
 #include "mongo/db/s/operation_sharding_state.h"
@@ -59,6 +62,7 @@
 #include "mongo/s/grid.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/log.h"
+#include "mongo/util/periodic_runner.h"
 
 namespace mongo {
 namespace {
@@ -66,6 +70,12 @@ namespace {
 // How long to wait before starting cleanup of an emigrated chunk range
 MONGO_EXPORT_SERVER_PARAMETER(orphanCleanupDelaySecs, int, 900);  // 900s = 15m
 
+// Whether the shard primary schedules auto-splits of the chunks it owns through the ChunkSplitter
+MONGO_EXPORT_SERVER_PARAMETER(shardAutoSplitEnabled, bool, false);
+
+// How often the per-chunk write counts reported in serverStatus.hotChunks are halved
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(hotChunksDecayIntervalSecs, int, 10);
+
 // This map matches 1:1 with the set of collections in the storage catalog. It is not safe to
 // look-up values from this map without holding some form of collection lock. It is only safe to
 // add/remove values when holding X lock on the respective namespace.
@@ -110,12 +120,128 @@ public:
         versionB.done();
     }
 
+    /**
+     * Remembers that 'chunk' of collection 'ns' started taking writes, so that it is considered by
+     * reportHotChunks and decayHotChunks. Called on the first write after the chunk's write count
+     * was zero.
+     */
+    void noteChunkWritten(const std::string& ns, const std::shared_ptr<Chunk>& chunk) {
+        stdx::lock_guard<stdx::mutex> lg(_writtenChunksMutex);
+
+        // Overwrite rather than insert, in case the entry is left over from a destroyed chunk at
+        // the same address
+        _writtenChunks[chunk.get()] = WrittenChunk{ns, chunk};
+    }
+
+    /**
+     * Halves the write counts of the chunks taking writes, and forgets the chunks which are no
+     * longer cached or whose count decayed to zero. A write which increments the count from zero
+     * registers the chunk again after this.
+     */
+    void decayHotChunks() {
+        for (auto& hotChunk : _getWrittenChunks()) {
+            hotChunk.chunk->decayWriteOps();
+        }
+
+        stdx::lock_guard<stdx::mutex> lg(_writtenChunksMutex);
+
+        for (auto it = _writtenChunks.begin(); it != _writtenChunks.end();) {
+            auto chunk = it->second.chunk.lock();
+            if (!chunk || !chunk->getWriteOps()) {
+                it = _writtenChunks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void reportHotChunks(const ShardId& thisShardId, size_t limit, BSONObjBuilder* builder) {
+        std::vector<HotChunk> hotChunks = _getWrittenChunks();
+
+        long long totalWriteOps = 0;
+
+        for (auto& hotChunk : hotChunks) {
+            hotChunk.writeOps = hotChunk.chunk->getWriteOps();
+            if (hotChunk.chunk->getShardId() == thisShardId) {
+                totalWriteOps += hotChunk.writeOps;
+            }
+        }
+
+        hotChunks.erase(std::remove_if(hotChunks.begin(),
+                                       hotChunks.end(),
+                                       [&](const HotChunk& hotChunk) {
+                                           return !hotChunk.writeOps ||
+                                               hotChunk.chunk->getShardId() != thisShardId;
+                                       }),
+                        hotChunks.end());
+
+        const auto hotter = [](const HotChunk& a, const HotChunk& b) {
+            return a.writeOps > b.writeOps;
+        };
+
+        if (hotChunks.size() > limit) {
+            std::nth_element(hotChunks.begin(), hotChunks.begin() + limit, hotChunks.end(), hotter);
+            hotChunks.resize(limit);
+        }
+
+        std::sort(hotChunks.begin(), hotChunks.end(), hotter);
+
+        builder->append("totalWriteOps", totalWriteOps);
+
+        BSONArrayBuilder chunksB(builder->subarrayStart("chunks"));
+        for (const auto& hotChunk : hotChunks) {
+            BSONObjBuilder chunkB(chunksB.subobjStart());
+            chunkB.append("ns", hotChunk.ns);
+            chunkB.append("min", hotChunk.chunk->getMin());
+            chunkB.append("writeOps", static_cast<long long>(hotChunk.writeOps));
+            chunkB.doneFast();
+        }
+        chunksB.doneFast();
+    }
+
 private:
+    struct HotChunk {
+        std::string ns;
+        std::shared_ptr<Chunk> chunk;
+        uint64_t writeOps;
+    };
+
+    /**
+     * Returns the chunks which took writes since their count last decayed to zero, so that only
+     * they are visited rather than the routing table of every collection.
+     */
+    std::vector<HotChunk> _getWrittenChunks() {
+        std::vector<HotChunk> hotChunks;
+
+        stdx::lock_guard<stdx::mutex> lg(_writtenChunksMutex);
+        hotChunks.reserve(_writtenChunks.size());
+
+        for (const auto& writtenChunk : _writtenChunks) {
+            if (auto chunk = writtenChunk.second.chunk.lock()) {
+                hotChunks.push_back({writtenChunk.second.ns, std::move(chunk), 0});
+            }
+        }
+
+        return hotChunks;
+    }
+
     mutable stdx::mutex _mutex;
 
     using CollectionsMap =
         stdx::unordered_map<std::string, std::unique_ptr<CollectionShardingState>>;
     CollectionsMap _collections;
+
+    struct WrittenChunk {
+        std::string ns;
+        std::weak_ptr<Chunk> chunk;
+    };
+
+    // Protects _writtenChunks. Separate from the mutex above, because it is taken by the write
+    // path, although only when a chunk starts taking writes.
+    stdx::mutex _writtenChunksMutex;
+
+    // Cached chunks, whose write count is not zero, keyed by their address
+    stdx::unordered_map<const Chunk*, WrittenChunk> _writtenChunks;
 };
 
 const auto collectionShardingStateMap =
@@ -209,6 +335,25 @@ void CollectionShardingState::report(OperationContext* opCtx, BSONObjBuilder* bu
     collectionsMap.report(builder);
 }
 
+void CollectionShardingState::reportHotChunks(OperationContext* opCtx,
+                                              size_t limit,
+                                              BSONObjBuilder* builder) {
+    auto& collectionsMap = collectionShardingStateMap(opCtx->getServiceContext());
+    collectionsMap.reportHotChunks(ShardingState::get(opCtx)->getShardName(), limit, builder);
+}
+
+void CollectionShardingState::startHotChunksDecay(ServiceContext* serviceContext) {
+    auto runner = serviceContext->getPeriodicRunner();
+    invariant(runner);
+
+    PeriodicRunner::PeriodicJob job(
+        [](Client* client) {
+            collectionShardingStateMap(client->getServiceContext()).decayHotChunks();
+        },
+        Seconds(std::max(1, hotChunksDecayIntervalSecs)));
+    runner->scheduleJob(std::move(job));
+}
+
 ScopedCollectionMetadata CollectionShardingState::getMetadata() {
     return _metadataManager->getActiveMetadata(_metadataManager);
 }
@@ -360,7 +505,7 @@ void CollectionShardingState::onInsertOp(OperationContext* opCtx,
         }
 
         if (ShardingState::get(opCtx)->enabled()) {
-            _incrementChunkOnInsertOrUpdate(opCtx, insertedDoc, insertedDoc.objsize());
+            _incrementChunkOnInsertOrUpdate(opCtx, insertedDoc, insertedDoc.objsize(), boost::none);
         }
     }
 
@@ -375,6 +520,7 @@ void CollectionShardingState::onUpdateOp(OperationContext* opCtx,
                                          const BSONObj& query,
                                          const BSONObj& update,
                                          const BSONObj& updatedDoc,
+                                         int preImageDocSize,
                                          const repl::OpTime& opTime,
                                          const repl::OpTime& prePostImageOpTime) {
     dassert(opCtx->lockState()->isCollectionLockedForMode(_nss.ns(), MODE_IX));
@@ -385,7 +531,7 @@ void CollectionShardingState::onUpdateOp(OperationContext* opCtx,
         }
 
         if (ShardingState::get(opCtx)->enabled()) {
-            _incrementChunkOnInsertOrUpdate(opCtx, updatedDoc, update.objsize());
+            _incrementChunkOnInsertOrUpdate(opCtx, updatedDoc, update.objsize(), preImageDocSize);
         }
     }
 
@@ -398,7 +544,8 @@ void CollectionShardingState::onUpdateOp(OperationContext* opCtx,
 
 auto CollectionShardingState::makeDeleteState(BSONObj const& doc) -> DeleteState {
     return {getMetadata().extractDocumentKey(doc).getOwned(),
-            _sourceMgr && _sourceMgr->getCloner()->isDocumentInMigratingChunk(doc)};
+            _sourceMgr && _sourceMgr->getCloner()->isDocumentInMigratingChunk(doc),
+            doc.objsize()};
 }
 
 void CollectionShardingState::onDeleteOp(OperationContext* opCtx,
@@ -427,6 +574,10 @@ void CollectionShardingState::onDeleteOp(OperationContext* opCtx,
                 }
             }
         }
+
+        if (ShardingState::get(opCtx)->enabled()) {
+            _decrementChunkOnDelete(opCtx, deleteState);
+        }
     }
 
     if (serverGlobalParams.clusterRole == ClusterRole::ConfigServer) {
@@ -633,9 +784,11 @@ bool CollectionShardingState::_checkShardVersionOk(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
-uint64_t CollectionShardingState::_incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
-                                                                  const BSONObj& document,
-                                                                  long dataWritten) {
+uint64_t CollectionShardingState::_incrementChunkOnInsertOrUpdate(
+    OperationContext* opCtx,
+    const BSONObj& document,
+    long dataWritten,
+    boost::optional<int> preImageDocSize) {
 
     // Here, get the collection metadata and check if it exists. If it doesn't exist, then the
     // collection is not sharded, and we can simply return -1.
@@ -662,17 +815,56 @@ uint64_t CollectionShardingState::_incrementChunkOnInsertOrUpdate(OperationConte
     // shard keys do not support non-simple collations.
     auto chunk = cm->findIntersectingChunkWithSimpleCollation(shardKey);
     chunk->addBytesWritten(dataWritten);
+    if (chunk->addWriteOp() == 1) {
+        collectionShardingStateMap(opCtx->getServiceContext()).noteChunkWritten(_nss.ns(), chunk);
+    }
+
+    // The tracked size of the chunk is only seeded once, so it must not count writes which end up
+    // rolled back, such as write conflict retries or failed applyOps
+    if (preImageDocSize) {
+        const int sizeDelta = document.objsize() - *preImageDocSize;
+        opCtx->recoveryUnit()->onCommit([chunk, sizeDelta] { chunk->recordUpdate(sizeDelta); });
+    } else {
+        const int docSize = document.objsize();
+        opCtx->recoveryUnit()->onCommit([ chunk, shardKey = shardKey.getOwned(), docSize ] {
+            chunk->recordInsert(shardKey, docSize);
+        });
+    }
 
     // If the chunk becomes too large, then we call the ChunkSplitter to schedule a split. Then, we
     // reset the tracking for that chunk to 0.
     if (_shouldSplitChunk(opCtx, shardKeyPattern, *chunk)) {
-        // TODO: call ChunkSplitter here
+        if (shardAutoSplitEnabled.load()) {
+            ShardingState::get(opCtx)->getChunkSplitter()->trySplitting(
+                _nss, chunk->getMin(), chunk->getMax(), chunk->getBytesWritten());
+        }
+
         chunk->clearBytesWritten();
     }
 
     return chunk->getBytesWritten();
 }
 
+void CollectionShardingState::_decrementChunkOnDelete(OperationContext* opCtx,
+                                                      const DeleteState& deleteState) {
+    ScopedCollectionMetadata metadata = getMetadata();
+    if (!metadata) {
+        return;
+    }
+
+    std::shared_ptr<ChunkManager> cm = metadata->getChunkManager();
+
+    // The document key contains the shard key fields, because the collection is sharded
+    BSONObj shardKey = cm->getShardKeyPattern().extractShardKeyFromDoc(deleteState.documentKey);
+    if (shardKey.isEmpty()) {
+        return;
+    }
+
+    auto chunk = cm->findIntersectingChunkWithSimpleCollation(shardKey);
+    const int docSize = deleteState.docSize;
+    opCtx->recoveryUnit()->onCommit([chunk, docSize] { chunk->recordDelete(docSize); });
+}
+
 bool CollectionShardingState::_shouldSplitChunk(OperationContext* opCtx,
                                                 const ShardKeyPattern& shardKeyPattern,
                                                 const Chunk& chunk) {
@@ -79,6 +79,9 @@ public:
         // is being migrated out. (Not to be confused with "fromMigrate", which tags operations
         // that are steps in performing the migration.)
         bool isMigrating;
+
+        // Size of the document being deleted, which is subtracted from the tracked chunk size
+        int docSize{0};
     };
 
     DeleteState makeDeleteState(BSONObj const& doc);
@@ -95,6 +98,22 @@ public:
 
     static void report(OperationContext* opCtx, BSONObjBuilder* builder);
 
+    /**
+     * Appends the total number of writes tracked against the chunks owned by this shard and the
+     * 'limit' chunks with the most writes, across all sharded collections, in decreasing order of
+     * writes. Used by the balancer to find the chunks which carry the load of a shard.
+     *
+     * Does not change the write counts, so it may be called any number of times.
+     */
+    static void reportHotChunks(OperationContext* opCtx, size_t limit, BSONObjBuilder* builder);
+
+    /**
+     * Schedules a job on the periodic runner of 'serviceContext', which halves the write counts
+     * of the chunks every 'hotChunksDecayIntervalSecs', so that the reports weigh recent writes
+     * over older ones.
+     */
+    static void startHotChunksDecay(ServiceContext* serviceContext);
+
     /**
      * Returns the chunk metadata for the collection. The metadata it represents lives as long as
      * the object itself, and the collection, exist. After dropping the collection lock, the
@@ -232,6 +251,7 @@ public:
                     const BSONObj& query,
                     const BSONObj& update,
                     const BSONObj& updatedDoc,
+                    int preImageDocSize,
                     const repl::OpTime& opTime,
                     const repl::OpTime& prePostImageOpTime);
     void onDeleteOp(OperationContext* opCtx,
@@ -305,10 +325,20 @@ private:
      * If the collection is sharded, finds the chunk that contains the specified document, and
      * increments the size tracked for that chunk by the specified amount of data written, in
      * bytes. Returns the number of total bytes on that chunk, after the data is written.
+     *
+     * 'preImageDocSize' is the size of the document before an update and boost::none for inserts.
+     * The chunk's tracked data size and shard key sample only change once the write commits.
      */
     uint64_t _incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
                                              const BSONObj& document,
-                                             long dataWritten);
+                                             long dataWritten,
+                                             boost::optional<int> preImageDocSize);
+
+    /**
+     * Subtracts the size of a deleted document from the size tracked for the chunk it belonged to,
+     * once the delete commits.
+     */
+    void _decrementChunkOnDelete(OperationContext* opCtx, const DeleteState& deleteState);
 
     /**
      * Returns true if the total number of bytes on the specified chunk nears the max size of
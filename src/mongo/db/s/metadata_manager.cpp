@@ -133,6 +133,7 @@ void scheduleCleanup(executor::TaskExecutor* executor,
             Client::initThreadIfNotAlready("Collection Range Deleter");
             auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
             auto opCtx = uniqueOpCtx.get();
+            opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kLow);
 
             const int maxToDelete = std::max(int(internalQueryExecYieldIterations.load()), 1);
 
@@ -41,7 +41,9 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/s/migration_throttle.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/write_concern.h"
 
 /**
@@ -52,8 +54,8 @@ namespace {
 
 /**
  * Shortcut class to perform the appropriate checks and acquire the cloner associated with the
- * currently active migration. Uses the currently registered migration for this shard and ensures
- * the session ids match.
+ * currently active migration. Since a shard can donate chunks of several collections concurrently,
+ * looks through the currently registered migrations for the one with a matching session id.
  */
 class AutoGetActiveCloner {
     MONGO_DISALLOW_COPYING(AutoGetActiveCloner);
@@ -62,32 +64,42 @@ public:
     AutoGetActiveCloner(OperationContext* opCtx, const MigrationSessionId& migrationSessionId) {
         ShardingState* const gss = ShardingState::get(opCtx);
 
-        const auto nss = gss->getActiveDonateChunkNss();
-        uassert(ErrorCodes::NotYetInitialized, "No active migrations were found", nss);
+        const auto namespaces = gss->getActiveDonateChunkNamespaces();
+        uassert(
+            ErrorCodes::NotYetInitialized, "No active migrations were found", !namespaces.empty());
 
-        // Once the collection is locked, the migration status cannot change
-        _autoColl.emplace(opCtx, *nss, MODE_IS);
+        for (const auto& nss : namespaces) {
+            // Once the collection is locked, the migration status cannot change
+            _autoColl.emplace(opCtx, nss, MODE_IS);
 
-        uassert(ErrorCodes::NamespaceNotFound,
-                str::stream() << "Collection " << nss->ns() << " does not exist",
-                _autoColl->getCollection());
+            if (!_autoColl->getCollection()) {
+                _autoColl.reset();
+                continue;
+            }
 
-        auto css = CollectionShardingState::get(opCtx, *nss);
-        uassert(ErrorCodes::IllegalOperation,
-                str::stream() << "No active migrations were found for collection " << nss->ns(),
-                css->getMigrationSourceManager());
+            auto css = CollectionShardingState::get(opCtx, nss);
+            if (!css->getMigrationSourceManager()) {
+                _autoColl.reset();
+                continue;
+            }
 
-        // It is now safe to access the cloner
-        _chunkCloner = dynamic_cast<MigrationChunkClonerSourceLegacy*>(
-            css->getMigrationSourceManager()->getCloner());
-        invariant(_chunkCloner);
+            // It is now safe to access the cloner
+            auto chunkCloner = dynamic_cast<MigrationChunkClonerSourceLegacy*>(
+                css->getMigrationSourceManager()->getCloner());
+            invariant(chunkCloner);
+
+            if (migrationSessionId.matches(chunkCloner->getSessionId())) {
+                _chunkCloner = chunkCloner;
+                return;
+            }
 
-        // Ensure the session ids are correct
-        uassert(ErrorCodes::IllegalOperation,
-                str::stream() << "Requested migration session id " << migrationSessionId.toString()
-                              << " does not match active session id "
-                              << _chunkCloner->getSessionId().toString(),
-                migrationSessionId.matches(_chunkCloner->getSessionId()));
+            _autoColl.reset();
+        }
+
+        uasserted(ErrorCodes::IllegalOperation,
+                  str::stream() << "Requested migration session id "
+                                << migrationSessionId.toString()
+                                << " does not match any active migration session id");
     }
 
     Database* getDb() const {
@@ -110,7 +122,7 @@ private:
     boost::optional<AutoGetCollection> _autoColl;
 
     // Contains the active cloner for the namespace
-    MigrationChunkClonerSourceLegacy* _chunkCloner;
+    MigrationChunkClonerSourceLegacy* _chunkCloner{nullptr};
 };
 
 class InitialCloneCommand : public BasicCommand {
@@ -168,6 +180,15 @@ public:
         }
 
         invariant(arrBuilder);
+
+        auto& stats = ShardingStatistics::get(opCtx);
+        stats.countDocsClonedOnDonor.addAndFetch(arrBuilder->arrSize());
+        stats.countBytesClonedOnDonor.addAndFetch(arrBuilder->len());
+
+        // The collection lock has been released at this point, so waiting for the bandwidth budget
+        // does not block any other operations
+        MigrationThrottle::get(opCtx).throttle(opCtx, arrBuilder->len());
+
         result.appendArray("objects", arrBuilder->arr());
 
         return true;
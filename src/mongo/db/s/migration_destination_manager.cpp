@@ -49,9 +49,11 @@
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/migration_throttle.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/move_timing_helper.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/client/shard_registry.h"
@@ -327,6 +329,9 @@ Status MigrationDestinationManager::start(const NamespaceString& nss,
     _sessionId = sessionId;
     _scopedRegisterReceiveChunk = std::move(scopedRegisterReceiveChunk);
 
+    ShardingStatistics::get(getGlobalServiceContext())
+        .countRecipientMoveChunkStarted.addAndFetch(1);
+
     // TODO: If we are here, the migrate thread must have completed, otherwise _active above
     // would be false, so this would never block. There is no better place with the current
     // implementation where to join the thread.
@@ -426,6 +431,7 @@ void MigrationDestinationManager::_migrateThread(BSONObj min,
                                                  WriteConcernOptions writeConcern) {
     Client::initThread("migrateThread");
     auto opCtx = Client::getCurrent()->makeOperationContext();
+    opCtx->lockState()->setAdmissionPriority(Locker::AdmissionPriority::kLow);
 
 
     if (getGlobalAuthorizationManager()->isAuthEnabled()) {
@@ -765,6 +771,12 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
 
             if (thisTime == 0)
                 break;
+
+            auto& stats = ShardingStatistics::get(opCtx);
+            stats.countDocsClonedOnRecipient.addAndFetch(thisTime);
+            stats.countBytesClonedOnRecipient.addAndFetch(arr.objsize());
+
+            MigrationThrottle::get(opCtx).throttle(opCtx, arr.objsize());
         }
 
         timing.done(3);
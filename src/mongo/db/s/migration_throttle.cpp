@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/migration_throttle.h"
+
+#include <algorithm>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/s/sharding_statistics.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+MONGO_EXPORT_SERVER_PARAMETER(migrationMaxBytesPerSecond, long long, 0);
+
+const auto getMigrationThrottle = ServiceContext::declareDecoration<MigrationThrottle>();
+
+}  // namespace
+
+MigrationThrottle& MigrationThrottle::get(ServiceContext* serviceContext) {
+    return getMigrationThrottle(serviceContext);
+}
+
+MigrationThrottle& MigrationThrottle::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void MigrationThrottle::throttle(OperationContext* opCtx, long long bytes) {
+    const long long maxBytesPerSecond = migrationMaxBytesPerSecond.load();
+    if (maxBytesPerSecond <= 0) {
+        return;
+    }
+
+    const Microseconds now = duration_cast<Microseconds>(Date_t::now().toDurationSinceEpoch());
+    Microseconds waitUntil;
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+        // Unused budget does not accumulate while there are no migrations, otherwise a number of
+        // migrations starting at the same time could exceed it
+        waitUntil = std::max(_budgetConsumedUntil, now);
+
+        // Accounted in microseconds, so that the batches which take less than a millisecond of
+        // budget still add up
+        _budgetConsumedUntil = waitUntil + Microseconds(bytes * 1000 * 1000 / maxBytesPerSecond);
+    }
+
+    // Sleeps have millisecond granularity, so waits shorter than that are carried over to the
+    // next transfer through the consumed budget instead
+    const Milliseconds waitFor = duration_cast<Milliseconds>(waitUntil - now);
+    if (waitFor <= Milliseconds(0)) {
+        return;
+    }
+
+    ShardingStatistics::get(opCtx).totalMigrationThrottledTimeMillis.addAndFetch(
+        durationCount<Milliseconds>(waitFor));
+
+    opCtx->sleepFor(waitFor);
+}
+
+}  // namespace mongo
@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Enforces a per-process bandwidth budget on the documents transferred by chunk migrations. The
+ * budget is shared between all migrations, which this node is donating or receiving, and is
+ * controlled through the 'migrationMaxBytesPerSecond' server parameter (0 means unlimited).
+ */
+class MigrationThrottle {
+    MONGO_DISALLOW_COPYING(MigrationThrottle);
+
+public:
+    MigrationThrottle() = default;
+
+    /**
+     * Obtains the per-process instance of the migration throttle.
+     */
+    static MigrationThrottle& get(ServiceContext* serviceContext);
+    static MigrationThrottle& get(OperationContext* opCtx);
+
+    /**
+     * Accounts for 'bytes' worth of migration data, which have just been transferred, and blocks
+     * until the budget consumed by the previous transfers has been replenished. Throws if the
+     * operation is interrupted while waiting.
+     */
+    void throttle(OperationContext* opCtx, long long bytes);
+
+private:
+    // Protects the state below
+    stdx::mutex _mutex;
+
+    // The point in time, as a duration since the epoch, until which the bandwidth budget has
+    // already been consumed
+    Microseconds _budgetConsumedUntil{0};
+};
+
+}  // namespace mongo
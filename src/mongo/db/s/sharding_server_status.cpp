@@ -30,6 +30,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/server_options.h"
@@ -76,12 +77,19 @@ public:
             grid->getBalancerConfiguration()->getMaxChunkSizeBytes();
         result.append("maxChunkSizeInBytes", maxChunkSizeInBytes);
 
-        // Get a migration status report if a migration is active for which this is the source
-        // shard. ShardingState::getActiveMigrationStatusReport will take an IS lock on the
-        // namespace of the active migration if there is one that is active.
-        BSONObj migrationStatus = shardingState->getActiveMigrationStatusReport(opCtx);
-        if (!migrationStatus.isEmpty()) {
-            result.append("migrations", migrationStatus);
+        // Get a migration status report for each active migration for which this is the source
+        // shard. ShardingState::getActiveMigrationStatusReports will take an IS lock on the
+        // namespace of each active migration.
+        const auto migrationStatuses = shardingState->getActiveMigrationStatusReports(opCtx);
+        if (!migrationStatuses.empty()) {
+            // Kept as a single report for compatibility, listing all of them below
+            result.append("migrations", migrationStatuses.front());
+
+            BSONArrayBuilder activeMigrationsB(result.subarrayStart("activeMigrations"));
+            for (const auto& migrationStatus : migrationStatuses) {
+                activeMigrationsB.append(migrationStatus);
+            }
+            activeMigrationsB.doneFast();
         }
 
         return result.obj();
@@ -117,5 +125,35 @@ public:
 
 } shardingStatisticsServerStatus;
 
+class HotChunksServerStatus final : public ServerStatusSection {
+public:
+    HotChunksServerStatus() : ServerStatusSection("hotChunks") {}
+
+    bool includeByDefault() const override {
+        // Only reported when asked for, which the balancer does on every round
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        if (serverGlobalParams.clusterRole != ClusterRole::ShardServer)
+            return {};
+
+        auto const shardingState = ShardingState::get(opCtx);
+        if (!shardingState->enabled())
+            return {};
+
+        BSONObjBuilder result;
+        CollectionShardingState::reportHotChunks(opCtx, kMaxHotChunksReported, &result);
+        return result.obj();
+    }
+
+private:
+    // Maximum number of chunks to report, which bounds the size of the section regardless of the
+    // number of chunks owned by the shard
+    static constexpr size_t kMaxHotChunksReported = 50;
+
+} hotChunksServerStatus;
+
 }  // namespace
 }  // namespace mongo
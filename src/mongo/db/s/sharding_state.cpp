@@ -529,12 +529,12 @@ StatusWith<ScopedRegisterReceiveChunk> ShardingState::registerReceiveChunk(
     return _activeMigrationsRegistry.registerReceiveChunk(nss, chunkRange, fromShardId);
 }
 
-boost::optional<NamespaceString> ShardingState::getActiveDonateChunkNss() {
-    return _activeMigrationsRegistry.getActiveDonateChunkNss();
+std::vector<NamespaceString> ShardingState::getActiveDonateChunkNamespaces() {
+    return _activeMigrationsRegistry.getActiveDonateChunkNamespaces();
 }
 
-BSONObj ShardingState::getActiveMigrationStatusReport(OperationContext* opCtx) {
-    return _activeMigrationsRegistry.getActiveMigrationStatusReport(opCtx);
+std::vector<BSONObj> ShardingState::getActiveMigrationStatusReports(OperationContext* opCtx) {
+    return _activeMigrationsRegistry.getActiveMigrationStatusReports(opCtx);
 }
 
 void ShardingState::appendInfo(OperationContext* opCtx, BSONObjBuilder& builder) {
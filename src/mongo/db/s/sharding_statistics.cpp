@@ -57,6 +57,14 @@ void ShardingStatistics::report(BSONObjBuilder* builder) const {
     builder->append("totalCriticalSectionCommitTimeMillis",
                     totalCriticalSectionCommitTimeMillis.load());
     builder->append("totalCriticalSectionTimeMillis", totalCriticalSectionTimeMillis.load());
+    builder->append("countDocsClonedOnDonor", countDocsClonedOnDonor.load());
+    builder->append("countBytesClonedOnDonor", countBytesClonedOnDonor.load());
+
+    builder->append("countRecipientMoveChunkStarted", countRecipientMoveChunkStarted.load());
+    builder->append("countDocsClonedOnRecipient", countDocsClonedOnRecipient.load());
+    builder->append("countBytesClonedOnRecipient", countBytesClonedOnRecipient.load());
+
+    builder->append("totalMigrationThrottledTimeMillis", totalMigrationThrottledTimeMillis.load());
 }
 
 }  // namespace mongo
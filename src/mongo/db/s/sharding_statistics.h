@@ -70,6 +70,24 @@ struct ShardingStatistics {
     // from the donor to the recipient).
     AtomicInt64 totalCriticalSectionTimeMillis{0};
 
+    // Cumulative, always-increasing counters of how many documents and bytes this node has sent
+    // to recipient shards during the clone phase of the migrations it donated
+    AtomicInt64 countDocsClonedOnDonor{0};
+    AtomicInt64 countBytesClonedOnDonor{0};
+
+    // Cumulative, always-increasing counter of how many chunks did this node start receiving
+    // (whether they succeeded or not)
+    AtomicInt64 countRecipientMoveChunkStarted{0};
+
+    // Cumulative, always-increasing counters of how many documents and bytes this node has cloned
+    // from donor shards during the migrations it received
+    AtomicInt64 countDocsClonedOnRecipient{0};
+    AtomicInt64 countBytesClonedOnRecipient{0};
+
+    // Cumulative, always-increasing counter of how much time migrations on this node were delayed
+    // in order to stay within the migration bandwidth budget
+    AtomicInt64 totalMigrationThrottledTimeMillis{0};
+
     /**
      * Obtains the per-process instance of the sharding statistics object.
      */
@@ -43,6 +43,8 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/platform/random.h"
+#include "mongo/s/chunk.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -277,4 +279,128 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
     return splitKeys;
 }
 
+StatusWith<ChunkDataSample> sampleChunkData(OperationContext* opCtx,
+                                            const NamespaceString& nss,
+                                            const BSONObj& keyPattern,
+                                            const BSONObj& min,
+                                            const BSONObj& max,
+                                            size_t maxSampleSize) {
+    AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+
+    Collection* const collection = autoColl.getCollection();
+    if (!collection) {
+        return {ErrorCodes::NamespaceNotFound, "ns not found"};
+    }
+
+    IndexDescriptor* idx =
+        collection->getIndexCatalog()->findShardKeyPrefixedIndex(opCtx, keyPattern, false);
+    if (idx == NULL) {
+        return {ErrorCodes::IndexNotFound,
+                "couldn't find index over splitting key " + keyPattern.clientReadable().toString()};
+    }
+
+    KeyPattern kp(idx->keyPattern());
+    const BSONObj minKey = Helpers::toKeyFormat(kp.extendRangeBound(min, false));
+    const BSONObj maxKey = Helpers::toKeyFormat(kp.extendRangeBound(max, max.isEmpty()));
+
+    const long long recCount = collection->numRecords(opCtx);
+    const long long avgRecSize = recCount ? collection->dataSize(opCtx) / recCount : 0;
+
+    ChunkDataSample sample;
+    PseudoRandom random(static_cast<int64_t>(Date_t::now().toMillisSinceEpoch()));
+
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           collection,
+                                           idx,
+                                           minKey,
+                                           maxKey,
+                                           BoundInclusion::kIncludeStartKeyOnly,
+                                           PlanExecutor::YIELD_AUTO,
+                                           InternalPlanner::FORWARD);
+
+    BSONObj currKey;
+    PlanExecutor::ExecState state;
+    while (PlanExecutor::ADVANCED == (state = exec->getNext(&currKey, NULL))) {
+        sample.numDocs++;
+
+        // Reservoir sampling, so that only the keys which end up in the sample need to be copied
+        size_t slot = sample.sampledKeys.size();
+        if (slot >= maxSampleSize) {
+            slot = random.nextInt64(sample.numDocs);
+            if (slot >= maxSampleSize)
+                continue;
+        }
+
+        BSONObj shardKey = dotted_path_support::extractElementsBasedOnTemplate(
+            prettyKey(idx->keyPattern(), currKey.getOwned()), keyPattern);
+
+        if (slot == sample.sampledKeys.size()) {
+            sample.sampledKeys.push_back(shardKey.getOwned());
+        } else {
+            sample.sampledKeys[slot] = shardKey.getOwned();
+        }
+    }
+
+    if (PlanExecutor::DEAD == state || PlanExecutor::FAILURE == state) {
+        return {ErrorCodes::OperationFailed,
+                "Executor error while sampling chunk data: " +
+                    WorkingSetCommon::toStatusString(currKey)};
+    }
+
+    sample.dataSizeBytes = sample.numDocs * avgRecSize;
+
+    return sample;
+}
+
+Status ensureChunkDataSizeTracked(OperationContext* opCtx,
+                                  const NamespaceString& nss,
+                                  const BSONObj& keyPattern,
+                                  Chunk* chunk) {
+    if (chunk->getDataSizeBytes() >= 0) {
+        return Status::OK();
+    }
+
+    auto swSample = sampleChunkData(
+        opCtx, nss, keyPattern, chunk->getMin(), chunk->getMax(), Chunk::kMaxSampledKeys);
+    if (!swSample.isOK()) {
+        return swSample.getStatus();
+    }
+
+    auto& sample = swSample.getValue();
+    chunk->setDataSize(sample.dataSizeBytes, sample.numDocs, std::move(sample.sampledKeys));
+
+    return Status::OK();
+}
+
+std::vector<BSONObj> selectSplitPointsFromSample(const std::vector<BSONObj>& sortedSampledKeys,
+                                                 const BSONObj& min,
+                                                 long long dataSizeBytes,
+                                                 long long maxChunkSizeBytes) {
+    std::vector<BSONObj> splitKeys;
+
+    const long long desiredChunkSizeBytes = maxChunkSizeBytes / 2;
+    if (sortedSampledKeys.empty() || desiredChunkSizeBytes <= 0 ||
+        dataSizeBytes <= desiredChunkSizeBytes) {
+        return splitKeys;
+    }
+
+    const size_t numChunks = std::min<long long>(
+        (dataSizeBytes + desiredChunkSizeBytes - 1) / desiredChunkSizeBytes,
+        sortedSampledKeys.size());
+
+    for (size_t i = 1; i < numChunks; i++) {
+        const BSONObj& key = sortedSampledKeys[i * sortedSampledKeys.size() / numChunks];
+
+        // Split points must be strictly inside the chunk and distinct
+        if (key.woCompare(min) <= 0)
+            continue;
+        if (!splitKeys.empty() && key.woCompare(splitKeys.back()) == 0)
+            continue;
+
+        splitKeys.push_back(key);
+    }
+
+    return splitKeys;
+}
+
 }  // namespace mongo
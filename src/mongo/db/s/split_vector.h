@@ -31,10 +31,13 @@
 #include <boost/optional.hpp>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+
 namespace mongo {
 
-class BSONObj;
+class Chunk;
 class NamespaceString;
+class Status;
 class OperationContext;
 template <typename T>
 class StatusWith;
@@ -66,4 +69,49 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              boost::optional<long long> maxChunkSize,
                                              boost::optional<long long> maxChunkSizeBytes);
 
+/**
+ * Describes the documents in a chunk's range, as established by a scan of the shard key index.
+ */
+struct ChunkDataSample {
+    // Number of documents in the chunk
+    long long numDocs{0};
+
+    // Approximate size of the chunk's documents, based on the collection's average document size
+    long long dataSizeBytes{0};
+
+    // Uniform sample of the shard keys of the chunk's documents, in no particular order
+    std::vector<BSONObj> sampledKeys;
+};
+
+/**
+ * Scans the shard key index over the range [min, max) once in order to count the documents in it
+ * and to draw a uniform sample of at most 'maxSampleSize' of their shard keys.
+ */
+StatusWith<ChunkDataSample> sampleChunkData(OperationContext* opCtx,
+                                            const NamespaceString& nss,
+                                            const BSONObj& keyPattern,
+                                            const BSONObj& min,
+                                            const BSONObj& max,
+                                            size_t maxSampleSize);
+
+/**
+ * Establishes the tracked data size and shard key sample of the specified chunk through a call to
+ * sampleChunkData, unless they have already been established.
+ */
+Status ensureChunkDataSizeTracked(OperationContext* opCtx,
+                                  const NamespaceString& nss,
+                                  const BSONObj& keyPattern,
+                                  Chunk* chunk);
+
+/**
+ * Chooses split points for a chunk with the specified lower bound, which contains 'dataSizeBytes'
+ * bytes, from an ascending sample of its shard keys, so that each of the resulting chunks contains
+ * about half of 'maxChunkSizeBytes'. Keys, which appear too often in the sample to split on, are
+ * skipped, so the result may contain fewer split points than desired or be empty.
+ */
+std::vector<BSONObj> selectSplitPointsFromSample(const std::vector<BSONObj>& sortedSampledKeys,
+                                                 const BSONObj& min,
+                                                 long long dataSizeBytes,
+                                                 long long maxChunkSizeBytes);
+
 }  // namespace mongo
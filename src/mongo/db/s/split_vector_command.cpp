@@ -30,9 +30,14 @@
 
 #include <algorithm>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/catalog_raii.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/split_vector.h"
+#include "mongo/s/chunk_manager.h"
 
 namespace mongo {
 
@@ -41,6 +46,56 @@ using std::stringstream;
 
 namespace {
 
+/**
+ * Returns true if [min, max) is the range of a chunk owned by this shard, whose size, as tracked by
+ * the write paths, shows that it is still smaller than 'maxChunkSizeBytes'. This allows requests
+ * for split points of chunks, which are not ready to be split yet, to be answered without scanning
+ * the shard key index. The size of a chunk is established through a single scan the first time it
+ * is checked.
+ */
+bool isOwnedChunkTooSmallToSplit(OperationContext* opCtx,
+                                 const NamespaceString& nss,
+                                 const BSONObj& keyPattern,
+                                 const BSONObj& min,
+                                 const BSONObj& max,
+                                 long long maxChunkSizeBytes) {
+    auto const shardingState = ShardingState::get(opCtx);
+    if (!shardingState->enabled() || min.isEmpty())
+        return false;
+
+    std::shared_ptr<Chunk> chunk;
+
+    {
+        AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+
+        auto metadata = CollectionShardingState::get(opCtx, nss)->getMetadata();
+        if (!metadata)
+            return false;
+
+        // Chunk sizes are only tracked for split points over the shard key
+        if (SimpleBSONObjComparator::kInstance.evaluate(metadata->getKeyPattern() != keyPattern))
+            return false;
+
+        // The bounds come from the request, so they may not be a valid shard key, in which case
+        // the split points are computed through a scan as before
+        try {
+            chunk = metadata->getChunkManager()->findIntersectingChunkWithSimpleCollation(min);
+        } catch (const DBException&) {
+            return false;
+        }
+    }
+
+    if (chunk->getMin().woCompare(min) || chunk->getMax().woCompare(max) ||
+        chunk->getShardId() != shardingState->getShardName()) {
+        return false;
+    }
+
+    if (!ensureChunkDataSizeTracked(opCtx, nss, keyPattern, chunk.get()).isOK())
+        return false;
+
+    return chunk->getDataSizeBytes() < maxChunkSizeBytes;
+}
+
 class SplitVector : public ErrmsgCommandDeprecated {
 public:
     SplitVector() : ErrmsgCommandDeprecated("splitVector") {}
@@ -134,6 +189,12 @@ public:
             maxChunkSizeBytes = maxSizeElem.numberLong();
         }
 
+        if (!force && !maxChunkObjects && !maxChunkSize && maxChunkSizeBytes &&
+            isOwnedChunkTooSmallToSplit(opCtx, nss, keyPattern, min, max, *maxChunkSizeBytes)) {
+            result.append("splitKeys", std::vector<BSONObj>());
+            return true;
+        }
+
         auto statusWithSplitKeys = splitVector(opCtx,
                                                nss,
                                                keyPattern,
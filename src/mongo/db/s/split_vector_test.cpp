@@ -300,5 +300,59 @@ TEST_F(SplitVectorTest, NoMaxChunkSize) {
     ASSERT_EQUALS(status.code(), ErrorCodes::InvalidOptions);
 }
 
+TEST_F(SplitVectorTest, SampleChunkDataCountsAllDocumentsInRange) {
+    auto sample = unittest::assertGet(sampleChunkData(operationContext(),
+                                                      kNss,
+                                                      BSON(kPattern << 1),
+                                                      BSON(kPattern << 20),
+                                                      BSON(kPattern << 60),
+                                                      10));
+    ASSERT_EQ(40, sample.numDocs);
+    ASSERT_EQ(10U, sample.sampledKeys.size());
+
+    for (const auto& key : sample.sampledKeys) {
+        ASSERT_GTE(key[kPattern].numberInt(), 20);
+        ASSERT_LT(key[kPattern].numberInt(), 60);
+    }
+}
+
+TEST_F(SplitVectorTest, SampleChunkDataKeepsAllKeysOfSmallChunk) {
+    auto sample = unittest::assertGet(sampleChunkData(operationContext(),
+                                                      kNss,
+                                                      BSON(kPattern << 1),
+                                                      BSON(kPattern << 0),
+                                                      BSON(kPattern << 5),
+                                                      10));
+    ASSERT_EQ(5, sample.numDocs);
+    ASSERT_EQ(5U, sample.sampledKeys.size());
+}
+
+std::vector<BSONObj> makeSampledKeys(int count) {
+    std::vector<BSONObj> keys;
+    for (int i = 0; i < count; i++) {
+        keys.push_back(BSON(kPattern << i));
+    }
+    return keys;
+}
+
+TEST(SelectSplitPointsFromSample, SplitsIntoHalvesOfMaxChunkSize) {
+    const auto splitKeys =
+        selectSplitPointsFromSample(makeSampledKeys(100), BSON(kPattern << 0), 2000, 1000);
+    ASSERT_EQ(3U, splitKeys.size());
+    ASSERT_BSONOBJ_EQ(BSON(kPattern << 25), splitKeys[0]);
+    ASSERT_BSONOBJ_EQ(BSON(kPattern << 50), splitKeys[1]);
+    ASSERT_BSONOBJ_EQ(BSON(kPattern << 75), splitKeys[2]);
+}
+
+TEST(SelectSplitPointsFromSample, NoSplitPointsForSmallChunk) {
+    ASSERT(selectSplitPointsFromSample(makeSampledKeys(100), BSON(kPattern << 0), 400, 1000)
+               .empty());
+}
+
+TEST(SelectSplitPointsFromSample, SkipsRepeatedKeys) {
+    const std::vector<BSONObj> keys(100, BSON(kPattern << 5));
+    ASSERT(selectSplitPointsFromSample(keys, BSON(kPattern << 5), 2000, 1000).empty());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -44,6 +44,7 @@
 #include "mongo/db/curop_metrics.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/deferred_response.h"
 #include "mongo/db/initialize_operation_session_info.h"
 #include "mongo/db/introspect.h"
 #include "mongo/db/jsobj.h"
@@ -63,6 +64,7 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/top.h"
@@ -82,6 +84,7 @@
 #include "mongo/util/net/message.h"
 #include "mongo/util/net/op_msg.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -91,6 +94,10 @@ MONGO_FP_DECLARE(respondWithNotPrimaryInCommandDispatch);
 namespace {
 using logger::LogComponent;
 
+// When set, commands on sessions that allow it do not hold on to a thread while they wait for
+// their write to be replicated, see DeferredWriteConcernResponse below.
+MONGO_EXPORT_SERVER_PARAMETER(deferWriteConcernWaits, bool, true);
+
 // The command names for which to check out a session.
 //
 // Note: Eval should check out a session because it defaults to running under a global write lock,
@@ -311,10 +318,11 @@ StatusWith<repl::ReadConcernArgs> _extractReadConcern(const Command* command,
     return readConcernArgs;
 }
 
-void _waitForWriteConcernAndAddToCommandResponse(OperationContext* opCtx,
-                                                 const std::string& commandName,
-                                                 const repl::OpTime& lastOpBeforeRun,
-                                                 BSONObjBuilder* commandResponseBuilder) {
+/**
+ * Returns the optime a command that has just run must wait on to satisfy its write concern.
+ */
+repl::OpTime _getLastOpForWriteConcern(OperationContext* opCtx,
+                                       const repl::OpTime& lastOpBeforeRun) {
     auto lastOpAfterRun = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
 
     // Ensures that if we tried to do a write, we wait for write concern, even if that write was
@@ -325,9 +333,25 @@ void _waitForWriteConcernAndAddToCommandResponse(OperationContext* opCtx,
         lastOpAfterRun = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
     }
 
+    return lastOpAfterRun;
+}
+
+/**
+ * Waits for 'lastOpAfterRun' to satisfy 'writeConcern' and reports the outcome in the command
+ * response. 'deferredFor' is how long the wait was already parked by a DeferredResponse, and is
+ * included in the reported wtime.
+ */
+void _waitForWriteConcernAndAddToCommandResponse(OperationContext* opCtx,
+                                                 const std::string& commandName,
+                                                 const repl::OpTime& lastOpAfterRun,
+                                                 const WriteConcernOptions& writeConcern,
+                                                 BSONObjBuilder* commandResponseBuilder,
+                                                 Milliseconds deferredFor = Milliseconds(0)) {
     WriteConcernResult res;
-    auto waitForWCStatus =
-        waitForWriteConcern(opCtx, lastOpAfterRun, opCtx->getWriteConcern(), &res);
+    auto waitForWCStatus = waitForWriteConcern(opCtx, lastOpAfterRun, writeConcern, &res);
+    if (res.wTime >= 0) {
+        res.wTime += durationCount<Milliseconds>(deferredFor);
+    }
     CommandHelpers::appendCommandWCStatus(*commandResponseBuilder, waitForWCStatus, res);
 
     // SERVER-22421: This code is to ensure error response backwards compatibility with the
@@ -389,11 +413,141 @@ LogicalTime computeOperationTime(OperationContext* opCtx,
     return operationTime;
 }
 
+/**
+ * Returns whether the replication wait for the write concern of a command that has just run can
+ * be left to a DeferredWriteConcernResponse rather than block this thread.
+ */
+bool _canDeferWriteConcernWait(OperationContext* opCtx) {
+    if (!deferWriteConcernWaits.load() || !DeferredResponse::isAllowed(opCtx->getClient()) ||
+        opCtx->getClient()->isInDirectClient()) {
+        return false;
+    }
+
+    // Linearizable reads do more blocking work after the write concern wait.
+    if (repl::ReadConcernArgs::get(opCtx).getLevel() ==
+        repl::ReadConcernLevel::kLinearizableReadConcern) {
+        return false;
+    }
+
+    auto const replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return false;
+    }
+
+    // Only waits for other members are worth parking for.
+    const auto& writeConcern = opCtx->getWriteConcern();
+    return (!writeConcern.wMode.empty() || writeConcern.wNumNodes > 1) &&
+        writeConcern.wTimeout != WriteConcernOptions::kNoWaiting;
+}
+
+/**
+ * The reply to a command that has run, but whose write has yet to be replicated as its write
+ * concern requires. Holds the reply built so far, and once the replication coordinator reports
+ * that the wait is over, redoes the usual (now non-blocking) write concern wait on a new
+ * OperationContext to add its outcome and finish the reply.
+ */
+class DeferredWriteConcernResponse final : public DeferredResponse {
+public:
+    DeferredWriteConcernResponse(OperationContext* opCtx,
+                                 rpc::Protocol protocol,
+                                 const Command* command,
+                                 const OpMsgRequest& request,
+                                 const BSONObj& partialReply,
+                                 bool commandResult,
+                                 LogicalTime startOperationTime,
+                                 const repl::OpTime& lastOpAfterRun)
+        : _serviceContext(opCtx->getServiceContext()),
+          _protocol(protocol),
+          _commandName(command->getName()),
+          _requestBody(request.body.getOwned()),
+          _partialReply(partialReply.getOwned()),
+          _commandResult(commandResult),
+          _startOperationTime(startOperationTime),
+          _readConcernLevel(repl::ReadConcernArgs::get(opCtx).getLevel()),
+          _lastOpAfterRun(lastOpAfterRun),
+          _writeConcern(opCtx->getWriteConcern()),
+          _opDeadline(opCtx->getDeadline()) {
+        // The resumed wait must not restart the wtimeout, so make it absolute.
+        if (_writeConcern.wDeadline == Date_t::max() &&
+            _writeConcern.wTimeout != WriteConcernOptions::kNoTimeout) {
+            auto clockSource = _serviceContext->getFastClockSource();
+            _writeConcern.wDeadline = clockSource->now() + clockSource->getPrecision() +
+                Milliseconds{_writeConcern.wTimeout};
+        }
+    }
+
+    void whenReady(stdx::function<void()> onReady) override {
+        _timer.reset();
+        repl::ReplicationCoordinator::get(_serviceContext)
+            ->registerReplicationWaiter(_lastOpAfterRun,
+                                        _writeConcern,
+                                        std::min(_writeConcern.wDeadline, _opDeadline),
+                                        std::move(onReady));
+    }
+
+    DbResponse finish(OperationContext* opCtx) override {
+        if (_opDeadline != Date_t::max()) {
+            opCtx->setDeadlineByDate(_opDeadline);
+        }
+
+        OpMsgRequest request;
+        request.body = _requestBody;
+
+        auto replyBuilder = rpc::makeReplyBuilder(_protocol);
+        BSONObjBuilder inPlaceReplyBob = replyBuilder->getInPlaceReplyBuilder(0);
+        inPlaceReplyBob.appendElements(_partialReply);
+
+        _waitForWriteConcernAndAddToCommandResponse(opCtx,
+                                                    _commandName,
+                                                    _lastOpAfterRun,
+                                                    _writeConcern,
+                                                    &inPlaceReplyBob,
+                                                    Milliseconds(_timer.millis()));
+
+        CommandHelpers::appendCommandStatus(inPlaceReplyBob, _commandResult);
+
+        auto operationTime = computeOperationTime(opCtx, _startOperationTime, _readConcernLevel);
+        if (operationTime != LogicalTime::kUninitialized) {
+            operationTime.appendAsOperationTime(&inPlaceReplyBob);
+        }
+
+        inPlaceReplyBob.doneFast();
+
+        BSONObjBuilder metadataBob;
+        appendReplyMetadata(opCtx, request, &metadataBob);
+        replyBuilder->setMetadata(metadataBob.done());
+
+        return DbResponse{replyBuilder->done()};
+    }
+
+private:
+    ServiceContext* const _serviceContext;
+    const rpc::Protocol _protocol;
+    const std::string _commandName;
+    const BSONObj _requestBody;
+    const BSONObj _partialReply;
+    const bool _commandResult;
+    const LogicalTime _startOperationTime;
+    const repl::ReadConcernLevel _readConcernLevel;
+    const repl::OpTime _lastOpAfterRun;
+    WriteConcernOptions _writeConcern;
+    const Date_t _opDeadline;
+
+    // Measures how long the wait was parked for.
+    Timer _timer;
+};
+
+/**
+ * Runs the command and builds its reply. If 'deferred' is not null, the command may instead
+ * leave the reply unfinished in 'replyBuilder' and return a DeferredResponse in 'deferred' that
+ * finishes it once its write concern has been satisfied.
+ */
 bool runCommandImpl(OperationContext* opCtx,
                     Command* command,
                     const OpMsgRequest& request,
                     rpc::ReplyBuilderInterface* replyBuilder,
-                    LogicalTime startOperationTime) {
+                    LogicalTime startOperationTime,
+                    std::shared_ptr<DeferredResponse>* deferred) {
     auto bytesToReserve = command->reserveBytesForReply();
 
 // SERVER-22100: In Windows DEBUG builds, the CRT heap debugging overhead, in conjunction with the
@@ -463,9 +617,13 @@ bool runCommandImpl(OperationContext* opCtx,
         const auto oldWC = opCtx->getWriteConcern();
         ON_BLOCK_EXIT([&] { opCtx->setWriteConcern(oldWC); });
         opCtx->setWriteConcern(wcResult.getValue());
-        ON_BLOCK_EXIT([&] {
+        auto waitForWriteConcernGuard = MakeGuard([&] {
             _waitForWriteConcernAndAddToCommandResponse(
-                opCtx, command->getName(), lastOpBeforeRun, &inPlaceReplyBob);
+                opCtx,
+                command->getName(),
+                _getLastOpForWriteConcern(opCtx, lastOpBeforeRun),
+                opCtx->getWriteConcern(),
+                &inPlaceReplyBob);
         });
 
         result = command->publicRun(opCtx, request, inPlaceReplyBob);
@@ -473,6 +631,20 @@ bool runCommandImpl(OperationContext* opCtx,
         // Nothing in run() should change the writeConcern.
         dassert(SimpleBSONObjComparator::kInstance.evaluate(opCtx->getWriteConcern().toBSON() ==
                                                             wcResult.getValue().toBSON()));
+
+        if (deferred && _canDeferWriteConcernWait(opCtx)) {
+            waitForWriteConcernGuard.Dismiss();
+            auto lastOpAfterRun = _getLastOpForWriteConcern(opCtx, lastOpBeforeRun);
+            *deferred = std::make_shared<DeferredWriteConcernResponse>(opCtx,
+                                                                       replyBuilder->getProtocol(),
+                                                                       command,
+                                                                       request,
+                                                                       inPlaceReplyBob.asTempObj(),
+                                                                       result,
+                                                                       startOperationTime,
+                                                                       lastOpAfterRun);
+            return result;
+        }
     }
 
     // When a linearizable read command is passed in, check to make sure we're reading
@@ -528,7 +700,8 @@ MONGO_FP_DECLARE(skipCheckingForNotMasterInCommandDispatch);
 void execCommandDatabase(OperationContext* opCtx,
                          Command* command,
                          const OpMsgRequest& request,
-                         rpc::ReplyBuilderInterface* replyBuilder) {
+                         rpc::ReplyBuilderInterface* replyBuilder,
+                         std::shared_ptr<DeferredResponse>* deferred) {
 
     auto startOperationTime = getClientOperationTime(opCtx);
     try {
@@ -715,7 +888,8 @@ void execCommandDatabase(OperationContext* opCtx,
             rpc::TrackingMetadata::get(opCtx).setIsLogged(true);
         }
 
-        retval = runCommandImpl(opCtx, command, request, replyBuilder, startOperationTime);
+        retval =
+            runCommandImpl(opCtx, command, request, replyBuilder, startOperationTime, deferred);
 
         if (!retval) {
             command->incrementCommandsFailed();
@@ -782,6 +956,11 @@ void curOpCommandSetup(OperationContext* opCtx, const OpMsgRequest& request) {
 
 DbResponse runCommands(OperationContext* opCtx, const Message& message) {
     auto replyBuilder = rpc::makeReplyBuilder(rpc::protocolForMessage(message));
+
+    // Fire-and-forget commands have no reply to defer.
+    std::shared_ptr<DeferredResponse> deferred;
+    const bool canDefer = !OpMsg::isFlagSet(message, OpMsg::kMoreToCome);
+
     [&] {
         OpMsgRequest request;
         try {  // Parse.
@@ -829,7 +1008,8 @@ DbResponse runCommands(OperationContext* opCtx, const Message& message) {
                 CurOp::get(opCtx)->setLogicalOp_inlock(c->getLogicalOp());
             }
 
-            execCommandDatabase(opCtx, c, request, replyBuilder.get());
+            execCommandDatabase(
+                opCtx, c, request, replyBuilder.get(), canDefer ? &deferred : nullptr);
         } catch (const DBException& ex) {
             BSONObjBuilder metadataBob;
             appendReplyMetadataOnError(opCtx, &metadataBob);
@@ -850,6 +1030,10 @@ DbResponse runCommands(OperationContext* opCtx, const Message& message) {
         return {};  // Don't reply.
     }
 
+    if (deferred) {
+        return DbResponse{Message(), std::string(), std::move(deferred)};
+    }
+
     auto response = replyBuilder->done();
     CurOp::get(opCtx)->debug().responseLength = response.header().dataLen();
 
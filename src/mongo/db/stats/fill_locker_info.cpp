@@ -30,6 +30,7 @@
 
 #include <algorithm>
 
+#include "mongo/db/concurrency/lock_contention_tracker.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/jsobj.h"
 
@@ -68,6 +69,19 @@ void fillLockerInfo(const Locker::LockerInfo& lockerInfo, BSONObjBuilder& infoBu
     // "waitingForLock" section
     infoBuilder.append("waitingForLock", lockerInfo.waitingResource.isValid());
 
+    // With contention tracking on, also report which resource the operation is blocked on
+    if (lockerInfo.waitingResource.isValid() && LockContentionTracker::isEnabled()) {
+        const ResourceId resId = lockerInfo.waitingResource;
+        BSONObjBuilder waitingFor(infoBuilder.subobjStart("waitingForResource"));
+        waitingFor.append("type", resourceTypeName(resId.getType()));
+        const std::string name = LockContentionTracker::get().getResourceName(resId);
+        if (!name.empty()) {
+            waitingFor.append("name", name);
+        }
+        waitingFor.append("resourceId", resId.toString());
+        waitingFor.done();
+    }
+
     // "lockStats" section
     {
         BSONObjBuilder lockStats(infoBuilder.subobjStart("lockStats"));
@@ -32,6 +32,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/concurrency/lock_contention_tracker.h"
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
@@ -124,5 +125,28 @@ public:
 
 } lockStatsServerStatusSection;
 
+
+class LockContentionServerStatusSection : public ServerStatusSection {
+public:
+    LockContentionServerStatusSection() : ServerStatusSection("lockContention") {}
+
+    virtual bool includeByDefault() const {
+        return true;
+    }
+
+    virtual BSONObj generateSection(OperationContext* opCtx,
+                                    const BSONElement& configElement) const {
+        // Omitted entirely unless lockContentionTrackingEnabled is set
+        if (!LockContentionTracker::isEnabled()) {
+            return BSONObj();
+        }
+
+        BSONObjBuilder ret;
+        LockContentionTracker::get().report(getLockContentionTrackingTopN(), &ret);
+        return ret.obj();
+    }
+
+} lockContentionServerStatusSection;
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,426 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_cache_warmer.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <utility>
+
+#include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/file.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Tracks table accesses and warms the cache from the manifest at startup.
+ */
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerCacheWarmupEnabled, bool, false);
+
+/**
+ * How often, in seconds, the manifest of hot tables is rewritten.
+ */
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCacheWarmupManifestIntervalSecs, int, 300);
+
+/**
+ * The maximum number of tables recorded in the manifest.
+ */
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCacheWarmupMaxTables, int, 100);
+
+/**
+ * The rate, in megabytes per second, at which the warm-up may read from disk.
+ */
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCacheWarmupMBPerSec, int, 100);
+
+/**
+ * Cursor opens are counted with a probability of one in this many, with the weight of all of them,
+ * so that opening cursors on the hottest table does not serialize on its access shard.
+ */
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCacheWarmupAccessSampleInterval, int, 64);
+
+const int kManifestVersion = 1;
+
+// The warm-up stops once this percentage of the cache is in use, leaving the rest to the
+// workload so that warming never forces eviction.
+const uint64_t kMaxCacheFillPercent = 80;
+
+// How many bytes are read between checks of the throttle, the cache fill and shutdown.
+const uint64_t kCheckIntervalBytes = 1024 * 1024;
+
+/**
+ * Access counts are spread over several independently locked maps so that concurrent cursor
+ * opens on different tables rarely contend. Opens on the same table are sampled before they get
+ * here.
+ */
+const size_t kNumAccessShards = 16;
+
+struct AccessShard {
+    stdx::mutex mutex;
+    StringMap<uint64_t> counts;
+};
+
+AccessShard accessShards[kNumAccessShards];
+
+// Decides which cursor opens on this thread are sampled. Sampling at random rather than every Nth
+// open keeps a workload that cycles through a few tables from always sampling the same one.
+thread_local PseudoRandom accessSampler(SecureRandom::create()->nextInt64());
+
+struct WarmupStats {
+    AtomicWord<bool> running{false};
+    AtomicUInt64 tablesPlanned;
+    AtomicUInt64 tablesWarmed;
+    AtomicUInt64 bytesRead;
+    AtomicUInt64 millis;
+    AtomicWord<bool> stoppedEarly{false};
+    AtomicUInt64 manifestWrites;
+    AtomicUInt64 manifestTables;
+} warmupStats;
+
+/**
+ * Returns true if at least kMaxCacheFillPercent of the cache is in use. Errors reading the
+ * statistics are treated as a full cache, which ends the warm-up.
+ */
+bool cacheIsFull(WT_SESSION* session) {
+    auto inUse = WiredTigerUtil::getStatisticsValueAs<uint64_t>(
+        session, "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_INUSE);
+    auto max = WiredTigerUtil::getStatisticsValueAs<uint64_t>(
+        session, "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_MAX);
+    if (!inUse.isOK() || !max.isOK() || max.getValue() == 0) {
+        return true;
+    }
+    return inUse.getValue() * 100 >= max.getValue() * kMaxCacheFillPercent;
+}
+
+}  // namespace
+
+const char WiredTigerCacheWarmer::kManifestFileName[] = "WiredTigerHotTables.bson";
+
+// static
+bool WiredTigerCacheWarmer::isEnabled() {
+    return wiredTigerCacheWarmupEnabled;
+}
+
+// static
+void WiredTigerCacheWarmer::recordAccess(StringData uri) {
+    if (!wiredTigerCacheWarmupEnabled) {
+        return;
+    }
+
+    const int sampleInterval = std::max(1, wiredTigerCacheWarmupAccessSampleInterval.load());
+    if (sampleInterval > 1 && accessSampler.nextInt32(sampleInterval) != 0) {
+        return;
+    }
+
+    StringMap<uint64_t>::HashedKey key(uri);
+    AccessShard& shard = accessShards[key.hash() % kNumAccessShards];
+    stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+    shard.counts[key] += sampleInterval;
+}
+
+// static
+std::vector<std::string> WiredTigerCacheWarmer::takeHotTables(size_t maxTables) {
+    std::vector<std::pair<uint64_t, std::string>> ranked;
+    for (auto& shard : accessShards) {
+        StringMap<uint64_t> decayed;
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+        for (auto& entry : shard.counts) {
+            ranked.emplace_back(entry.second, entry.first);
+            if (entry.second / 2 > 0) {
+                decayed[entry.first] = entry.second / 2;
+            }
+        }
+        shard.counts.swap(decayed);
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+        if (lhs.first != rhs.first) {
+            return lhs.first > rhs.first;
+        }
+        return lhs.second < rhs.second;
+    });
+
+    std::vector<std::string> uris;
+    for (size_t i = 0; i < ranked.size() && i < maxTables; ++i) {
+        uris.push_back(std::move(ranked[i].second));
+    }
+    return uris;
+}
+
+// static
+Status WiredTigerCacheWarmer::writeManifest(const std::string& dbpath,
+                                            const std::vector<std::string>& uris) {
+    BSONObjBuilder builder;
+    builder.append("version", kManifestVersion);
+    builder.append("tables", uris);
+    BSONObj obj = builder.obj();
+
+    boost::filesystem::path manifestPath = boost::filesystem::path(dbpath) / kManifestFileName;
+    boost::filesystem::path tempPath = manifestPath;
+    tempPath += ".tmp";
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        if (!ofs) {
+            return Status(ErrorCodes::FileNotOpen,
+                          str::stream() << "Failed to write cache warm-up manifest to "
+                                        << tempPath.string()
+                                        << ": "
+                                        << errnoWithDescription());
+        }
+        ofs.write(obj.objdata(), obj.objsize());
+        if (!ofs) {
+            return Status(ErrorCodes::OperationFailed,
+                          str::stream() << "Failed to write cache warm-up manifest to "
+                                        << tempPath.string()
+                                        << ": "
+                                        << errnoWithDescription());
+        }
+    }
+
+    // The manifest is only a hint, so a crash that loses the rename merely costs a cold start.
+    // The temporary file is still synced so the rename never exposes a partially written one.
+    try {
+        File file;
+        file.open(tempPath.string().c_str(), /*read-only*/ false, /*direct-io*/ false);
+        if (!file.is_open()) {
+            return Status(ErrorCodes::FileRenameFailed,
+                          str::stream() << "Failed to fsync " << tempPath.string());
+        }
+        file.fsync();
+        boost::filesystem::rename(tempPath, manifestPath);
+    } catch (const std::exception& ex) {
+        return Status(ErrorCodes::FileRenameFailed,
+                      str::stream() << "Unexpected error while renaming " << tempPath.string()
+                                    << " to "
+                                    << manifestPath.string()
+                                    << ": "
+                                    << ex.what());
+    }
+
+    warmupStats.manifestWrites.fetchAndAdd(1);
+    warmupStats.manifestTables.store(uris.size());
+    return Status::OK();
+}
+
+// static
+StatusWith<std::vector<std::string>> WiredTigerCacheWarmer::readManifest(
+    const std::string& dbpath) {
+    boost::filesystem::path manifestPath = boost::filesystem::path(dbpath) / kManifestFileName;
+    if (!boost::filesystem::exists(manifestPath)) {
+        return Status(ErrorCodes::NonExistentPath,
+                      str::stream() << "No cache warm-up manifest at " << manifestPath.string());
+    }
+
+    std::vector<char> buffer;
+    try {
+        boost::uintmax_t fileSize = boost::filesystem::file_size(manifestPath);
+        if (fileSize < static_cast<boost::uintmax_t>(BSONObj::kMinBSONLength) ||
+            fileSize > static_cast<boost::uintmax_t>(BSONObjMaxUserSize)) {
+            return Status(ErrorCodes::FailedToParse,
+                          str::stream() << "Cache warm-up manifest " << manifestPath.string()
+                                        << " has an invalid size of "
+                                        << fileSize);
+        }
+        buffer.resize(fileSize);
+
+        std::ifstream ifs(manifestPath.c_str(), std::ios_base::in | std::ios_base::binary);
+        ifs.read(&buffer[0], buffer.size());
+        if (!ifs) {
+            return Status(ErrorCodes::FileStreamFailed,
+                          str::stream() << "Unable to read cache warm-up manifest "
+                                        << manifestPath.string());
+        }
+    } catch (const std::exception& ex) {
+        return Status(ErrorCodes::FileStreamFailed,
+                      str::stream() << "Unexpected error reading cache warm-up manifest "
+                                    << manifestPath.string()
+                                    << ": "
+                                    << ex.what());
+    }
+
+    BSONObj obj(&buffer[0]);
+    if (static_cast<size_t>(obj.objsize()) != buffer.size()) {
+        return Status(ErrorCodes::FailedToParse,
+                      str::stream() << "Cache warm-up manifest " << manifestPath.string()
+                                    << " is corrupt");
+    }
+
+    if (obj["version"].numberInt() != kManifestVersion || obj["tables"].type() != Array) {
+        return Status(ErrorCodes::FailedToParse,
+                      str::stream() << "Unrecognized cache warm-up manifest " << obj);
+    }
+
+    std::vector<std::string> uris;
+    for (auto&& elem : obj["tables"].Obj()) {
+        if (elem.type() != String) {
+            return Status(ErrorCodes::FailedToParse,
+                          str::stream() << "Unrecognized cache warm-up manifest " << obj);
+        }
+        uris.push_back(elem.String());
+    }
+    return std::move(uris);
+}
+
+// static
+void WiredTigerCacheWarmer::warm(WT_CONNECTION* conn,
+                                 const std::vector<std::string>& uris,
+                                 stdx::function<bool()> shouldStop) {
+    WT_SESSION* session;
+    // Nothing read here needs a consistent snapshot, and read-uncommitted keeps the warm-up
+    // from pinning history in the cache.
+    int ret = conn->open_session(conn, nullptr, "isolation=read-uncommitted", &session);
+    if (ret != 0) {
+        warning() << "Unable to open a session to warm the WiredTiger cache: "
+                  << wiredtiger_strerror(ret);
+        return;
+    }
+    ON_BLOCK_EXIT([&] { session->close(session, nullptr); });
+
+    warmupStats.running.store(true);
+    warmupStats.tablesPlanned.store(uris.size());
+    ON_BLOCK_EXIT([&] { warmupStats.running.store(false); });
+
+    const uint64_t bytesPerSec =
+        static_cast<uint64_t>(std::max(1, wiredTigerCacheWarmupMBPerSec.load())) * 1024 * 1024;
+    Timer timer;
+    uint64_t bytesRead = 0;
+    uint64_t bytesSinceCheck = 0;
+    bool stoppedEarly = false;
+
+    // Returns true if the warm-up should end. Otherwise sleeps for as long as it takes to bring
+    // the read rate back under the limit.
+    auto throttle = [&]() -> bool {
+        warmupStats.bytesRead.fetchAndAdd(bytesSinceCheck);
+        bytesSinceCheck = 0;
+        if (shouldStop() || cacheIsFull(session)) {
+            return true;
+        }
+        const uint64_t targetMicros = bytesRead * 1000 * 1000 / bytesPerSec;
+        const uint64_t elapsedMicros = timer.micros();
+        if (targetMicros > elapsedMicros) {
+            sleepmicros(targetMicros - elapsedMicros);
+        }
+        return false;
+    };
+
+    for (const auto& uri : uris) {
+        if (throttle()) {
+            stoppedEarly = true;
+            break;
+        }
+
+        WT_CURSOR* cursor;
+        ret = session->open_cursor(session, uri.c_str(), nullptr, "raw", &cursor);
+        if (ret == ENOENT) {
+            // The table was dropped since the manifest was written.
+            continue;
+        }
+        if (ret != 0) {
+            LOG(1) << "Skipping " << uri << " during cache warm-up: " << wiredtiger_strerror(ret);
+            continue;
+        }
+        ON_BLOCK_EXIT([&] { cursor->close(cursor); });
+
+        // Walk backwards, so that if the warm-up stops part way through a table the most
+        // recently inserted records, which are typically the hottest, are the ones in cache.
+        while ((ret = cursor->prev(cursor)) == 0) {
+            WT_ITEM key;
+            WT_ITEM value;
+            if (cursor->get_key(cursor, &key) != 0 || cursor->get_value(cursor, &value) != 0) {
+                break;
+            }
+            bytesRead += key.size + value.size;
+            bytesSinceCheck += key.size + value.size;
+            if (bytesSinceCheck >= kCheckIntervalBytes && throttle()) {
+                stoppedEarly = true;
+                break;
+            }
+        }
+        if (stoppedEarly) {
+            break;
+        }
+        warmupStats.tablesWarmed.fetchAndAdd(1);
+    }
+
+    warmupStats.bytesRead.fetchAndAdd(bytesSinceCheck);
+    warmupStats.millis.store(timer.millis());
+    warmupStats.stoppedEarly.store(stoppedEarly);
+    log() << "Cache warm-up read " << bytesRead << " bytes from "
+          << warmupStats.tablesWarmed.load() << " of " << uris.size() << " tables in "
+          << timer.millis() << "ms" << (stoppedEarly ? ", stopping early" : "");
+}
+
+// static
+void WiredTigerCacheWarmer::appendStats(BSONObjBuilder* builder) {
+    builder->appendBool("enabled", wiredTigerCacheWarmupEnabled);
+    builder->appendBool("running", warmupStats.running.load());
+    builder->append("tablesPlanned", static_cast<long long>(warmupStats.tablesPlanned.load()));
+    builder->append("tablesWarmed", static_cast<long long>(warmupStats.tablesWarmed.load()));
+    builder->append("bytesRead", static_cast<long long>(warmupStats.bytesRead.load()));
+    builder->append("millis", static_cast<long long>(warmupStats.millis.load()));
+    builder->appendBool("stoppedEarly", warmupStats.stoppedEarly.load());
+    builder->append("manifestWrites", static_cast<long long>(warmupStats.manifestWrites.load()));
+    builder->append("manifestTables", static_cast<long long>(warmupStats.manifestTables.load()));
+}
+
+// static
+int WiredTigerCacheWarmer::getManifestIntervalSecs() {
+    return std::max(1, wiredTigerCacheWarmupManifestIntervalSecs.load());
+}
+
+// static
+int WiredTigerCacheWarmer::getMaxManifestTables() {
+    return std::max(0, wiredTigerCacheWarmupMaxTables.load());
+}
+
+// static
+void WiredTigerCacheWarmer::resetForTest() {
+    for (auto& shard : accessShards) {
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+        shard.counts.clear();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <wiredtiger.h>
+
+#include "mongo/base/status.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/functional.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Shortens the cold-cache period after a restart. While 'wiredTigerCacheWarmupEnabled' is set,
+ * the tables that operations open cursors on are counted. The engine periodically persists the
+ * hottest ones to a manifest in the dbpath, and at startup reads them back into the WiredTiger
+ * cache with a background cursor, throttled to 'wiredTigerCacheWarmupMBPerSec' and stopping
+ * before the warm-up would cause eviction.
+ */
+class WiredTigerCacheWarmer {
+public:
+    static const char kManifestFileName[];
+
+    /**
+     * Returns whether access tracking and cache warm-up are enabled.
+     */
+    static bool isEnabled();
+
+    /**
+     * Notes that an operation opened a cursor on 'uri'. Cheap when tracking is disabled, and only
+     * a random one in 'wiredTigerCacheWarmupAccessSampleInterval' calls takes a lock.
+     */
+    static void recordAccess(StringData uri);
+
+    /**
+     * Returns up to 'maxTables' of the tables accessed most, hottest first, and halves every
+     * access count so that the ranking follows changes in the workload.
+     */
+    static std::vector<std::string> takeHotTables(size_t maxTables);
+
+    /**
+     * Writes the manifest of 'uris' to 'dbpath', replacing the previous one.
+     */
+    static Status writeManifest(const std::string& dbpath, const std::vector<std::string>& uris);
+
+    /**
+     * Reads the manifest from 'dbpath'. Returns NonExistentPath if there is none.
+     */
+    static StatusWith<std::vector<std::string>> readManifest(const std::string& dbpath);
+
+    /**
+     * Reads the tables in 'uris', in order, into the cache of 'conn'. Tables that no longer exist
+     * are skipped. Stops early once the cache is 80% full, or when 'shouldStop' returns true.
+     */
+    static void warm(WT_CONNECTION* conn,
+                     const std::vector<std::string>& uris,
+                     stdx::function<bool()> shouldStop);
+
+    /**
+     * Appends the warm-up and manifest counters.
+     */
+    static void appendStats(BSONObjBuilder* builder);
+
+    /**
+     * Returns how often, in seconds, the engine should persist the manifest.
+     */
+    static int getManifestIntervalSecs();
+
+    /**
+     * Returns the maximum number of tables the manifest should contain.
+     */
+    static int getMaxManifestTables();
+
+    /**
+     * Clears the access counts. For testing.
+     */
+    static void resetForTest();
+};
+
+}  // namespace mongo
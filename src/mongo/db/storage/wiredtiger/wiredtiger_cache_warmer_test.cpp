@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_cache_warmer.h"
+
+#include <boost/filesystem.hpp>
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerCacheWarmerTest : public unittest::Test {
+public:
+    void setUp() override {
+        setParameter("wiredTigerCacheWarmupEnabled", "true");
+        setParameter("wiredTigerCacheWarmupAccessSampleInterval", "1");
+        WiredTigerCacheWarmer::resetForTest();
+    }
+
+    void tearDown() override {
+        WiredTigerCacheWarmer::resetForTest();
+        setParameter("wiredTigerCacheWarmupAccessSampleInterval", "64");
+        setParameter("wiredTigerCacheWarmupEnabled", "false");
+    }
+
+protected:
+    void setParameter(const std::string& name, const std::string& value) {
+        auto param = ServerParameterSet::getGlobal()->getMap().find(name);
+        ASSERT(param != ServerParameterSet::getGlobal()->getMap().end());
+        ASSERT_OK(param->second->setFromString(value));
+    }
+};
+
+TEST_F(WiredTigerCacheWarmerTest, HotTablesAreRankedByAccessCount) {
+    for (int i = 0; i < 3; ++i) {
+        WiredTigerCacheWarmer::recordAccess("table:warm");
+    }
+    for (int i = 0; i < 5; ++i) {
+        WiredTigerCacheWarmer::recordAccess("table:hot");
+    }
+    WiredTigerCacheWarmer::recordAccess("table:cold");
+
+    std::vector<std::string> expected{"table:hot", "table:warm"};
+    ASSERT(WiredTigerCacheWarmer::takeHotTables(2) == expected);
+}
+
+TEST_F(WiredTigerCacheWarmerTest, TakingHotTablesDecaysCounts) {
+    for (int i = 0; i < 8; ++i) {
+        WiredTigerCacheWarmer::recordAccess("table:formerlyHot");
+    }
+    ASSERT_EQ(1U, WiredTigerCacheWarmer::takeHotTables(10).size());
+
+    // The old table's count is halved to 4, so a table with 5 recent accesses overtakes it.
+    for (int i = 0; i < 5; ++i) {
+        WiredTigerCacheWarmer::recordAccess("table:newlyHot");
+    }
+    std::vector<std::string> expected{"table:newlyHot", "table:formerlyHot"};
+    ASSERT(WiredTigerCacheWarmer::takeHotTables(10) == expected);
+
+    // Tables whose counts decay to zero are forgotten.
+    ASSERT_EQ(2U, WiredTigerCacheWarmer::takeHotTables(10).size());
+    ASSERT_EQ(2U, WiredTigerCacheWarmer::takeHotTables(10).size());
+    ASSERT(WiredTigerCacheWarmer::takeHotTables(10).empty());
+}
+
+TEST_F(WiredTigerCacheWarmerTest, SampledAccessesAreRankedByAccessCount) {
+    setParameter("wiredTigerCacheWarmupAccessSampleInterval", "4");
+
+    // Every fourth access is to the cold table. Sampling every fourth access would only ever see
+    // the cold table, while random sampling sees both in proportion to their accesses.
+    for (int i = 0; i < 1000; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            WiredTigerCacheWarmer::recordAccess("table:hot");
+        }
+        WiredTigerCacheWarmer::recordAccess("table:cold");
+    }
+    std::vector<std::string> expected{"table:hot", "table:cold"};
+    ASSERT(WiredTigerCacheWarmer::takeHotTables(10) == expected);
+}
+
+TEST_F(WiredTigerCacheWarmerTest, ManifestRoundTrips) {
+    unittest::TempDir tempDir("cacheWarmerTest");
+    std::vector<std::string> uris{"table:collection-0", "table:index-1"};
+    ASSERT_OK(WiredTigerCacheWarmer::writeManifest(tempDir.path(), uris));
+
+    auto swManifest = WiredTigerCacheWarmer::readManifest(tempDir.path());
+    ASSERT_OK(swManifest.getStatus());
+    ASSERT(swManifest.getValue() == uris);
+
+    // A later manifest replaces the earlier one.
+    uris = {"table:index-1"};
+    ASSERT_OK(WiredTigerCacheWarmer::writeManifest(tempDir.path(), uris));
+    ASSERT(WiredTigerCacheWarmer::readManifest(tempDir.path()).getValue() == uris);
+}
+
+TEST_F(WiredTigerCacheWarmerTest, MissingManifestIsNonExistentPath) {
+    unittest::TempDir tempDir("cacheWarmerTest");
+    ASSERT_EQ(ErrorCodes::NonExistentPath,
+              WiredTigerCacheWarmer::readManifest(tempDir.path()).getStatus());
+}
+
+TEST_F(WiredTigerCacheWarmerTest, TruncatedManifestIsRejected) {
+    unittest::TempDir tempDir("cacheWarmerTest");
+    ASSERT_OK(WiredTigerCacheWarmer::writeManifest(tempDir.path(), {"table:collection-0"}));
+
+    boost::filesystem::path manifestPath =
+        boost::filesystem::path(tempDir.path()) / WiredTigerCacheWarmer::kManifestFileName;
+    boost::filesystem::resize_file(manifestPath, boost::filesystem::file_size(manifestPath) - 1);
+    ASSERT_EQ(ErrorCodes::FailedToParse,
+              WiredTigerCacheWarmer::readManifest(tempDir.path()).getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,369 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_clustered_id_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/platform/decimal128.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+// The largest RecordId a record can be stored under. RecordId::max() itself is reserved.
+const long long kMaxValidId = RecordId::max().repr() - 1;
+
+/**
+ * The integers closest to a numeric _id value, saturated to [0, LLONG_MAX]. Values below zero
+ * are treated as zero, which sorts before every valid RecordId just as they do.
+ */
+struct IntegerBounds {
+    long long floor;
+    long long ceil;
+    bool integral;  // true if the value equals 'floor' and 'ceil'
+};
+
+const IntegerBounds kBelowAllIds = {0, 0, true};
+const IntegerBounds kAboveAllIds = {std::numeric_limits<long long>::max(),
+                                    std::numeric_limits<long long>::max(),
+                                    false};
+
+IntegerBounds integerBounds(const BSONElement& value) {
+    switch (value.type()) {
+        case NumberInt:
+        case NumberLong: {
+            const long long n = value.numberLong();
+            return n < 0 ? kBelowAllIds : IntegerBounds{n, n, true};
+        }
+        case NumberDouble: {
+            const double d = value.numberDouble();
+            if (d < 0) {
+                return kBelowAllIds;
+            }
+            if (d >= std::ldexp(1.0, 63)) {
+                return kAboveAllIds;
+            }
+            const long long floor = static_cast<long long>(std::floor(d));
+            const long long ceil = static_cast<long long>(std::ceil(d));
+            return {floor, ceil, floor == ceil};
+        }
+        case NumberDecimal: {
+            const Decimal128 d = value.numberDecimal();
+            if (d.isNegative()) {
+                return kBelowAllIds;
+            }
+            std::uint32_t floorFlags = Decimal128::SignalingFlag::kNoFlag;
+            std::uint32_t ceilFlags = Decimal128::SignalingFlag::kNoFlag;
+            const long long floor = d.toLong(&floorFlags, Decimal128::kRoundTowardNegative);
+            const long long ceil = d.toLong(&ceilFlags, Decimal128::kRoundTowardPositive);
+            if (Decimal128::hasFlag(floorFlags, Decimal128::SignalingFlag::kInvalid)) {
+                return kAboveAllIds;
+            }
+            if (Decimal128::hasFlag(ceilFlags, Decimal128::SignalingFlag::kInvalid)) {
+                return {floor, std::numeric_limits<long long>::max(), false};
+            }
+            return {floor, ceil, floor == ceil};
+        }
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * Returns a negative number if 'value' sorts before every number in an index, a positive number
+ * if it sorts after every number, and zero if it is a number that can be compared to RecordIds.
+ */
+int compareToNumbers(const BSONElement& value) {
+    const int cmp = canonicalizeBSONType(value.type()) - canonicalizeBSONType(NumberInt);
+    if (cmp != 0) {
+        return cmp;
+    }
+    // NaN sorts before every other number.
+    if (value.type() == NumberDouble && std::isnan(value.numberDouble())) {
+        return -1;
+    }
+    if (value.type() == NumberDecimal && value.numberDecimal().isNaN()) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Adds every key, for building the index on an existing collection. There is nothing to build
+ * since the index is the record store.
+ */
+class NoopBulkBuilder final : public SortedDataBuilderInterface {
+public:
+    Status addKey(const BSONObj& key, const RecordId& id) override {
+        return Status::OK();
+    }
+};
+
+}  // namespace
+
+class WiredTigerClusteredIdIndex::Cursor final : public SortedDataInterface::Cursor {
+public:
+    Cursor(OperationContext* opCtx, const WiredTigerRecordStore& rs, bool forward)
+        : _forward(forward),
+          _endId(forward ? RecordId::max() : RecordId::min()),
+          _cursor(opCtx, rs, forward) {}
+
+    void setEndPosition(const BSONObj& key, bool inclusive) override {
+        if (key.isEmpty()) {
+            _endId = _forward ? RecordId::max() : RecordId::min();
+            return;
+        }
+
+        // An end bound that no RecordId satisfies becomes one that every RecordId is past.
+        if (_forward) {
+            _endId = lastIdAtOrBefore(key.firstElement(), inclusive).value_or(RecordId());
+        } else {
+            _endId = firstIdAtOrAfter(key.firstElement(), inclusive).value_or(RecordId::max());
+        }
+    }
+
+    boost::optional<IndexKeyEntry> next(RequestedInfo parts) override {
+        if (_eof) {
+            return {};
+        }
+
+        auto record = _cursor.next();
+        if (!record || (_forward ? record->id > _endId : record->id < _endId)) {
+            _eof = true;
+            return {};
+        }
+
+        BSONObj key;
+        if (parts & kWantKey) {
+            BSONObjBuilder builder;
+            builder.appendAs(record->data.toBson()["_id"], "");
+            key = builder.obj();
+        }
+        return IndexKeyEntry(std::move(key), record->id);
+    }
+
+    boost::optional<IndexKeyEntry> seek(const BSONObj& key,
+                                        bool inclusive,
+                                        RequestedInfo parts) override {
+        return _seek(key.firstElement(), inclusive, parts);
+    }
+
+    boost::optional<IndexKeyEntry> seek(const IndexSeekPoint& seekPoint,
+                                        RequestedInfo parts) override {
+        // The _id index has a single field, which comes either from the prefix or the suffix.
+        if (seekPoint.prefixLen > 0) {
+            return _seek(seekPoint.keyPrefix.firstElement(), !seekPoint.prefixExclusive, parts);
+        }
+        return _seek(*seekPoint.keySuffix[0], seekPoint.suffixInclusive[0], parts);
+    }
+
+    void save() override {
+        _cursor.save();
+    }
+
+    void saveUnpositioned() override {
+        _cursor.saveUnpositioned();
+    }
+
+    void restore() override {
+        // Records of a non-capped collection can always be restored past.
+        _cursor.restore();
+    }
+
+    void detachFromOperationContext() override {
+        _cursor.detachFromOperationContext();
+    }
+
+    void reattachToOperationContext(OperationContext* opCtx) override {
+        _cursor.reattachToOperationContext(opCtx);
+    }
+
+private:
+    boost::optional<IndexKeyEntry> _seek(const BSONElement& value,
+                                         bool inclusive,
+                                         RequestedInfo parts) {
+        auto start =
+            _forward ? firstIdAtOrAfter(value, inclusive) : lastIdAtOrBefore(value, inclusive);
+        if (!start) {
+            _eof = true;
+            return {};
+        }
+
+        _eof = false;
+        _cursor.seekNear(*start);
+        return next(parts);
+    }
+
+    const bool _forward;
+    bool _eof = false;
+
+    // The last RecordId a forward scan may return, or the first a reverse scan may return.
+    RecordId _endId;
+
+    WiredTigerRecordStoreStandardCursor _cursor;
+};
+
+WiredTigerClusteredIdIndex::WiredTigerClusteredIdIndex(const WiredTigerRecordStore* rs,
+                                                       StringData indexName)
+    : _rs(rs), _indexName(indexName.toString()) {
+    invariant(_rs->isClusteredOnId());
+}
+
+// static
+boost::optional<RecordId> WiredTigerClusteredIdIndex::firstIdAtOrAfter(const BSONElement& value,
+                                                                      bool inclusive) {
+    const int cmp = compareToNumbers(value);
+    if (cmp < 0) {
+        return RecordId(1);
+    } else if (cmp > 0) {
+        return boost::none;
+    }
+
+    const IntegerBounds bounds = integerBounds(value);
+    if (bounds.ceil > kMaxValidId) {
+        return boost::none;
+    }
+    long long first = bounds.ceil;
+    if (bounds.integral && !inclusive) {
+        if (first == kMaxValidId) {
+            return boost::none;
+        }
+        first++;
+    }
+    return RecordId(std::max(first, 1LL));
+}
+
+// static
+boost::optional<RecordId> WiredTigerClusteredIdIndex::lastIdAtOrBefore(const BSONElement& value,
+                                                                      bool inclusive) {
+    const int cmp = compareToNumbers(value);
+    if (cmp < 0) {
+        return boost::none;
+    } else if (cmp > 0) {
+        return RecordId(kMaxValidId);
+    }
+
+    const IntegerBounds bounds = integerBounds(value);
+    long long last = bounds.floor;
+    if (bounds.integral && !inclusive) {
+        last--;
+    }
+    if (last < 1) {
+        return boost::none;
+    }
+    return RecordId(std::min(last, kMaxValidId));
+}
+
+SortedDataBuilderInterface* WiredTigerClusteredIdIndex::getBulkBuilder(OperationContext* opCtx,
+                                                                       bool dupsAllowed) {
+    return new NoopBulkBuilder();
+}
+
+Status WiredTigerClusteredIdIndex::insert(OperationContext* opCtx,
+                                          const BSONObj& key,
+                                          const RecordId& id,
+                                          bool dupsAllowed) {
+    // The record store rejected the insert already if another record has this _id.
+    return Status::OK();
+}
+
+void WiredTigerClusteredIdIndex::unindex(OperationContext* opCtx,
+                                         const BSONObj& key,
+                                         const RecordId& id,
+                                         bool dupsAllowed) {}
+
+Status WiredTigerClusteredIdIndex::dupKeyCheck(OperationContext* opCtx,
+                                               const BSONObj& key,
+                                               const RecordId& id) {
+    auto cursor = newCursor(opCtx);
+    auto entry = cursor->seekExact(key, Cursor::kWantLoc);
+    if (entry && entry->loc != id) {
+        return Status(ErrorCodes::DuplicateKey,
+                      str::stream() << "E11000 duplicate key error collection: " << _rs->ns()
+                                    << " index: "
+                                    << _indexName
+                                    << " dup key: "
+                                    << key);
+    }
+    return Status::OK();
+}
+
+void WiredTigerClusteredIdIndex::fullValidate(OperationContext* opCtx,
+                                              long long* numKeysOut,
+                                              ValidateResults* fullResults) const {
+    long long count = 0;
+    auto cursor = newCursor(opCtx);
+    for (auto entry = cursor->seek(kMinBSONKey, true, Cursor::kJustExistance); entry;
+         entry = cursor->next(Cursor::kJustExistance)) {
+        count++;
+    }
+    if (numKeysOut) {
+        *numKeysOut = count;
+    }
+}
+
+bool WiredTigerClusteredIdIndex::appendCustomStats(OperationContext* opCtx,
+                                                   BSONObjBuilder* output,
+                                                   double scale) const {
+    output->appendBool("clustered", true);
+    return true;
+}
+
+long long WiredTigerClusteredIdIndex::getSpaceUsedBytes(OperationContext* opCtx) const {
+    // The entries are the records themselves, which the collection accounts for.
+    return 0;
+}
+
+bool WiredTigerClusteredIdIndex::isEmpty(OperationContext* opCtx) {
+    return !newCursor(opCtx)->seek(kMinBSONKey, true, Cursor::kJustExistance);
+}
+
+Status WiredTigerClusteredIdIndex::touch(OperationContext* opCtx) const {
+    // Touching the collection loads the index too.
+    return Status::OK();
+}
+
+std::unique_ptr<SortedDataInterface::Cursor> WiredTigerClusteredIdIndex::newCursor(
+    OperationContext* opCtx, bool isForward) const {
+    return stdx::make_unique<Cursor>(opCtx, *_rs, isForward);
+}
+
+Status WiredTigerClusteredIdIndex::initAsEmpty(OperationContext* opCtx) {
+    return Status::OK();
+}
+
+}  // namespace mongo
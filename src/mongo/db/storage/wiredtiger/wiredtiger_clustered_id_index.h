@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class BSONElement;
+class WiredTigerRecordStore;
+
+/**
+ * The _id index of a collection whose records are keyed by their _id (see
+ * WiredTigerRecordStore::kClusteredOnIdOptionName). It has no table of its own: every record is
+ * its own index entry, so inserts and deletes only write the record store, uniqueness is enforced
+ * by the record store key, and lookups and range scans are answered by positioning a cursor on
+ * the record store at the RecordId equal to the _id.
+ */
+class WiredTigerClusteredIdIndex final : public SortedDataInterface {
+public:
+    WiredTigerClusteredIdIndex(const WiredTigerRecordStore* rs, StringData indexName);
+
+    /**
+     * Returns the first RecordId that a scan starting at 'value' visits going forward, or
+     * boost::none if there is none.
+     */
+    static boost::optional<RecordId> firstIdAtOrAfter(const BSONElement& value, bool inclusive);
+
+    /**
+     * Returns the first RecordId that a scan starting at 'value' visits going backward, or
+     * boost::none if there is none.
+     */
+    static boost::optional<RecordId> lastIdAtOrBefore(const BSONElement& value, bool inclusive);
+
+    SortedDataBuilderInterface* getBulkBuilder(OperationContext* opCtx, bool dupsAllowed) override;
+
+    Status insert(OperationContext* opCtx,
+                  const BSONObj& key,
+                  const RecordId& id,
+                  bool dupsAllowed) override;
+
+    void unindex(OperationContext* opCtx,
+                 const BSONObj& key,
+                 const RecordId& id,
+                 bool dupsAllowed) override;
+
+    Status dupKeyCheck(OperationContext* opCtx, const BSONObj& key, const RecordId& id) override;
+
+    void fullValidate(OperationContext* opCtx,
+                      long long* numKeysOut,
+                      ValidateResults* fullResults) const override;
+
+    bool appendCustomStats(OperationContext* opCtx,
+                           BSONObjBuilder* output,
+                           double scale) const override;
+
+    long long getSpaceUsedBytes(OperationContext* opCtx) const override;
+
+    bool isEmpty(OperationContext* opCtx) override;
+
+    Status touch(OperationContext* opCtx) const override;
+
+    std::unique_ptr<SortedDataInterface::Cursor> newCursor(OperationContext* opCtx,
+                                                           bool isForward = true) const override;
+
+    Status initAsEmpty(OperationContext* opCtx) override;
+
+private:
+    class Cursor;
+
+    const WiredTigerRecordStore* _rs;  // not owned
+    const std::string _indexName;
+};
+
+}  // namespace mongo
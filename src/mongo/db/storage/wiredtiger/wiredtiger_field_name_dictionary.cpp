@@ -0,0 +1,236 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_field_name_dictionary.h"
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const char kTokenMarker = '\xFF';
+const unsigned kDigitBase = 254;
+
+void appendId(size_t id, BufBuilder* out) {
+    char digits[8];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>(1 + id % kDigitBase);
+        id /= kDigitBase;
+    } while (id);
+
+    out->appendChar(kTokenMarker);
+    while (n) {
+        out->appendChar(digits[--n]);
+    }
+    out->appendChar('\0');
+}
+
+// Returns 0, which is never a valid id, if 'digits' is not a well-formed id.
+size_t parseId(StringData digits) {
+    // Ids are at most kMaxNames, which never takes more than three digits.
+    if (digits.empty() || digits.size() > 3)
+        return 0;
+
+    size_t id = 0;
+    for (char c : digits) {
+        const unsigned digit = static_cast<unsigned char>(c);
+        if (digit < 1 || digit > kDigitBase)
+            return 0;
+        id = id * kDigitBase + (digit - 1);
+    }
+    return id;
+}
+
+// Terminates the document that starts at offset 'start' of 'out' and fills in its length.
+void finishObject(int start, BufBuilder* out) {
+    out->appendChar(EOO);
+    DataView(out->buf() + start).write(tagLittleEndian<int>(out->len() - start));
+}
+
+}  // namespace
+
+const char WiredTigerFieldNameDictionary::kOptionName[] = "fieldNameDictionary";
+
+WiredTigerFieldNameDictionary::WiredTigerFieldNameDictionary(std::vector<std::string> names)
+    : _names(std::move(names)) {
+    for (size_t i = 0; i < _names.size(); ++i) {
+        _ids[_names[i]] = i + 1;
+    }
+}
+
+StatusWith<std::shared_ptr<const WiredTigerFieldNameDictionary>>
+WiredTigerFieldNameDictionary::parse(const BSONElement& elem) {
+    if (elem.type() != Array) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << kOptionName << " must be an array of field names"};
+    }
+
+    std::vector<std::string> names;
+    StringMap<bool> seen;
+    for (auto&& name : elem.Obj()) {
+        if (name.type() != String || name.valueStringData().empty()) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << kOptionName << " entries must be non-empty strings, found "
+                                  << name};
+        }
+        if (seen[name.valueStringData()]) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << kOptionName << " contains '" << name.valueStringData()
+                                  << "' more than once"};
+        }
+        seen[name.valueStringData()] = true;
+        names.push_back(name.str());
+    }
+
+    if (names.size() > kMaxNames) {
+        return {ErrorCodes::BadValue,
+                str::stream() << kOptionName << " cannot contain more than " << kMaxNames
+                              << " field names"};
+    }
+
+    return std::shared_ptr<const WiredTigerFieldNameDictionary>(
+        std::make_shared<WiredTigerFieldNameDictionary>(std::move(names)));
+}
+
+std::shared_ptr<const WiredTigerFieldNameDictionary> WiredTigerFieldNameDictionary::fromOptions(
+    const BSONObj& wiredTigerOptions) {
+    BSONElement elem = wiredTigerOptions[kOptionName];
+    if (elem.eoo()) {
+        return nullptr;
+    }
+    return uassertStatusOK(parse(elem));
+}
+
+void WiredTigerFieldNameDictionary::encode(const char* data, int size, BufBuilder* out) const {
+    BSONObj obj(data);
+    invariant(obj.objsize() == size);
+    _encodeObject(obj, false, out);
+}
+
+StatusWith<RecordData> WiredTigerFieldNameDictionary::decode(const char* data, int size) const {
+    // Encoded records are well-formed BSON, so checking that first makes it safe to walk them.
+    Status status = validateBSON(data, size, BSONVersion::kLatest);
+    if (!status.isOK()) {
+        return status;
+    }
+    BSONObj obj(data);
+    if (obj.objsize() != size) {
+        return {ErrorCodes::InvalidBSON,
+                str::stream() << "encoded record is " << size
+                              << " bytes but contains a document of " << obj.objsize()
+                              << " bytes"};
+    }
+
+    // Decoding can only make a record bigger, by at most the length of the longest name for each
+    // field, so start from a generous guess.
+    BufBuilder out(size * 2);
+    status = _decodeObject(obj, false, &out);
+    if (!status.isOK()) {
+        return status;
+    }
+    const int decodedSize = out.len();
+    return RecordData(out.release(), decodedSize);
+}
+
+void WiredTigerFieldNameDictionary::_encodeObject(const BSONObj& obj,
+                                                  bool isArray,
+                                                  BufBuilder* out) const {
+    const int start = out->len();
+    out->skip(sizeof(int));
+    for (auto&& elem : obj) {
+        out->appendChar(elem.type());
+
+        StringData name = elem.fieldNameStringData();
+        if (isArray) {
+            out->appendStr(name);
+        } else {
+            auto it = _ids.find(name);
+            if (it != _ids.end()) {
+                appendId(it->second, out);
+            } else {
+                if (!name.empty() && name[0] == kTokenMarker) {
+                    out->appendChar(kTokenMarker);
+                }
+                out->appendStr(name);
+            }
+        }
+
+        if (elem.type() == Object || elem.type() == Array) {
+            _encodeObject(elem.embeddedObject(), elem.type() == Array, out);
+        } else {
+            out->appendBuf(elem.value(), elem.valuesize());
+        }
+    }
+    finishObject(start, out);
+}
+
+Status WiredTigerFieldNameDictionary::_decodeObject(const BSONObj& obj,
+                                                    bool isArray,
+                                                    BufBuilder* out) const {
+    const int start = out->len();
+    out->skip(sizeof(int));
+    for (auto&& elem : obj) {
+        out->appendChar(elem.type());
+
+        StringData name = elem.fieldNameStringData();
+        if (isArray || name.empty() || name[0] != kTokenMarker) {
+            out->appendStr(name);
+        } else if (name.size() > 1 && name[1] == kTokenMarker) {
+            out->appendStr(name.substr(1));
+        } else {
+            const size_t id = parseId(name.substr(1));
+            if (id < 1 || id > _names.size()) {
+                return {ErrorCodes::InvalidBSON,
+                        str::stream() << "encoded record refers to field name id " << id
+                                      << ", which is not in the " << _names.size()
+                                      << " name dictionary"};
+            }
+            out->appendStr(_names[id - 1]);
+        }
+
+        if (elem.type() == Object || elem.type() == Array) {
+            Status status = _decodeObject(elem.embeddedObject(), elem.type() == Array, out);
+            if (!status.isOK()) {
+                return status;
+            }
+        } else {
+            out->appendBuf(elem.value(), elem.valuesize());
+        }
+    }
+    finishObject(start, out);
+    return Status::OK();
+}
+
+}  // namespace mongo
@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/storage/record_data.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Record-level codec that replaces the field names of stored documents with short ids taken from
+ * a fixed, per-collection dictionary. It is configured at collection creation through
+ * storageEngine.wiredTiger.fieldNameDictionary and is stored with the rest of the collection
+ * options in the catalog, so it never changes for the lifetime of the collection.
+ *
+ * An encoded record keeps the BSON layout; only the field names of (nested) objects differ:
+ *  - a dictionary name becomes "\xFF" followed by its id in base 254, using bytes 0x01..0xFE.
+ *  - any other name is stored as is, except that a leading "\xFF" byte is escaped by doubling it.
+ * Array indexes and the contents of CodeWScope values are left alone.
+ */
+class WiredTigerFieldNameDictionary {
+    MONGO_DISALLOW_COPYING(WiredTigerFieldNameDictionary);
+
+public:
+    static const char kOptionName[];
+    static const size_t kMaxNames = 64 * 1024;
+
+    explicit WiredTigerFieldNameDictionary(std::vector<std::string> names);
+
+    /**
+     * Parses and validates the 'fieldNameDictionary' element of the storageEngine.wiredTiger
+     * collection options, which must be an array of distinct, non-empty strings.
+     */
+    static StatusWith<std::shared_ptr<const WiredTigerFieldNameDictionary>> parse(
+        const BSONElement& elem);
+
+    /**
+     * Returns the dictionary configured in the storageEngine.wiredTiger collection options, or
+     * nullptr if there is none. The options must already have been validated.
+     */
+    static std::shared_ptr<const WiredTigerFieldNameDictionary> fromOptions(
+        const BSONObj& wiredTigerOptions);
+
+    /**
+     * Appends the encoded form of the BSON document 'data' of 'size' bytes to 'out'.
+     */
+    void encode(const char* data, int size, BufBuilder* out) const;
+
+    /**
+     * Returns the decoded, owned BSON document for the encoded record 'data' of 'size' bytes, or
+     * InvalidBSON if the record is corrupt and cannot be decoded.
+     */
+    StatusWith<RecordData> decode(const char* data, int size) const;
+
+private:
+    void _encodeObject(const BSONObj& obj, bool isArray, BufBuilder* out) const;
+    Status _decodeObject(const BSONObj& obj, bool isArray, BufBuilder* out) const;
+
+    std::vector<std::string> _names;  // Indexed by id - 1.
+    StringMap<size_t> _ids;
+};
+
+}  // namespace mongo
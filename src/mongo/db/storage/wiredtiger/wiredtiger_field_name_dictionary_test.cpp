@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_field_name_dictionary.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+std::shared_ptr<const WiredTigerFieldNameDictionary> makeDictionary(const BSONObj& names) {
+    BSONObj options = BSON(WiredTigerFieldNameDictionary::kOptionName << names);
+    return uassertStatusOK(
+        WiredTigerFieldNameDictionary::parse(options[WiredTigerFieldNameDictionary::kOptionName]));
+}
+
+BSONObj roundTrip(const WiredTigerFieldNameDictionary& dictionary,
+                  const BSONObj& doc,
+                  int* encodedSize = nullptr) {
+    BufBuilder encoded;
+    dictionary.encode(doc.objdata(), doc.objsize(), &encoded);
+    if (encodedSize) {
+        *encodedSize = encoded.len();
+    }
+    return uassertStatusOK(dictionary.decode(encoded.buf(), encoded.len())).toBson().getOwned();
+}
+
+TEST(WiredTigerFieldNameDictionaryTest, RoundTripReplacesDictionaryNames) {
+    auto dictionary = makeDictionary(BSON_ARRAY("customerName"
+                                                << "shippingAddress"
+                                                << "city"));
+    BSONObj doc = BSON("_id" << 1 << "customerName"
+                             << "Ada"
+                             << "shippingAddress"
+                             << BSON("city"
+                                     << "London"
+                                     << "zip"
+                                     << "N1")
+                             << "orders"
+                             << BSON_ARRAY(BSON("city"
+                                                << "Paris")
+                                           << 5));
+
+    int encodedSize;
+    BSONObj decoded = roundTrip(*dictionary, doc, &encodedSize);
+    ASSERT_BSONOBJ_EQ(doc, decoded);
+    ASSERT_EQ(doc.objsize(), decoded.objsize());
+    ASSERT_LT(encodedSize, doc.objsize());
+}
+
+TEST(WiredTigerFieldNameDictionaryTest, RoundTripEscapesMarkerByte) {
+    auto dictionary = makeDictionary(BSON_ARRAY("a"));
+    BSONObjBuilder builder;
+    builder.append("\xFF", 1);
+    builder.append("\xFF\xFFx", 2);
+    builder.append("\xFF\x01", 3);
+    builder.append("a", 4);
+    BSONObj doc = builder.obj();
+
+    ASSERT_BSONOBJ_EQ(doc, roundTrip(*dictionary, doc));
+}
+
+TEST(WiredTigerFieldNameDictionaryTest, RoundTripManyNames) {
+    BSONArrayBuilder names;
+    for (int i = 0; i < 1000; ++i) {
+        names.append(str::stream() << "field" << i);
+    }
+    auto dictionary = makeDictionary(names.arr());
+
+    BSONObjBuilder builder;
+    for (int i = 0; i < 1000; i += 7) {
+        builder.append(str::stream() << "field" << i, i);
+    }
+    BSONObj doc = builder.obj();
+
+    ASSERT_BSONOBJ_EQ(doc, roundTrip(*dictionary, doc));
+}
+
+TEST(WiredTigerFieldNameDictionaryTest, RoundTripEmptyDocument) {
+    auto dictionary = makeDictionary(BSON_ARRAY("a"));
+    ASSERT_BSONOBJ_EQ(BSONObj(), roundTrip(*dictionary, BSONObj()));
+}
+
+TEST(WiredTigerFieldNameDictionaryTest, DecodeRejectsCorruptRecords) {
+    auto dictionary = makeDictionary(BSON_ARRAY("a"));
+
+    BufBuilder encoded;
+    const BSONObj doc = BSON("a" << 1 << "b" << 2);
+    dictionary->encode(doc.objdata(), doc.objsize(), &encoded);
+    ASSERT_OK(dictionary->decode(encoded.buf(), encoded.len()).getStatus());
+
+    // A size that disagrees with the document
+    ASSERT_EQ(ErrorCodes::InvalidBSON,
+              dictionary->decode(encoded.buf(), encoded.len() - 1).getStatus());
+
+    // A truncated document
+    std::string truncated(encoded.buf(), encoded.len());
+    truncated.resize(truncated.size() - 2);
+    ASSERT_EQ(ErrorCodes::InvalidBSON,
+              dictionary->decode(truncated.data(), truncated.size()).getStatus());
+
+    // An id that is not in the dictionary, and a malformed id
+    const BSONObj unknownId = BSON("\xFF\x03" << 1);
+    ASSERT_EQ(ErrorCodes::InvalidBSON,
+              dictionary->decode(unknownId.objdata(), unknownId.objsize()).getStatus());
+    const BSONObj malformedId = BSON("\xFF" << 1);
+    ASSERT_EQ(ErrorCodes::InvalidBSON,
+              dictionary->decode(malformedId.objdata(), malformedId.objsize()).getStatus());
+}
+
+TEST(WiredTigerFieldNameDictionaryTest, ParseRejectsInvalidDictionaries) {
+    auto parse = [](const BSONObj& options) {
+        return WiredTigerFieldNameDictionary::parse(options.firstElement()).getStatus();
+    };
+
+    ASSERT_EQ(ErrorCodes::TypeMismatch, parse(BSON("d" << "a")));
+    ASSERT_EQ(ErrorCodes::BadValue, parse(BSON("d" << BSON_ARRAY(1))));
+    ASSERT_EQ(ErrorCodes::BadValue, parse(BSON("d" << BSON_ARRAY(""))));
+    ASSERT_EQ(ErrorCodes::BadValue,
+              parse(BSON("d" << BSON_ARRAY("a"
+                                           << "a"))));
+    ASSERT_OK(parse(BSON("d" << BSONArray())));
+}
+
+TEST(WiredTigerFieldNameDictionaryTest, FromOptionsWithoutDictionary) {
+    ASSERT_FALSE(WiredTigerFieldNameDictionary::fromOptions(BSON("configString"
+                                                                 << "")));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -37,6 +37,7 @@
 #define NVALGRIND
 #endif
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -62,6 +63,8 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cache_warmer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_clustered_id_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
@@ -107,33 +110,84 @@ public:
 
         LOG(1) << "starting " << name() << " thread";
 
+        // Callers of waitUntilDurable() hand their journal flushes to this thread from now on, so
+        // that concurrent j:true writers share a single flush.
+        _sessionCache->setGroupCommitEnabled(true);
+
         while (!_shuttingDown.load()) {
+            int ms = storageGlobalParams.journalCommitIntervalMs.load();
+            if (!ms) {
+                ms = 100;
+            }
+
             try {
-                const bool forceCheckpoint = false;
-                const bool stableCheckpoint = false;
-                _sessionCache->waitUntilDurable(forceCheckpoint, stableCheckpoint);
+                _sessionCache->groupCommit(Milliseconds(ms));
             } catch (const AssertionException& e) {
                 invariant(e.code() == ErrorCodes::ShutdownInProgress);
             }
+        }
 
-            int ms = storageGlobalParams.journalCommitIntervalMs.load();
-            if (!ms) {
-                ms = 100;
+        // In case shutdown() was called before group commit got enabled above.
+        _sessionCache->setGroupCommitEnabled(false);
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        _sessionCache->setGroupCommitEnabled(false);
+        wait();
+    }
+
+private:
+    WiredTigerSessionCache* _sessionCache;
+    AtomicBool _shuttingDown{false};
+};
+
+/**
+ * Folds the rows that write transactions add to the size storer's delta table, so that the table
+ * stays small and startup only has to sum a few rows per record store.
+ */
+class WiredTigerKVEngine::WiredTigerSizeStorerCompactor : public BackgroundJob {
+public:
+    explicit WiredTigerSizeStorerCompactor(WiredTigerSizeStorer* sizeStorer)
+        : BackgroundJob(false /* deleteSelf */), _sizeStorer(sizeStorer) {}
+
+    virtual string name() const {
+        return "WTSizeStorerCompactor";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        LOG(1) << "starting " << name() << " thread";
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, stdx::chrono::seconds(1));
             }
 
-            MONGO_IDLE_THREAD_BLOCK;
-            sleepmillis(ms);
+            // Batch by batch, so that other users of the size storer wait one batch at most, and
+            // until the table is caught up so that a busy workload cannot outpace the folding.
+            while (!_shuttingDown.load() && _sizeStorer->compactDeltas()) {
+            }
         }
         LOG(1) << "stopping " << name() << " thread";
     }
 
     void shutdown() {
         _shuttingDown.store(true);
+        _condvar.notify_one();
         wait();
     }
 
 private:
-    WiredTigerSessionCache* _sessionCache;
+    WiredTigerSizeStorer* _sizeStorer;
+
+    // _mutex/_condvar used to notify when _shuttingDown is flipped.
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
     AtomicBool _shuttingDown{false};
 };
 
@@ -254,6 +308,70 @@ private:
     AtomicWord<std::uint64_t> _initialDataTimestamp;
 };
 
+class WiredTigerKVEngine::WiredTigerCacheWarmupThread : public BackgroundJob {
+public:
+    WiredTigerCacheWarmupThread(WT_CONNECTION* conn, std::string path)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn), _path(std::move(path)) {}
+
+    virtual string name() const {
+        return "WTCacheWarmupThread";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        LOG(1) << "starting " << name() << " thread";
+
+        auto manifest = WiredTigerCacheWarmer::readManifest(_path);
+        if (manifest.isOK()) {
+            WiredTigerCacheWarmer::warm(
+                _conn, manifest.getValue(), [this] { return _shuttingDown.load(); });
+        } else if (manifest.getStatus().code() != ErrorCodes::NonExistentPath) {
+            warning() << "Not warming the WiredTiger cache: " << manifest.getStatus();
+        }
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock,
+                                  stdx::chrono::seconds(
+                                      WiredTigerCacheWarmer::getManifestIntervalSecs()));
+            }
+            _writeManifest();
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        _condvar.notify_one();
+        wait();
+    }
+
+private:
+    void _writeManifest() {
+        auto uris =
+            WiredTigerCacheWarmer::takeHotTables(WiredTigerCacheWarmer::getMaxManifestTables());
+        if (uris.empty()) {
+            // Keep the previous manifest rather than replacing it after an idle interval.
+            return;
+        }
+        Status status = WiredTigerCacheWarmer::writeManifest(_path, uris);
+        if (!status.isOK()) {
+            warning() << "Failed to write the WiredTiger cache warm-up manifest: " << status;
+        }
+    }
+
+    WT_CONNECTION* const _conn;
+    const std::string _path;
+
+    // _mutex/_condvar used to notify when _shuttingDown is flipped.
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+    AtomicBool _shuttingDown{false};
+};
+
 namespace {
 
 class TicketServerParameter : public ServerParameter {
@@ -301,6 +419,68 @@ TicketHolder openReadTransaction(128);
 TicketServerParameter openReadTransactionParam(&openReadTransaction,
                                                "wiredTigerConcurrentReadTransactions");
 
+AtomicInt32 ticketsReservedForHighPriority(0);
+AtomicInt32 ticketsReservedFromLowPriority(16);
+
+void applyTicketReserves() {
+    const int forHigh = ticketsReservedForHighPriority.load();
+    const int fromLow = std::max(ticketsReservedFromLowPriority.load(), forHigh);
+    for (auto holder : {&openReadTransaction, &openWriteTransaction}) {
+        holder->setReserved(TicketHolder::Priority::kNormal, forHigh);
+        holder->setReserved(TicketHolder::Priority::kLow, fromLow);
+    }
+}
+
+/**
+ * Number of read and write tickets that operations below some admission priority may not use,
+ * see Locker::AdmissionPriority.
+ */
+class TicketReserveServerParameter : public ServerParameter {
+    MONGO_DISALLOW_COPYING(TicketReserveServerParameter);
+
+public:
+    TicketReserveServerParameter(AtomicInt32* reserve, const std::string& name)
+        : ServerParameter(ServerParameterSet::getGlobal(), name, true, true), _reserve(reserve) {
+        applyTicketReserves();
+    }
+
+    virtual void append(OperationContext* opCtx, BSONObjBuilder& b, const std::string& name) {
+        b.append(name, _reserve->load());
+    }
+
+    virtual Status set(const BSONElement& newValueElement) {
+        if (!newValueElement.isNumber())
+            return Status(ErrorCodes::BadValue, str::stream() << name() << " has to be a number");
+        return _set(newValueElement.numberInt());
+    }
+
+    virtual Status setFromString(const std::string& str) {
+        int num = 0;
+        Status status = parseNumberFromString(str, &num);
+        if (!status.isOK())
+            return status;
+        return _set(num);
+    }
+
+private:
+    Status _set(int newNum) {
+        if (newNum < 0) {
+            return Status(ErrorCodes::BadValue, str::stream() << name() << " has to be >= 0");
+        }
+
+        _reserve->store(newNum);
+        applyTicketReserves();
+        return Status::OK();
+    }
+
+    AtomicInt32* const _reserve;
+};
+
+TicketReserveServerParameter ticketsReservedForHighPriorityParam(
+    &ticketsReservedForHighPriority, "wiredTigerTicketsReservedForHighPriority");
+TicketReserveServerParameter ticketsReservedFromLowPriorityParam(
+    &ticketsReservedFromLowPriority, "wiredTigerTicketsReservedFromLowPriority");
+
 stdx::function<bool(StringData)> initRsOplogBackgroundThreadCallback = [](StringData) -> bool {
     fassertFailed(40358);
 };
@@ -408,28 +588,43 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     _sessionCache.reset(new WiredTigerSessionCache(this));
 
-    if (_durable && !_ephemeral) {
-        _journalFlusher = stdx::make_unique<WiredTigerJournalFlusher>(_sessionCache.get());
-        _journalFlusher->go();
-    }
-
-    if (!_readOnly && !_ephemeral) {
-        _checkpointThread = stdx::make_unique<WiredTigerCheckpointThread>(_sessionCache.get());
-        _checkpointThread->go();
-    }
-
     _sizeStorerUri = "table:sizeStorer";
     WiredTigerSession session(_conn);
     if (!_readOnly && repair && _hasUri(session.getSession(), _sizeStorerUri)) {
         log() << "Repairing size cache";
         fassertNoTrace(28577, _salvageIfNeeded(_sizeStorerUri.c_str()));
     }
+    const std::string sizeStorerDeltasUri = WiredTigerSizeStorer::getDeltasUri(_sizeStorerUri);
+    if (!_readOnly && repair && _hasUri(session.getSession(), sizeStorerDeltasUri)) {
+        log() << "Repairing size deltas";
+        fassertNoTrace(50700, _salvageIfNeeded(sizeStorerDeltasUri.c_str()));
+    }
 
     const bool sizeStorerLoggingEnabled = !getGlobalReplSettings().usingReplSets();
     _sizeStorer.reset(
         new WiredTigerSizeStorer(_conn, _sizeStorerUri, sizeStorerLoggingEnabled, _readOnly));
     _sizeStorer->fillCache();
 
+    if (_durable && !_ephemeral) {
+        _journalFlusher = stdx::make_unique<WiredTigerJournalFlusher>(_sessionCache.get());
+        _journalFlusher->go();
+    }
+
+    if (!_readOnly && !_ephemeral) {
+        _checkpointThread = stdx::make_unique<WiredTigerCheckpointThread>(_sessionCache.get());
+        _checkpointThread->go();
+
+        _sizeStorerCompactor = stdx::make_unique<WiredTigerSizeStorerCompactor>(_sizeStorer.get());
+        _sizeStorerCompactor->go();
+    }
+
+    // The warm-up's cursors would make the verify and salvage done by --repair fail with EBUSY,
+    // and a repair run does not serve any workload worth warming the cache for.
+    if (!_readOnly && !_ephemeral && !repair && WiredTigerCacheWarmer::isEnabled()) {
+        _cacheWarmupThread = stdx::make_unique<WiredTigerCacheWarmupThread>(_conn, _path);
+        _cacheWarmupThread->go();
+    }
+
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 }
 
@@ -446,19 +641,23 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
         BSONObjBuilder bbb(bb.subobjStart("write"));
-        bbb.append("out", openWriteTransaction.used());
-        bbb.append("available", openWriteTransaction.available());
-        bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendStats(&bbb);
         bbb.done();
     }
     {
         BSONObjBuilder bbb(bb.subobjStart("read"));
-        bbb.append("out", openReadTransaction.used());
-        bbb.append("available", openReadTransaction.available());
-        bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendStats(&bbb);
         bbb.done();
     }
     bb.done();
+
+    BSONObjBuilder groupCommit(b.subobjStart("journalGroupCommit"));
+    WiredTigerSessionCache::appendGroupCommitStats(&groupCommit);
+    groupCommit.done();
+
+    BSONObjBuilder cacheWarmup(b.subobjStart("cacheWarmup"));
+    WiredTigerCacheWarmer::appendStats(&cacheWarmup);
+    cacheWarmup.done();
 }
 
 void WiredTigerKVEngine::cleanShutdown() {
@@ -471,6 +670,10 @@ void WiredTigerKVEngine::cleanShutdown() {
             _journalFlusher->shutdown();
         if (_checkpointThread)
             _checkpointThread->shutdown();
+        if (_cacheWarmupThread)
+            _cacheWarmupThread->shutdown();
+        if (_sizeStorerCompactor)
+            _sizeStorerCompactor->shutdown();
         _sizeStorer.reset();
         _sessionCache->shuttingDown();
 
@@ -713,6 +916,10 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.cappedCallback = nullptr;
     params.sizeStorer = _sizeStorer.get();
     params.isReadOnly = _readOnly;
+    params.fieldNameDictionary = WiredTigerFieldNameDictionary::fromOptions(
+        options.storageEngine.getObjectField(_canonicalName));
+    params.clusteredOnId = options.storageEngine.getObjectField(_canonicalName)
+                               .getBoolField(WiredTigerRecordStore::kClusteredOnIdOptionName);
 
     params.cappedMaxSize = -1;
     if (options.capped) {
@@ -781,6 +988,16 @@ SortedDataInterface* WiredTigerKVEngine::getGroupedSortedDataInterface(Operation
                                                                        StringData ident,
                                                                        const IndexDescriptor* desc,
                                                                        KVPrefix prefix) {
+    // The _id index of a collection clustered on _id is served by the record store itself. Its
+    // table is still created, and stays empty, so that dropping and repairing it work as usual.
+    if (desc->isIdIndex() && desc->getCollection()) {
+        const auto rs =
+            dynamic_cast<const WiredTigerRecordStore*>(desc->getCollection()->getRecordStore());
+        if (rs && rs->isClusteredOnId()) {
+            return new WiredTigerClusteredIdIndex(rs, desc->indexName());
+        }
+    }
+
     if (desc->unique())
         return new WiredTigerIndexUnique(opCtx, _uri(ident), desc, prefix, _readOnly);
     return new WiredTigerIndexStandard(opCtx, _uri(ident), desc, prefix, _readOnly);
@@ -799,6 +1016,12 @@ Status WiredTigerKVEngine::dropIdent(OperationContext* opCtx, StringData ident)
         session.getSession(), uri.c_str(), "force,checkpoint_wait=false");
     LOG(1) << "WT drop of  " << uri << " res " << ret;
 
+    // The ident is gone from the catalog even when WiredTiger drops the table later, so its exact
+    // counts, if it is a record store that kept any, are no longer needed.
+    if (ret == 0 || ret == EBUSY) {
+        _sizeStorer->removeDeltas(uri);
+    }
+
     if (ret == 0) {
         // yay, it worked
         return Status::OK();
@@ -943,7 +1166,7 @@ std::vector<std::string> WiredTigerKVEngine::getAllIdents(OperationContext* opCt
             continue;
 
         StringData ident = key.substr(idx + 1);
-        if (ident == "sizeStorer")
+        if (ident == "sizeStorer" || ident == "sizeStorerDeltas")
             continue;
 
         all.push_back(ident.toString());
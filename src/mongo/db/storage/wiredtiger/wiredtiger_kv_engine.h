@@ -248,6 +248,8 @@ public:
 private:
     class WiredTigerJournalFlusher;
     class WiredTigerCheckpointThread;
+    class WiredTigerSizeStorerCompactor;
+    class WiredTigerCacheWarmupThread;
 
     Status _salvageIfNeeded(const char* uri);
     void _checkIdentPath(StringData ident);
@@ -286,6 +288,8 @@ private:
     bool _readOnly;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
+    std::unique_ptr<WiredTigerCacheWarmupThread> _cacheWarmupThread;
+    std::unique_ptr<WiredTigerSizeStorerCompactor> _sizeStorerCompactor;  // Depends on _sizeStorer
 
     std::string _rsOptions;
     std::string _indexOptions;
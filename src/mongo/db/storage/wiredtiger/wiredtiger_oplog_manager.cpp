@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
@@ -161,8 +162,9 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
         stdx::unique_lock<stdx::mutex> lk(_oplogVisibilityStateMutex);
         {
             MONGO_IDLE_THREAD_BLOCK;
-            _opsWaitingForJournalCV.wait(lk,
-                                         [&] { return _shuttingDown || _opsWaitingForJournal; });
+            _opsWaitingForJournalCV.wait(lk, [&] {
+                return _shuttingDown || _opsWaitingForJournal || _durableOpsToPublish;
+            });
         }
 
         while (!_shuttingDown && MONGO_FAIL_POINT(WTPausePrimaryOplogDurabilityLoop)) {
@@ -175,48 +177,121 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
             log() << "oplog journal thread loop shutting down";
             return;
         }
+
+        // Only new commits need a journal flush of our own. Entries made durable by someone
+        // else's flush are published without one.
+        const bool flushRequested = _opsWaitingForJournal;
         _opsWaitingForJournal = false;
+        _durableOpsToPublish = false;
         lk.unlock();
 
         const uint64_t newTimestamp = _fetchAllCommittedValue(sessionCache->conn());
 
-        // The newTimestamp may actually go backward during secondary batch application,
-        // where we commit data file changes separately from oplog changes, so ignore
-        // a non-incrementing timestamp.
-        if (newTimestamp <= _oplogReadTimestamp.load()) {
+        lk.lock();
+        const auto update = planVisibilityUpdate(
+            newTimestamp, _durableAllCommitted, _oplogReadTimestamp.load(), flushRequested);
+        if (!update.publishWithoutFlush && !update.flushAndPublish) {
             LOG(2) << "no new oplog entries were made visible: " << newTimestamp;
             continue;
         }
 
-        // In order to avoid oplog holes after an unclean shutdown, we must ensure this proposed
-        // oplog read timestamp's documents are durable before publishing that timestamp.
-        sessionCache->waitUntilDurable(/*forceCheckpoint=*/false, false);
-
-        lk.lock();
-        // Publish the new timestamp value.
-        _setOplogReadTimestamp(lk, newTimestamp);
+        uint64_t published = update.publishWithoutFlush;
+        if (update.publishWithoutFlush) {
+            _setOplogReadTimestamp(lk, update.publishWithoutFlush);
+        }
         lk.unlock();
 
-        // Wake up any await_data cursors and tell them more data might be visible now.
-        oplogRecordStore->notifyCappedWaitersIfNeeded();
+        if (update.publishWithoutFlush) {
+            // Wake up any await_data cursors and tell them more data might be visible now.
+            oplogRecordStore->notifyCappedWaitersIfNeeded();
+        }
+
+        if (update.flushAndPublish) {
+            sessionCache->waitUntilDurable(/*forceCheckpoint=*/false, false);
+
+            lk.lock();
+            _setOplogReadTimestamp(lk, newTimestamp);
+            lk.unlock();
+            published = newTimestamp;
+
+            oplogRecordStore->notifyCappedWaitersIfNeeded();
+        }
 
         // For master/slave masters, set oldest timestamp here so that we clean up old timestamp
         // data.  SERVER-31802
         if (isMasterSlave) {
-            sessionCache->getKVEngine()->setStableTimestamp(Timestamp(newTimestamp));
+            sessionCache->getKVEngine()->setStableTimestamp(Timestamp(published));
         }
     }
 }
 
+WiredTigerOplogManager::VisibilityUpdate WiredTigerOplogManager::planVisibilityUpdate(
+    uint64_t allCommitted,
+    uint64_t durableAllCommitted,
+    uint64_t oplogReadTimestamp,
+    bool flushRequested) {
+    VisibilityUpdate update;
+
+    // The all_committed timestamp may actually go backward during secondary batch application,
+    // where we commit data file changes separately from oplog changes, so ignore a
+    // non-incrementing timestamp.
+    if (allCommitted <= oplogReadTimestamp) {
+        return update;
+    }
+
+    // In order to avoid oplog holes after an unclean shutdown, an oplog read timestamp may only
+    // be published once its entries are durable. Everything up to the durable point already is,
+    // for instance thanks to a flush done on behalf of a j:true writer, so it can be published
+    // right away, and the rest only after a flush of our own if new commits asked for one.
+    const auto durable = std::min(allCommitted, durableAllCommitted);
+    if (durable > oplogReadTimestamp) {
+        update.publishWithoutFlush = durable;
+    }
+    update.flushAndPublish = flushRequested && allCommitted > durableAllCommitted;
+    return update;
+}
+
 std::uint64_t WiredTigerOplogManager::getOplogReadTimestamp() const {
     return _oplogReadTimestamp.load();
 }
 
 void WiredTigerOplogManager::setOplogReadTimestamp(Timestamp ts) {
     stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    _durableAllCommitted = 0;
+    ++_durabilityEpoch;
     _setOplogReadTimestamp(lk, ts.asULL());
 }
 
+WiredTigerOplogManager::JournalFlushMark WiredTigerOplogManager::beginJournalFlush(
+    WT_CONNECTION* conn) {
+    JournalFlushMark mark;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+        if (!_isRunning || _shuttingDown) {
+            return mark;
+        }
+        mark.epoch = _durabilityEpoch;
+    }
+    mark.allCommitted = _fetchAllCommittedValue(conn);
+    return mark;
+}
+
+void WiredTigerOplogManager::endJournalFlush(const JournalFlushMark& mark) {
+    stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    if (mark.allCommitted == 0 || mark.epoch != _durabilityEpoch ||
+        mark.allCommitted <= _durableAllCommitted) {
+        return;
+    }
+    _durableAllCommitted = mark.allCommitted;
+
+    // Have the oplogJournal thread publish the newly durable entries, which no longer needs a
+    // journal flush of its own.
+    if (_durableAllCommitted > _oplogReadTimestamp.load() && !_durableOpsToPublish) {
+        _durableOpsToPublish = true;
+        _opsWaitingForJournalCV.notify_one();
+    }
+}
+
 void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimestamp) {
     _oplogReadTimestamp.store(newTimestamp);
     _opsBecameVisibleCV.notify_all();
@@ -79,6 +79,28 @@ public:
     void waitForAllEarlierOplogWritesToBeVisible(const WiredTigerRecordStore* oplogRecordStore,
                                                  OperationContext* opCtx) const;
 
+    // Everything committed before a journal flush starts is durable once the flush completes.
+    // The session cache brackets every journal flush with these two calls so that the oplog can be
+    // made visible up to the durable point without the oplogJournal thread flushing again.
+    struct JournalFlushMark {
+        uint64_t epoch = 0;
+        uint64_t allCommitted = 0;
+    };
+    JournalFlushMark beginJournalFlush(WT_CONNECTION* conn);
+    void endJournalFlush(const JournalFlushMark& mark);
+
+    // What the oplogJournal thread does with the latest all_committed timestamp.
+    struct VisibilityUpdate {
+        // Already durable, so published straight away. Zero if nothing new is durable yet.
+        uint64_t publishWithoutFlush = 0;
+        // Whether to flush the journal and then publish the all_committed timestamp.
+        bool flushAndPublish = false;
+    };
+    static VisibilityUpdate planVisibilityUpdate(uint64_t allCommitted,
+                                                 uint64_t durableAllCommitted,
+                                                 uint64_t oplogReadTimestamp,
+                                                 bool flushRequested);
+
 private:
     void _oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                  WiredTigerRecordStore* oplogRecordStore,
@@ -103,6 +125,17 @@ private:
     RecordId _oplogMaxAtStartup = RecordId(0);  // Guarded by oplogVisibilityStateMutex.
     bool _opsWaitingForJournal = false;         // Guarded by oplogVisibilityStateMutex.
 
+    // Set when a journal flush made unpublished entries durable. Wakes the oplogJournal thread to
+    // publish them, without asking it to flush. Guarded by oplogVisibilityStateMutex.
+    bool _durableOpsToPublish = false;
+
+    // The all_committed timestamp as of the start of the last completed journal flush. Oplog
+    // entries up to it are durable and may be made visible without another flush. Reset, and the
+    // epoch bumped, whenever the oplog read timestamp is set externally (e.g. after truncating the
+    // oplog), as flushes started before then may vouch for entries that no longer exist.
+    uint64_t _durableAllCommitted = 0;  // Guarded by oplogVisibilityStateMutex.
+    uint64_t _durabilityEpoch = 0;      // Guarded by oplogVisibilityStateMutex.
+
     AtomicUInt64 _oplogReadTimestamp;
 };
 }  // namespace mongo
@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using VisibilityUpdate = WiredTigerOplogManager::VisibilityUpdate;
+
+VisibilityUpdate plan(uint64_t allCommitted,
+                      uint64_t durableAllCommitted,
+                      uint64_t oplogReadTimestamp,
+                      bool flushRequested) {
+    return WiredTigerOplogManager::planVisibilityUpdate(
+        allCommitted, durableAllCommitted, oplogReadTimestamp, flushRequested);
+}
+
+TEST(WiredTigerOplogManagerTest, NothingNewIsNotPublished) {
+    auto update = plan(10, 20, 10, true);
+    ASSERT_EQ(0U, update.publishWithoutFlush);
+    ASSERT_FALSE(update.flushAndPublish);
+
+    // all_committed can go backward during secondary batch application.
+    update = plan(5, 20, 10, true);
+    ASSERT_EQ(0U, update.publishWithoutFlush);
+    ASSERT_FALSE(update.flushAndPublish);
+}
+
+TEST(WiredTigerOplogManagerTest, AlreadyDurableEntriesArePublishedWithoutFlush) {
+    auto update = plan(15, 20, 10, true);
+    ASSERT_EQ(15U, update.publishWithoutFlush);
+    ASSERT_FALSE(update.flushAndPublish);
+
+    update = plan(20, 20, 10, false);
+    ASSERT_EQ(20U, update.publishWithoutFlush);
+    ASSERT_FALSE(update.flushAndPublish);
+}
+
+TEST(WiredTigerOplogManagerTest, DurablePrefixIsPublishedAheadOfFlush) {
+    // Entries up to 20 were made durable by another flush. They become visible straight away
+    // and the rest only after the journal thread flushes.
+    auto update = plan(30, 20, 10, true);
+    ASSERT_EQ(20U, update.publishWithoutFlush);
+    ASSERT_TRUE(update.flushAndPublish);
+}
+
+TEST(WiredTigerOplogManagerTest, DurablePrefixIsPublishedWhenNoFlushIsRequested) {
+    // Woken only because a flush made entries durable: publish them, but do not flush again.
+    auto update = plan(30, 20, 10, false);
+    ASSERT_EQ(20U, update.publishWithoutFlush);
+    ASSERT_FALSE(update.flushAndPublish);
+}
+
+TEST(WiredTigerOplogManagerTest, FlushesWhenNothingNewIsDurable) {
+    auto update = plan(30, 5, 10, true);
+    ASSERT_EQ(0U, update.publishWithoutFlush);
+    ASSERT_TRUE(update.flushAndPublish);
+
+    update = plan(30, 10, 10, true);
+    ASSERT_EQ(0U, update.publishWithoutFlush);
+    ASSERT_TRUE(update.flushAndPublish);
+
+    update = plan(30, 10, 10, false);
+    ASSERT_EQ(0U, update.publishWithoutFlush);
+    ASSERT_FALSE(update.flushAndPublish);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -437,6 +437,23 @@ void WiredTigerRecordStore::OplogStones::adjust(int64_t maxSize) {
     _pokeReclaimThreadIfNeeded();
 }
 
+const char WiredTigerRecordStore::kClusteredOnIdOptionName[] = "clusteredOnId";
+
+// static
+StatusWith<RecordId> WiredTigerRecordStore::extractClusteredId(const BSONObj& doc) {
+    BSONElement id = doc["_id"];
+    if (id.type() == NumberInt || id.type() == NumberLong) {
+        const long long value = id.numberLong();
+        if (value > 0 && value < RecordId::max().repr()) {
+            return RecordId(value);
+        }
+    }
+    return {ErrorCodes::BadValue,
+            str::stream() << "Collections with the " << kClusteredOnIdOptionName
+                          << " option require _id to be a positive 32 or 64-bit integer, not "
+                          << id};
+}
+
 StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj options) {
     StringBuilder ss;
     BSONForEach(elem, options) {
@@ -446,6 +463,18 @@ StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj o
                 return status;
             }
             ss << elem.valueStringData() << ',';
+        } else if (elem.fieldNameStringData() == WiredTigerFieldNameDictionary::kOptionName) {
+            // Applied by the record store rather than by WiredTiger.
+            auto dictionary = WiredTigerFieldNameDictionary::parse(elem);
+            if (!dictionary.isOK()) {
+                return dictionary.getStatus();
+            }
+        } else if (elem.fieldNameStringData() == kClusteredOnIdOptionName) {
+            // Applied by the record store rather than by WiredTiger.
+            if (!elem.isBoolean()) {
+                return {ErrorCodes::InvalidOptions,
+                        str::stream() << kClusteredOnIdOptionName << " must be a boolean"};
+            }
         } else {
             // Return error on first unrecognized field.
             return StatusWith<std::string>(ErrorCodes::InvalidOptions,
@@ -482,7 +511,7 @@ public:
         WT_ITEM value;
         invariantWTOK(_cursor->get_value(_cursor, &value));
 
-        return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+        return {{id, _rs->_toRecordData(value)}};
     }
 
     void save() final {
@@ -559,11 +588,25 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
 
     ss << extraStrings << ",";
 
-    StatusWith<std::string> customOptions =
-        parseOptionsField(options.storageEngine.getObjectField(engineName));
+    const BSONObj engineOptions = options.storageEngine.getObjectField(engineName);
+    StatusWith<std::string> customOptions = parseOptionsField(engineOptions);
     if (!customOptions.isOK())
         return customOptions;
 
+    if (engineOptions.hasField(WiredTigerFieldNameDictionary::kOptionName) &&
+        (options.capped || NamespaceString::oplog(ns))) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << WiredTigerFieldNameDictionary::kOptionName
+                              << " is not supported for capped collections"};
+    }
+
+    if (engineOptions.getBoolField(kClusteredOnIdOptionName) &&
+        (options.capped || NamespaceString::oplog(ns) || prefixed)) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << kClusteredOnIdOptionName
+                              << " is not supported for capped or grouped collections"};
+    }
+
     ss << customOptions.getValue();
 
     if (NamespaceString::oplog(ns)) {
@@ -621,7 +664,9 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
       _cappedDeleteCheckCount(0),
       _sizeStorer(params.sizeStorer),
       _sizeStorerCounter(0),
-      _kvEngine(kvEngine) {
+      _kvEngine(kvEngine),
+      _fieldNameDictionary(params.fieldNameDictionary),
+      _clusteredOnId(params.clusteredOnId) {
     Status versionStatus = WiredTigerUtil::checkApplicationMetadataFormatVersion(
                                ctx, _uri, kMinimumRecordStoreVersion, kMaximumRecordStoreVersion)
                                .getStatus();
@@ -635,6 +680,8 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
     }
 
     if (_isCapped) {
+        invariant(!_fieldNameDictionary);
+        invariant(!_clusteredOnId);
         invariant(_cappedMaxSize > 0);
         invariant(_cappedMaxDocs == -1 || _cappedMaxDocs > 0);
     } else {
@@ -679,6 +726,10 @@ WiredTigerRecordStore::~WiredTigerRecordStore() {
 void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
     // Find the largest RecordId currently in use and estimate the number of records.
     std::unique_ptr<SeekableRecordCursor> cursor = getCursor(opCtx, /*forward=*/false);
+    // Sizes are accounted for as stored, which may be encoded, so records that cannot be decoded
+    // are still counted rather than failing startup. Validate reports them.
+    auto wtCursor = static_cast<WiredTigerRecordStoreCursorBase*>(cursor.get());
+    wtCursor->returnUndecodableRecords();
     if (auto record = cursor->next()) {
         int64_t max = record->id.repr();
         _nextIdNum.store(1 + max);
@@ -690,6 +741,7 @@ void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
             _numRecords.store(numRecords);
             _dataSize.store(dataSize);
             _sizeStorer->onCreate(this, numRecords, dataSize);
+            _trackSizeDeltas = !_isEphemeral && _sizeStorer->trackDeltas(this);
         } else {
             LOG(1) << "Doing scan of collection " << ns() << " to get size and count info";
 
@@ -698,7 +750,7 @@ void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
 
             do {
                 _numRecords.fetchAndAdd(1);
-                _dataSize.fetchAndAdd(record->data.size());
+                _dataSize.fetchAndAdd(wtCursor->storedSizeOfLastReturned());
             } while ((record = cursor->next()));
         }
     } else {
@@ -706,8 +758,10 @@ void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
         _numRecords.store(0);
         // Need to start at 1 so we are always higher than RecordId::min()
         _nextIdNum.store(1);
-        if (_sizeStorer)
+        if (_sizeStorer) {
             _sizeStorer->onCreate(this, 0, 0);
+            _trackSizeDeltas = !_isEphemeral && _sizeStorer->trackDeltas(this);
+        }
     }
 
     if (WiredTigerKVEngine::initRsOplogBackgroundThread(ns())) {
@@ -779,7 +833,19 @@ RecordData WiredTigerRecordStore::_getData(const WiredTigerCursor& cursor) const
     WT_ITEM value;
     invariantWTOK(cursor->get_value(cursor.get(), &value));
 
-    return RecordData(static_cast<const char*>(value.data), value.size).getOwned();
+    return _toRecordData(value).getOwned();
+}
+
+StatusWith<RecordData> WiredTigerRecordStore::_decodeRecordData(const WT_ITEM& value) const {
+    const char* data = static_cast<const char*>(value.data);
+    if (_fieldNameDictionary) {
+        return _fieldNameDictionary->decode(data, value.size);
+    }
+    return RecordData(data, value.size);
+}
+
+RecordData WiredTigerRecordStore::_toRecordData(const WT_ITEM& value) const {
+    return uassertStatusOK(_decodeRecordData(value));
 }
 
 RecordData WiredTigerRecordStore::dataFor(OperationContext* opCtx, const RecordId& id) const {
@@ -1105,11 +1171,24 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
                                              Record* records,
                                              const Timestamp* timestamps,
                                              size_t nRecords) {
+    // Records are stored, and their sizes accounted for, in encoded form when this record store
+    // uses a field name dictionary.
+    BufBuilder encoded;
+    std::vector<std::pair<int, int>> encodedRanges;
+    if (_fieldNameDictionary) {
+        encodedRanges.reserve(nRecords);
+        for (size_t i = 0; i < nRecords; i++) {
+            const int start = encoded.len();
+            _fieldNameDictionary->encode(records[i].data.data(), records[i].data.size(), &encoded);
+            encodedRanges.emplace_back(start, encoded.len() - start);
+        }
+    }
+
     // We are kind of cheating on capped collections since we write all of them at once ....
     // Simplest way out would be to just block vector writes for everything except oplog ?
     int64_t totalLength = 0;
     for (size_t i = 0; i < nRecords; i++)
-        totalLength += records[i].data.size();
+        totalLength += _fieldNameDictionary ? encodedRanges[i].second : records[i].data.size();
 
     // caller will retry one element at a time
     if (_isCapped && totalLength > _cappedMaxSize)
@@ -1132,11 +1211,17 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             record.id = status.getValue();
         } else if (_isCapped) {
             record.id = _nextId();
+        } else if (_clusteredOnId) {
+            StatusWith<RecordId> status = extractClusteredId(record.data.toBson());
+            if (!status.isOK())
+                return status.getStatus();
+            record.id = status.getValue();
         } else {
             record.id = _nextId();
         }
-        dassert(record.id > highestId);
-        highestId = record.id;
+        // Records clustered on _id can be inserted in any order.
+        dassert(_clusteredOnId || record.id > highestId);
+        highestId = std::max(highestId, record.id);
     }
 
     for (size_t i = 0; i < nRecords; i++) {
@@ -1155,7 +1240,25 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             fassertStatusOK(39001, opCtx->recoveryUnit()->setTimestamp(ts));
         }
         setKey(c, record.id);
-        WiredTigerItem value(record.data.data(), record.data.size());
+        if (_clusteredOnId) {
+            // Record store cursors overwrite existing keys, so a record with the same _id has to
+            // be looked for first. Snapshot isolation makes a concurrent insert of the same _id
+            // a write conflict rather than a silent overwrite.
+            int ret = WT_READ_CHECK(c->search(c));
+            if (ret == 0) {
+                return Status(ErrorCodes::DuplicateKey,
+                              str::stream() << "E11000 duplicate key error collection: " << ns()
+                                            << " index: _id_ dup key: { : "
+                                            << record.id.repr()
+                                            << " }");
+            }
+            if (ret != WT_NOTFOUND)
+                return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
+            setKey(c, record.id);
+        }
+        WiredTigerItem value = _fieldNameDictionary
+            ? WiredTigerItem(encoded.buf() + encodedRanges[i].first, encodedRanges[i].second)
+            : WiredTigerItem(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(c->insert(c));
         if (ret)
@@ -1263,9 +1366,23 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
         return {ErrorCodes::IllegalOperation, "Cannot change the size of a document in the oplog"};
     }
 
+    BufBuilder encoded;
+    if (_fieldNameDictionary) {
+        _fieldNameDictionary->encode(data, len, &encoded);
+        data = encoded.buf();
+        len = encoded.len();
+    }
+
+    // Write only the changed bytes when they are a small part of the record, so that an update
+    // growing a large document does not copy all of it into the cache and the journal.
     WiredTigerItem value(data, len);
-    c->set_value(c, value.Get());
-    ret = WT_OP_CHECK(c->insert(c));
+    std::vector<WT_MODIFY> entries;
+    if (WiredTigerUtil::computeModifies(old_value, value, &entries)) {
+        ret = WT_OP_CHECK(c->modify(c, entries.data(), entries.size()));
+    } else {
+        c->set_value(c, value.Get());
+        ret = WT_OP_CHECK(c->insert(c));
+    }
     invariantWTOK(ret);
 
     _increaseDataSize(opCtx, len - old_length);
@@ -1277,7 +1394,8 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
 }
 
 bool WiredTigerRecordStore::updateWithDamagesSupported() const {
-    return true;
+    // Damages are expressed as offsets into the decoded document.
+    return !_fieldNameDictionary;
 }
 
 StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
@@ -1398,16 +1516,26 @@ Status WiredTigerRecordStore::validate(OperationContext* opCtx,
 
     results->valid = true;
     std::unique_ptr<SeekableRecordCursor> cursor = getCursor(opCtx, true);
+    auto wtCursor = static_cast<WiredTigerRecordStoreCursorBase*>(cursor.get());
+    wtCursor->returnUndecodableRecords();
     int interruptInterval = 4096;
 
     while (auto record = cursor->next()) {
         if (!(nrecords % interruptInterval))
             opCtx->checkForInterrupt();
         ++nrecords;
+        // The data size statistic counts records as stored, which may be encoded, while the
+        // adaptor validates the decoded document.
+        dataSizeTotal += wtCursor->storedSizeOfLastReturned();
         auto dataSize = record->data.size();
-        dataSizeTotal += dataSize;
-        size_t validatedSize;
-        Status status = adaptor->validate(record->id, record->data, &validatedSize);
+        size_t validatedSize = 0;
+        Status status = wtCursor->decodeStatusOfLastReturned();
+        if (status.isOK()) {
+            status = adaptor->validate(record->id, record->data, &validatedSize);
+        } else {
+            log() << "document at location: " << record->id
+                  << " cannot be decoded: " << redact(status);
+        }
 
         // The validatedSize equals dataSize below is not a general requirement, but must be
         // true for WT today because we never pad records.
@@ -1530,6 +1658,9 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
     if (_sizeStorer) {
         _sizeStorer->storeToCache(_uri, numRecords, dataSize);
     }
+    if (_trackSizeDeltas) {
+        _sizeStorer->resetDeltas(_uri, numRecords, dataSize);
+    }
 }
 
 RecordId WiredTigerRecordStore::_nextId() {
@@ -1560,6 +1691,10 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
     opCtx->recoveryUnit()->registerChange(new NumRecordsChange(this, diff));
     if (_numRecords.fetchAndAdd(diff) < 0)
         _numRecords.store(std::max(diff, int64_t(0)));
+
+    if (_trackSizeDeltas && diff != 0) {
+        _sizeStorer->recordDelta(opCtx, _uri, diff, 0);
+    }
 }
 
 class WiredTigerRecordStore::DataSizeChange : public RecoveryUnit::Change {
@@ -1576,8 +1711,13 @@ private:
 };
 
 void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t amount) {
-    if (opCtx)
+    if (opCtx) {
         opCtx->recoveryUnit()->registerChange(new DataSizeChange(this, amount));
+        // A rollback passes no opCtx, and WiredTiger already discards the transaction's delta.
+        if (_trackSizeDeltas && amount != 0) {
+            _sizeStorer->recordDelta(opCtx, _uri, 0, amount);
+        }
+    }
 
     if (_dataSize.fetchAndAdd(amount) < 0)
         _dataSize.store(std::max(amount, int64_t(0)));
@@ -1736,7 +1876,8 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     invariantWTOK(c->get_value(c, &value));
 
     _lastReturnedId = id;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    _lastReturnedStoredSize = value.size;
+    return {{id, _decodeLastReturned(value)}};
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
@@ -1756,11 +1897,44 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
     invariantWTOK(c->get_value(c, &value));
 
     _lastReturnedId = id;
+    _lastReturnedStoredSize = value.size;
     _eof = false;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return {{id, _decodeLastReturned(value)}};
+}
+
+RecordData WiredTigerRecordStoreCursorBase::_decodeLastReturned(const WT_ITEM& value) {
+    auto decoded = _rs._decodeRecordData(value);
+    _lastReturnedDecodeStatus = decoded.getStatus();
+    if (!decoded.isOK() && _returnUndecodableRecords) {
+        return RecordData(static_cast<const char*>(value.data), value.size);
+    }
+    return uassertStatusOK(std::move(decoded));
 }
 
 
+void WiredTigerRecordStoreCursorBase::seekNear(const RecordId& start) {
+    _skipNextAdvance = false;
+    _lastReturnedId = RecordId();
+    _eof = false;
+
+    WT_CURSOR* c = _cursor->get();
+    setKey(c, start);
+    int cmp;
+    // Nothing after the next line can throw WCEs.
+    int ret = WT_READ_CHECK(c->search_near(c, &cmp));
+    if (ret == WT_NOTFOUND) {
+        _eof = true;
+        return;
+    }
+    invariantWTOK(ret);
+
+    // If the cursor landed on the wrong side of 'start', the next call to next() moves past it.
+    // Otherwise next() returns the record it landed on.
+    if (cmp == 0 || (_forward && cmp > 0) || (!_forward && cmp < 0)) {
+        _skipNextAdvance = true;
+    }
+}
+
 void WiredTigerRecordStoreCursorBase::save() {
     try {
         if (_cursor)
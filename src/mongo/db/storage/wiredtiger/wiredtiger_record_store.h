@@ -39,6 +39,7 @@
 #include "mongo/db/storage/capped_callback.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_field_name_dictionary.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/platform/atomic_word.h"
@@ -110,8 +111,25 @@ public:
         CappedCallback* cappedCallback;
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
+        // Null unless records are stored with their field names replaced by dictionary ids.
+        std::shared_ptr<const WiredTigerFieldNameDictionary> fieldNameDictionary;
+        // True if records are keyed by their _id rather than by a generated RecordId.
+        bool clusteredOnId = false;
     };
 
+    /**
+     * Name of the collection option that keys records by their _id, which must then be a positive
+     * 32 or 64-bit integer. The _id index of such a collection is a WiredTigerClusteredIdIndex
+     * over this record store rather than a table of its own.
+     */
+    static const char kClusteredOnIdOptionName[];
+
+    /**
+     * Returns the RecordId that 'doc' is stored under in a record store clustered on _id, or
+     * BadValue if its _id is not a positive integer.
+     */
+    static StatusWith<RecordId> extractClusteredId(const BSONObj& doc);
+
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
 
     virtual ~WiredTigerRecordStore();
@@ -239,6 +257,10 @@ public:
         return _tableId;
     }
 
+    bool isClusteredOnId() const {
+        return _clusteredOnId;
+    }
+
     void setSizeStorer(WiredTigerSizeStorer* ss) {
         _sizeStorer = ss;
     }
@@ -294,6 +316,18 @@ private:
     void _increaseDataSize(OperationContext* opCtx, int64_t amount);
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
+    /**
+     * Returns the record stored in 'value', decoding it if this record store uses a field name
+     * dictionary. The result is only valid as long as 'value' is, unless it is owned. Fails with
+     * InvalidBSON if the record is corrupt and cannot be decoded.
+     */
+    StatusWith<RecordData> _decodeRecordData(const WT_ITEM& value) const;
+
+    /**
+     * Like _decodeRecordData, but throws if the record cannot be decoded.
+     */
+    RecordData _toRecordData(const WT_ITEM& value) const;
+
 
     const std::string _uri;
     const uint64_t _tableId;  // not persisted
@@ -326,9 +360,19 @@ private:
 
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
     int _sizeStorerCounter;
+    // Whether count changes are written to the size storer's delta table, which keeps them exact
+    // across unclean shutdowns. Set by postConstructorInit(), except for ephemeral record stores,
+    // which do not outlive the process and whose engine runs no thread to fold the delta table.
+    bool _trackSizeDeltas = false;
 
     WiredTigerKVEngine* _kvEngine;  // not owned.
 
+    // Non-null if records are stored encoded with a field name dictionary.
+    const std::shared_ptr<const WiredTigerFieldNameDictionary> _fieldNameDictionary;
+
+    // True if records are keyed by their _id.
+    const bool _clusteredOnId;
+
     // Non-null if this record store is underlying the active oplog.
     std::shared_ptr<OplogStones> _oplogStones;
 };
@@ -388,6 +432,12 @@ public:
 
     boost::optional<Record> seekExact(const RecordId& id);
 
+    /**
+     * Positions the cursor so that next() returns the first record at or after 'start' in the
+     * direction of the cursor.
+     */
+    void seekNear(const RecordId& start);
+
     void save();
 
     void saveUnpositioned();
@@ -398,6 +448,31 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx);
 
+    /**
+     * Returns the size of the value WiredTiger stores for the record last returned by next() or
+     * seekExact(). This is the size record store statistics account for, and it is smaller than
+     * the returned record when the record store uses a field name dictionary.
+     */
+    int64_t storedSizeOfLastReturned() const {
+        return _lastReturnedStoredSize;
+    }
+
+    /**
+     * Makes next() and seekExact() return records that cannot be decoded as stored rather than
+     * throw, so that callers that scan the whole collection can account for them and carry on.
+     * Such callers must check decodeStatusOfLastReturned() before using the returned data.
+     */
+    void returnUndecodableRecords() {
+        _returnUndecodableRecords = true;
+    }
+
+    /**
+     * Returns whether the record last returned by next() or seekExact() could be decoded.
+     */
+    const Status& decodeStatusOfLastReturned() const {
+        return _lastReturnedDecodeStatus;
+    }
+
 protected:
     virtual RecordId getKey(WT_CURSOR* cursor) const = 0;
 
@@ -424,9 +499,14 @@ protected:
     boost::optional<WiredTigerCursor> _cursor;
     bool _eof = false;
     RecordId _lastReturnedId;  // If null, need to seek to first/last record.
+    int64_t _lastReturnedStoredSize = 0;
+    Status _lastReturnedDecodeStatus = Status::OK();
+    bool _returnUndecodableRecords = false;
 
 private:
     bool isVisible(const RecordId& id);
+
+    RecordData _decodeLastReturned(const WT_ITEM& value);
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
@@ -36,6 +36,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cache_warmer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -225,6 +226,7 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
     _active = false;
     _mySnapshotId = nextSnapshotId.fetchAndAdd(1);
     _isOplogReader = false;
+    _sizeDeltaSeq = 0;
 }
 
 SnapshotId WiredTigerRecoveryUnit::getSnapshotId() const {
@@ -349,6 +351,7 @@ WiredTigerCursor::WiredTigerCursor(const std::string& uri,
     if (!_cursor) {
         error() << "no cursor for uri: " << uri;
     }
+    WiredTigerCacheWarmer::recordAccess(uri);
 }
 
 WiredTigerCursor::~WiredTigerCursor() {
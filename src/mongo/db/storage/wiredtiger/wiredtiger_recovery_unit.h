@@ -127,6 +127,17 @@ public:
 
     static void appendGlobalStats(BSONObjBuilder& b);
 
+    /**
+     * The sequence number under which the current transaction writes its changes to the size
+     * storer's delta table, or 0 if it has not written any. Reset when the transaction ends.
+     */
+    uint64_t getSizeDeltaSeq() const {
+        return _sizeDeltaSeq;
+    }
+    void setSizeDeltaSeq(uint64_t seq) {
+        _sizeDeltaSeq = seq;
+    }
+
     /**
      * Prepares this RU to be the basis for a named snapshot.
      *
@@ -159,6 +170,7 @@ private:
     Timestamp _readAtTimestamp;
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
+    uint64_t _sizeDeltaSeq = 0;
     typedef std::vector<std::unique_ptr<Change>> Changes;
     Changes _changes;
 };
@@ -36,17 +36,107 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/mongod_options.h"
 #include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
+namespace {
+
+const int kMaxJournalCommitDelayMicros = 100 * 1000;
+
+AtomicInt32 journalCommitDelayMicros(0);
+
+/**
+ * Specify an integer between 0 and kMaxJournalCommitDelayMicros signifying how long, in
+ * microseconds, the journal flusher waits for more writers to join a requested journal flush.
+ */
+class JournalCommitDelaySetting
+    : public ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> {
+public:
+    JournalCommitDelaySetting()
+        : ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "wiredTigerJournalCommitDelayMicros",
+              &journalCommitDelayMicros) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        if (potentialNewValue < 0 || potentialNewValue > kMaxJournalCommitDelayMicros) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "wiredTigerJournalCommitDelayMicros must be between "
+                                        << 0
+                                        << " and "
+                                        << kMaxJournalCommitDelayMicros
+                                        << ", but attempted to set to: "
+                                        << potentialNewValue);
+        }
+
+        return Status::OK();
+    }
+} journalCommitDelaySetting;
+
+/**
+ * Group commit counters. Batch sizes are bucketed by powers of two: bucket i counts the flushes
+ * that covered between 2^i and 2^(i+1) - 1 waiters, and the last bucket everything above.
+ */
+const int kNumBatchSizeBuckets = 8;
+
+struct GroupCommitStats {
+    AtomicUInt64 flushes;
+    AtomicUInt64 requestedFlushes;
+    AtomicUInt64 waitersCovered;
+    AtomicUInt64 maxBatchSize;
+    AtomicUInt64 totalFlushMicros;
+    AtomicUInt64 batchSizes[kNumBatchSizeBuckets];
+} groupCommitStats;
+
+void recordGroupCommit(uint64_t batchSize, long long flushMicros) {
+    groupCommitStats.flushes.fetchAndAdd(1);
+    groupCommitStats.totalFlushMicros.fetchAndAdd(flushMicros);
+    if (batchSize == 0) {
+        return;
+    }
+
+    groupCommitStats.requestedFlushes.fetchAndAdd(1);
+    groupCommitStats.waitersCovered.fetchAndAdd(batchSize);
+    if (batchSize > groupCommitStats.maxBatchSize.load()) {
+        // Only the journal flusher thread records batches, so there is no race to lose here.
+        groupCommitStats.maxBatchSize.store(batchSize);
+    }
+
+    int bucket = 0;
+    while (bucket < kNumBatchSizeBuckets - 1 && (batchSize >> (bucket + 1)) != 0) {
+        ++bucket;
+    }
+    groupCommitStats.batchSizes[bucket].fetchAndAdd(1);
+}
+
+AtomicUInt32 nextHomeCachePartition;
+thread_local int homeCachePartitionForThread = -1;
+
+/**
+ * Returns the session cache partition this thread releases sessions to. Threads are assigned
+ * partitions round-robin the first time they ask, so that they spread evenly over partitions.
+ */
+size_t homeCachePartition(size_t numPartitions) {
+    if (homeCachePartitionForThread < 0) {
+        homeCachePartitionForThread = nextHomeCachePartition.fetchAndAdd(1) % numPartitions;
+    }
+    return homeCachePartitionForThread;
+}
+
+}  // namespace
 
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
@@ -238,6 +328,23 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         return;
     }
 
+    {
+        stdx::unique_lock<stdx::mutex> lk(_groupCommitMutex);
+        if (_groupCommitEnabled) {
+            // Any flush that has already started may have missed our writes, so wait for the
+            // next one.
+            const uint64_t target = _flushesStarted + 1;
+            ++_pendingFlushWaiters;
+            _flushRequested.notify_one();
+            _flushCompleted.wait(
+                lk, [&] { return _flushesCompleted >= target || !_groupCommitEnabled; });
+            if (_flushesCompleted >= target) {
+                return;
+            }
+            // Group commit was disabled before a flush covered us, so flush on our own.
+        }
+    }
+
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -247,9 +354,94 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
-    _lastSyncTime.store(current + 1);
 
     // Nobody has synched yet, so we have to sync ourselves.
+    _flushJournal_inlock();
+}
+
+void WiredTigerSessionCache::groupCommit(Milliseconds interval) {
+    if (isEphemeral()) {
+        return;
+    }
+
+    const int shuttingDown = _shuttingDown.fetchAndAdd(1);
+    ON_BLOCK_EXIT([this] { _shuttingDown.fetchAndSubtract(1); });
+
+    uassert(ErrorCodes::ShutdownInProgress,
+            "Cannot flush the journal because a shutdown is in progress",
+            !(shuttingDown & kShuttingDownMask));
+
+    stdx::unique_lock<stdx::mutex> lk(_groupCommitMutex);
+    {
+        MONGO_IDLE_THREAD_BLOCK;
+        _flushRequested.wait_for(lk, interval.toSystemDuration(), [&] {
+            return _pendingFlushWaiters > 0 || !_groupCommitEnabled;
+        });
+    }
+    if (!_groupCommitEnabled) {
+        return;
+    }
+
+    // Give concurrent writers the chance to join the batch before flushing for the first waiter.
+    const Microseconds delay(journalCommitDelayMicros.load());
+    if (_pendingFlushWaiters > 0 && delay > Microseconds(0)) {
+        _flushRequested.wait_for(
+            lk, delay.toSystemDuration(), [&] { return !_groupCommitEnabled; });
+    }
+
+    const uint64_t batchSize = _pendingFlushWaiters;
+    _pendingFlushWaiters = 0;
+    const uint64_t flush = ++_flushesStarted;
+    lk.unlock();
+
+    Timer timer;
+    {
+        stdx::lock_guard<stdx::mutex> syncLk(_lastSyncMutex);
+        _flushJournal_inlock();
+    }
+    recordGroupCommit(batchSize, timer.micros());
+
+    lk.lock();
+    _flushesCompleted = flush;
+    _flushCompleted.notify_all();
+}
+
+void WiredTigerSessionCache::setGroupCommitEnabled(bool enabled) {
+    stdx::lock_guard<stdx::mutex> lk(_groupCommitMutex);
+    _groupCommitEnabled = enabled;
+    _pendingFlushWaiters = 0;
+    _flushRequested.notify_all();
+    _flushCompleted.notify_all();
+}
+
+void WiredTigerSessionCache::appendGroupCommitStats(BSONObjBuilder* builder) {
+    builder->append("flushes", static_cast<long long>(groupCommitStats.flushes.load()));
+    builder->append("requestedFlushes",
+                    static_cast<long long>(groupCommitStats.requestedFlushes.load()));
+    builder->append("waitersCovered",
+                    static_cast<long long>(groupCommitStats.waitersCovered.load()));
+    builder->append("maxBatchSize", static_cast<long long>(groupCommitStats.maxBatchSize.load()));
+    builder->append("totalFlushMicros",
+                    static_cast<long long>(groupCommitStats.totalFlushMicros.load()));
+
+    BSONObjBuilder batchSizes(builder->subobjStart("batchSizes"));
+    for (int i = 0; i < kNumBatchSizeBuckets; ++i) {
+        const uint64_t low = 1ULL << i;
+        str::stream name;
+        name << low;
+        if (i == kNumBatchSizeBuckets - 1) {
+            name << "+";
+        } else if (low > 1) {
+            name << "-" << ((low << 1) - 1);
+        }
+        batchSizes.append(std::string(name),
+                          static_cast<long long>(groupCommitStats.batchSizes[i].load()));
+    }
+    batchSizes.done();
+}
+
+void WiredTigerSessionCache::_flushJournal_inlock() {
+    _lastSyncTime.store(_lastSyncTime.loadRelaxed() + 1);
 
     // This gets the token (OpTime) from the last write, before flushing (either the journal, or a
     // checkpoint), and then reports that token (OpTime) as a durable write.
@@ -262,6 +454,13 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
             _conn->open_session(_conn, NULL, "isolation=snapshot", &_waitUntilDurableSession));
     }
 
+    // Tell the oplog manager how much of the oplog this flush makes durable.
+    WiredTigerOplogManager* oplogManager = _engine ? _engine->getOplogManager() : nullptr;
+    WiredTigerOplogManager::JournalFlushMark oplogMark;
+    if (oplogManager) {
+        oplogMark = oplogManager->beginJournalFlush(_conn);
+    }
+
     // Use the journal when available, or a checkpoint otherwise.
     if (_engine && _engine->isDurable()) {
         invariantWTOK(_waitUntilDurableSession->log_flush(_waitUntilDurableSession, "sync=on"));
@@ -271,12 +470,18 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         LOG(4) << "created checkpoint";
     }
     _journalListener->onDurable(token);
+
+    if (oplogManager) {
+        oplogManager->endJournalFlush(oplogMark);
+    }
 }
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (auto session : partition.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -284,24 +489,31 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (auto session : partition.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. A session released
+    // concurrently checks the epoch under its partition's lock, so it is either already cached
+    // and swapped out below, or sees the new epoch and is deleted by releaseSession.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
-    }
+    SessionCache swap;
+    for (auto& partition : _partitions) {
+        {
+            stdx::lock_guard<stdx::mutex> lock(partition.lock);
+            partition.sessions.swap(swap);
+        }
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+        for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
+            delete (*i);
+        }
+        swap.clear();
     }
 }
 
@@ -314,13 +526,22 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+    // Get the most recently used session so that if we discard sessions, we're discarding older
+    // ones. Prefer this thread's home partition, whose sessions are most likely to have the
+    // cursors it needs already open, then take one from any partition that is not busy.
+    const size_t home = homeCachePartition(kNumCachePartitions);
+    for (size_t i = 0; i < kNumCachePartitions; i++) {
+        CachePartition& partition = _partitions[(home + i) % kNumCachePartitions];
+        stdx::unique_lock<stdx::mutex> lock(partition.lock, stdx::defer_lock);
+        if (i == 0) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            continue;
+        }
+
+        if (!partition.sessions.empty()) {
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -369,10 +590,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     uint64_t currentEpoch = _epoch.load();
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        CachePartition& partition = _partitions[homeCachePartition(kNumCachePartitions)];
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -39,11 +39,14 @@
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -194,9 +197,34 @@ public:
      * Waits until all commits that happened before this call are durable, either by flushing
      * the log or forcing a checkpoint if forceCheckpoint is true or the journal is disabled.
      * Uses a temporary session. Safe to call without any locks, even during shutdown.
+     *
+     * While group commit is enabled, a log flush is not done by the caller but by the thread
+     * running groupCommit(), which covers every caller waiting at the time with a single flush.
      */
     void waitUntilDurable(bool forceCheckpoint, bool stableCheckpoint);
 
+    /**
+     * Performs one group commit round. Called in a loop by the journal flusher thread.
+     *
+     * Waits up to 'interval' for a caller of waitUntilDurable() to ask for a flush, then waits up
+     * to 'wiredTigerJournalCommitDelayMicros' for more callers to join the batch, flushes the
+     * journal once and wakes up every caller covered by that flush. Flushes even when nobody
+     * asked once 'interval' has passed, so that writes without j:true still reach the journal.
+     */
+    void groupCommit(Milliseconds interval);
+
+    /**
+     * Routes waitUntilDurable() log flushes through groupCommit() when 'enabled' is true. Must
+     * only be enabled while a thread is calling groupCommit(). Disabling it makes waiters that
+     * have not been covered yet flush on their own, and makes groupCommit() return right away.
+     */
+    void setGroupCommitEnabled(bool enabled);
+
+    /**
+     * Appends the group commit counters and the histogram of flush batch sizes.
+     */
+    static void appendGroupCommitStats(BSONObjBuilder* builder);
+
     WT_CONNECTION* conn() const {
         return _conn;
     }
@@ -229,9 +257,20 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    /**
+     * Idle sessions are cached in partitions that each have their own lock. Every thread is
+     * assigned a home partition that it releases sessions to and looks in first, so that it
+     * tends to get back a session whose cursors are already open on the tables it uses, and
+     * threads with different home partitions never contend.
+     */
+    struct CachePartition {
+        stdx::mutex lock;
+        SessionCache sessions;
+    };
+    static const size_t kNumCachePartitions = 32;
+    CachePartition _partitions[kNumCachePartitions];
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -251,6 +290,22 @@ private:
     WT_SESSION* _waitUntilDurableSession = nullptr;  // owned, and never explicitly closed
                                                      // (uses connection close to clean up)
 
+    // Group commit state, all protected by _groupCommitMutex. A waiter is covered once
+    // _flushesCompleted reaches the value _flushesStarted will have when the next flush starts.
+    stdx::mutex _groupCommitMutex;
+    stdx::condition_variable _flushRequested;  // signaled to wake up the groupCommit() thread
+    stdx::condition_variable _flushCompleted;  // signaled to wake up the waiters
+    bool _groupCommitEnabled = false;
+    uint64_t _flushesStarted = 0;
+    uint64_t _flushesCompleted = 0;
+    uint64_t _pendingFlushWaiters = 0;  // waiters not yet covered by a started flush
+
+    /**
+     * Flushes the journal, or takes a checkpoint if the journal is disabled, and reports the
+     * flushed writes as durable to the journal listener. Caller must hold _lastSyncMutex.
+     */
+    void _flushJournal_inlock();
+
     /**
      * Returns a session to the cache for later reuse. If closeAll was called between getting this
      * session and releasing it, the session is directly released. This method is thread safe.
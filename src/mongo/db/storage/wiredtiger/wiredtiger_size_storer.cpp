@@ -33,6 +33,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <vector>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -55,11 +58,17 @@ namespace {
 int MAGIC = 123123;
 }
 
+const size_t WiredTigerSizeStorer::kMaxDeltasFoldedPerBatch;
+
 WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
                                            const std::string& storageUri,
                                            bool logSizeStorerTable,
                                            bool readOnly)
-    : _session(conn) {
+    : _readOnly(readOnly),
+      _session(conn),
+      _deltasUri(getDeltasUri(storageUri)),
+      _deltasTableId(WiredTigerSession::genTableId()),
+      _nextDeltaSeq(1) {
     WT_SESSION* session = _session.getSession();
 
     std::string config = WiredTigerCustomizationHooks::get(getGlobalServiceContext())
@@ -72,6 +81,11 @@ WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
         }
         uassertStatusOK(
             WiredTigerUtil::setTableLogging(session, storageUri.c_str(), logSizeStorerTable));
+
+        // The delta table is written in the same transactions as the record stores, whose tables
+        // are always logged, so it must be logged too for the two to agree after a crash.
+        const std::string deltasConfig = config + ",key_format=Sq,value_format=qq";
+        invariantWTOK(session->create(session, _deltasUri.c_str(), deltasConfig.c_str()));
     }
 
     invariantWTOK(
@@ -175,6 +189,38 @@ void WiredTigerSizeStorer::fillCache() {
         }
     }
 
+    // Counts kept in the delta table are exact, so they replace the periodically stored ones. A
+    // read-only size storer may predate the delta table.
+    WT_SESSION* session = _session.getSession();
+    WT_CURSOR* deltas = NULL;
+    int ret = session->open_cursor(session, _deltasUri.c_str(), NULL, NULL, &deltas);
+    if (ret != ENOENT) {
+        invariantWTOK(ret);
+        ON_BLOCK_EXIT(deltas->close, deltas);
+
+        int64_t maxSeq = 0;
+        while ((ret = deltas->next(deltas)) == 0) {
+            const char* uri;
+            int64_t seq;
+            int64_t numRecords;
+            int64_t dataSize;
+            invariantWTOK(deltas->get_key(deltas, &uri, &seq));
+            invariantWTOK(deltas->get_value(deltas, &numRecords, &dataSize));
+
+            Entry& e = m[uri];
+            if (!e.tracked) {
+                e.numRecords = 0;
+                e.dataSize = 0;
+                e.tracked = true;
+            }
+            e.numRecords += numRecords;
+            e.dataSize += dataSize;
+            maxSeq = std::max(maxSeq, seq);
+        }
+        invariant(ret == WT_NOTFOUND);
+        _nextDeltaSeq.store(maxSeq + 1);
+    }
+
     stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
     _entries.swap(m);
 }
@@ -246,4 +292,264 @@ void WiredTigerSizeStorer::syncCache(bool syncToDisk) {
         }
     }
 }
+
+// static
+std::string WiredTigerSizeStorer::getDeltasUri(const std::string& storageUri) {
+    return storageUri + "Deltas";
+}
+
+bool WiredTigerSizeStorer::trackDeltas(WiredTigerRecordStore* rs) {
+    _checkMagic();
+    if (_readOnly) {
+        return false;
+    }
+
+    stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
+    {
+        stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
+        if (_entries[rs->getURI()].tracked) {
+            return true;
+        }
+    }
+
+    // Nothing writes deltas for a record store before this returns, so its counts cannot change
+    // while they are seeded.
+    _resetDeltas_inlock(rs->getURI(), rs->numRecords(NULL), rs->dataSize(NULL));
+    return true;
+}
+
+void WiredTigerSizeStorer::recordDelta(OperationContext* opCtx,
+                                       const std::string& uri,
+                                       long long numRecords,
+                                       long long dataSize) {
+    WiredTigerRecoveryUnit* ru = WiredTigerRecoveryUnit::get(opCtx);
+    int64_t seq = ru->getSizeDeltaSeq();
+    if (seq == 0) {
+        seq = _nextDeltaSeq.fetchAndAdd(1);
+        ru->setSizeDeltaSeq(seq);
+    }
+
+    WiredTigerCursor curwrap(_deltasUri, _deltasTableId, true, opCtx);
+    curwrap.assertInActiveTxn();
+    WT_CURSOR* c = curwrap.get();
+    invariant(c);
+
+    // Only this transaction writes this row, so adding to it cannot conflict.
+    c->set_key(c, uri.c_str(), seq);
+    int ret = WT_READ_CHECK(c->search(c));
+    if (ret == 0) {
+        int64_t prevNumRecords;
+        int64_t prevDataSize;
+        invariantWTOK(c->get_value(c, &prevNumRecords, &prevDataSize));
+        numRecords += prevNumRecords;
+        dataSize += prevDataSize;
+    } else if (ret != WT_NOTFOUND) {
+        invariantWTOK(ret);
+    }
+
+    c->set_key(c, uri.c_str(), seq);
+    c->set_value(c, static_cast<int64_t>(numRecords), static_cast<int64_t>(dataSize));
+    invariantWTOK(WT_OP_CHECK(c->insert(c)));
+}
+
+void WiredTigerSizeStorer::resetDeltas(const std::string& uri,
+                                       long long numRecords,
+                                       long long dataSize) {
+    _checkMagic();
+    invariant(!_readOnly);
+    stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
+    _resetDeltas_inlock(uri, numRecords, dataSize);
+}
+
+void WiredTigerSizeStorer::_resetDeltas_inlock(const std::string& uri,
+                                               long long numRecords,
+                                               long long dataSize) {
+    WT_SESSION* session = _session.getSession();
+    WT_CURSOR* c = NULL;
+    invariantWTOK(session->open_cursor(session, _deltasUri.c_str(), NULL, NULL, &c));
+    ON_BLOCK_EXIT(c->close, c);
+
+    invariantWTOK(session->begin_transaction(session, NULL));
+    ScopeGuard rollbacker = MakeGuard(session->rollback_transaction, session, "");
+
+    _removeDeltaRows(c, uri);
+
+    c->set_key(c, uri.c_str(), int64_t(0));
+    c->set_value(c, static_cast<int64_t>(numRecords), static_cast<int64_t>(dataSize));
+    invariantWTOK(c->insert(c));
+
+    rollbacker.Dismiss();
+    invariantWTOK(session->commit_transaction(session, NULL));
+
+    stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
+    _entries[uri].tracked = true;
+}
+
+void WiredTigerSizeStorer::removeDeltas(const std::string& uri) {
+    _checkMagic();
+    if (_readOnly) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
+    WT_SESSION* session = _session.getSession();
+    WT_CURSOR* c = NULL;
+    invariantWTOK(session->open_cursor(session, _deltasUri.c_str(), NULL, NULL, &c));
+    ON_BLOCK_EXIT(c->close, c);
+
+    invariantWTOK(session->begin_transaction(session, NULL));
+    ScopeGuard rollbacker = MakeGuard(session->rollback_transaction, session, "");
+
+    _removeDeltaRows(c, uri);
+
+    rollbacker.Dismiss();
+    invariantWTOK(session->commit_transaction(session, NULL));
+
+    stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
+    auto it = _entries.find(uri);
+    if (it != _entries.end()) {
+        it->second.tracked = false;
+    }
+}
+
+void WiredTigerSizeStorer::_removeDeltaRows(WT_CURSOR* c, const std::string& uri) {
+    // The rows for 'uri' start at sequence number 0.
+    std::vector<int64_t> seqs;
+    c->set_key(c, uri.c_str(), int64_t(0));
+    int exact;
+    int ret = c->search_near(c, &exact);
+    if (ret == 0 && exact < 0) {
+        ret = c->next(c);
+    }
+    for (; ret == 0; ret = c->next(c)) {
+        const char* key;
+        int64_t seq;
+        invariantWTOK(c->get_key(c, &key, &seq));
+        if (uri != key) {
+            break;
+        }
+        seqs.push_back(seq);
+    }
+    if (ret != WT_NOTFOUND) {
+        invariantWTOK(ret);
+    }
+
+    for (int64_t seq : seqs) {
+        c->set_key(c, uri.c_str(), seq);
+        invariantWTOK(c->remove(c));
+    }
+}
+
+bool WiredTigerSizeStorer::compactDeltas(size_t maxDeltas) {
+    _checkMagic();
+    if (_readOnly) {
+        return false;
+    }
+
+    stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
+    WT_SESSION* session = _session.getSession();
+    WT_CURSOR* c = NULL;
+    invariantWTOK(session->open_cursor(session, _deltasUri.c_str(), NULL, NULL, &c));
+    ON_BLOCK_EXIT(c->close, c);
+
+    invariantWTOK(session->begin_transaction(session, NULL));
+    ScopeGuard rollbacker = MakeGuard(session->rollback_transaction, session, "");
+
+    // Continue after the last row the previous batch looked at, which it may have removed.
+    int ret;
+    if (_foldResumeUri.empty()) {
+        ret = c->next(c);
+    } else {
+        c->set_key(c, _foldResumeUri.c_str(), _foldResumeSeq);
+        int exact;
+        ret = c->search_near(c, &exact);
+        if (ret == 0 && exact <= 0) {
+            ret = c->next(c);
+        }
+    }
+
+    // Rows written by transactions that have not committed yet are not visible here, and are
+    // left for a later pass.
+    struct Folded {
+        bool haveBase = false;
+        int64_t numRecords = 0;
+        int64_t dataSize = 0;
+        std::vector<int64_t> seqs;
+    };
+    std::map<std::string, Folded> folded;
+    size_t numFolded = 0;
+    for (; ret == 0; ret = c->next(c)) {
+        const char* uri;
+        int64_t seq;
+        int64_t numRecords;
+        int64_t dataSize;
+        invariantWTOK(c->get_key(c, &uri, &seq));
+        invariantWTOK(c->get_value(c, &numRecords, &dataSize));
+
+        Folded& f = folded[uri];
+        f.numRecords += numRecords;
+        f.dataSize += dataSize;
+        if (seq == 0) {
+            f.haveBase = true;
+        } else {
+            f.seqs.push_back(seq);
+            numFolded++;
+        }
+
+        if (numFolded == maxDeltas) {
+            _foldResumeUri = uri;
+            _foldResumeSeq = seq;
+            break;
+        }
+    }
+    if (ret == WT_NOTFOUND) {
+        // The next batch starts over, and finds the rows committed behind this one.
+        _foldResumeUri.clear();
+        _foldResumeSeq = 0;
+    } else {
+        invariantWTOK(ret);
+    }
+
+    if (numFolded == 0) {
+        return false;
+    }
+
+    for (auto& entry : folded) {
+        Folded& f = entry.second;
+        if (f.seqs.empty()) {
+            continue;
+        }
+
+        const char* uri = entry.first.c_str();
+        if (!f.haveBase) {
+            // The batch started in the middle of this record store's rows, after its base row.
+            c->set_key(c, uri, int64_t(0));
+            ret = c->search(c);
+            if (ret == 0) {
+                int64_t numRecords;
+                int64_t dataSize;
+                invariantWTOK(c->get_value(c, &numRecords, &dataSize));
+                f.numRecords += numRecords;
+                f.dataSize += dataSize;
+            } else if (ret != WT_NOTFOUND) {
+                invariantWTOK(ret);
+            }
+        }
+
+        for (int64_t seq : f.seqs) {
+            c->set_key(c, uri, seq);
+            invariantWTOK(c->remove(c));
+        }
+        c->set_key(c, uri, int64_t(0));
+        c->set_value(c, f.numRecords, f.dataSize);
+        invariantWTOK(c->insert(c));
+    }
+
+    rollbacker.Dismiss();
+    invariantWTOK(session->commit_transaction(session, NULL));
+
+    LOG(2) << "WiredTigerSizeStorer folded " << numFolded << " deltas of " << folded.size()
+           << " record stores";
+    return numFolded == maxDeltas;
+}
 }
@@ -37,15 +37,31 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
+class OperationContext;
 class WiredTigerRecordStore;
 class WiredTigerSession;
 
+/**
+ * Persists the number of records and data size of each record store.
+ *
+ * The values in the cache are written to the storage table periodically, so they can lag behind
+ * the record stores after an unclean shutdown. Record stores that call trackDeltas() are also
+ * counted exactly in a second, delta table: every transaction that changes their counts writes
+ * the change there, and a background thread calls compactDeltas() to fold the changes into one
+ * row per record store. At startup fillCache() prefers the sum of those rows over the storage
+ * table.
+ */
 class WiredTigerSizeStorer {
 public:
+    // Bounds the size of each transaction that folds the delta table, and so how long
+    // compactDeltas() holds up trackDeltas(), resetDeltas() and syncCache().
+    static const size_t kMaxDeltasFoldedPerBatch = 10000;
+
     WiredTigerSizeStorer(WT_CONNECTION* conn,
                          const std::string& storageUri,
                          const bool isWiredTigerLoggingEnabled,
@@ -69,24 +85,91 @@ public:
      */
     void syncCache(bool syncToDisk);
 
+    /**
+     * Folds up to 'maxDeltas' committed rows of the delta table into their record stores' base
+     * rows in one transaction, continuing from where the previous call stopped. Returns true if
+     * it stopped at the limit, in which case more rows may be waiting. Meant to be called from a
+     * background thread.
+     */
+    bool compactDeltas(size_t maxDeltas = kMaxDeltasFoldedPerBatch);
+
+    /**
+     * Starts counting 'rs' in the delta table, seeding it with the current counts of 'rs' unless
+     * they are already tracked there. Returns false if the size storer is read-only, in which
+     * case the caller must not call recordDelta().
+     */
+    bool trackDeltas(WiredTigerRecordStore* rs);
+
+    /**
+     * Adds a change to the counts of the record store at 'uri' to the WiredTiger transaction of
+     * 'opCtx', so that it becomes durable if and only if the transaction commits.
+     */
+    void recordDelta(OperationContext* opCtx,
+                     const std::string& uri,
+                     long long numRecords,
+                     long long dataSize);
+
+    /**
+     * Replaces the counts tracked for 'uri' in the delta table, after a repair or validation has
+     * counted the records.
+     */
+    void resetDeltas(const std::string& uri, long long numRecords, long long dataSize);
+
+    /**
+     * Removes all rows for 'uri' from the delta table, once the record store has been dropped.
+     */
+    void removeDeltas(const std::string& uri);
+
+    /**
+     * Returns the URI of the delta table that goes with the storage table at 'storageUri'.
+     */
+    static std::string getDeltasUri(const std::string& storageUri);
+
 private:
     void _checkMagic() const;
 
+    /**
+     * Replaces all rows for 'uri' in the delta table with one holding the given counts. Must be
+     * called with _cursorMutex held.
+     */
+    void _resetDeltas_inlock(const std::string& uri, long long numRecords, long long dataSize);
+
+    /**
+     * Removes all rows for 'uri' using the delta table cursor 'c', in the caller's transaction.
+     */
+    void _removeDeltaRows(WT_CURSOR* c, const std::string& uri);
+
+
     struct Entry {
-        Entry() : numRecords(0), dataSize(0), dirty(false), rs(NULL) {}
+        Entry() : numRecords(0), dataSize(0), dirty(false), tracked(false), rs(NULL) {}
         long long numRecords;
         long long dataSize;
         bool dirty;
+        bool tracked;               // counted in the delta table
         WiredTigerRecordStore* rs;  // not owned
     };
 
     int _magic;
 
-    // Guards _cursor. Acquire *before* _entriesMutex.
+    const bool _readOnly;
+
+    // Guards _cursor and all use of _session. Acquire *before* _entriesMutex.
     mutable stdx::mutex _cursorMutex;
     const WiredTigerSession _session;
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
+    // Rows of the delta table are keyed by (record store URI, sequence number). Sequence number 0
+    // holds the folded counts, and every transaction writes its changes under a number of its own
+    // so that concurrent writers never conflict.
+    const std::string _deltasUri;
+    const uint64_t _deltasTableId;
+    AtomicWord<unsigned long long> _nextDeltaSeq;
+
+    // The last row compactDeltas() looked at, after which the next call continues. An empty URI
+    // means it starts from the beginning of the table. Guarded by _cursorMutex.
+    std::string _foldResumeUri;
+    int64_t _foldResumeSeq = 0;
+
     typedef std::map<std::string, Entry> Map;
     Map _entries;
     mutable stdx::mutex _entriesMutex;
@@ -28,6 +28,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cmath>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -43,6 +44,8 @@
 #include "mongo/db/storage/kv/kv_engine_test_harness.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_clustered_id_index.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_field_name_dictionary.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
@@ -90,14 +93,39 @@ public:
     }
 
     virtual std::unique_ptr<RecordStore> newNonCappedRecordStore(const std::string& ns) {
+        return newNonCappedRecordStore(ns, BSONObj());
+    }
+
+    std::unique_ptr<RecordStore> newClusteredRecordStore(const std::string& ns) {
+        return newNonCappedRecordStore(
+            ns, BSON(WiredTigerRecordStore::kClusteredOnIdOptionName << true));
+    }
+
+    std::unique_ptr<RecordStore> newFieldNameDictionaryRecordStore(const std::string& ns,
+                                                                   const BSONArray& names) {
+        return newNonCappedRecordStore(ns,
+                                       BSON(WiredTigerFieldNameDictionary::kOptionName << names));
+    }
+
+    /**
+     * Creates a record store configured with the given storageEngine.wiredTiger collection
+     * options.
+     */
+    std::unique_ptr<RecordStore> newNonCappedRecordStore(const std::string& ns,
+                                                         const BSONObj& wiredTigerOptions) {
         WiredTigerRecoveryUnit* ru =
             dynamic_cast<WiredTigerRecoveryUnit*>(_engine.newRecoveryUnit());
         OperationContextNoop opCtx(ru);
         string uri = "table:" + ns;
 
+        CollectionOptions options;
+        if (!wiredTigerOptions.isEmpty()) {
+            options.storageEngine = BSON(kWiredTigerEngineName << wiredTigerOptions);
+        }
+
         const bool prefixed = false;
         StatusWith<std::string> result = WiredTigerRecordStore::generateCreateString(
-            kWiredTigerEngineName, ns, CollectionOptions(), "", prefixed);
+            kWiredTigerEngineName, ns, options, "", prefixed);
         ASSERT_TRUE(result.isOK());
         std::string config = result.getValue();
 
@@ -118,6 +146,9 @@ public:
         params.cappedMaxDocs = -1;
         params.cappedCallback = nullptr;
         params.sizeStorer = nullptr;
+        params.clusteredOnId =
+            wiredTigerOptions.getBoolField(WiredTigerRecordStore::kClusteredOnIdOptionName);
+        params.fieldNameDictionary = WiredTigerFieldNameDictionary::fromOptions(wiredTigerOptions);
 
         auto ret = stdx::make_unique<StandardWiredTigerRecordStore>(&_engine, &opCtx, params);
         ret->postConstructorInit(&opCtx);
@@ -296,6 +327,166 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(NULL);  // this has to be deleted before ss
 }
 
+// Reopens the record store at 'uri' with a size storer, which starts tracking its counts.
+unique_ptr<RecordStore> openWithSizeStorer(WiredTigerHarnessHelper* harnessHelper,
+                                           const string& uri,
+                                           WiredTigerSizeStorer* sizeStorer) {
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    WiredTigerRecordStore::Params params;
+    params.ns = "a.b"_sd;
+    params.uri = uri;
+    params.engineName = kWiredTigerEngineName;
+    params.isCapped = false;
+    params.isEphemeral = false;
+    params.cappedMaxSize = -1;
+    params.cappedMaxDocs = -1;
+    params.cappedCallback = nullptr;
+    params.sizeStorer = sizeStorer;
+
+    auto ret = stdx::make_unique<StandardWiredTigerRecordStore>(nullptr, opCtx.get(), params);
+    ret->postConstructorInit(opCtx.get());
+    return std::move(ret);
+}
+
+long long countDeltaRows(WiredTigerHarnessHelper* harnessHelper, const string& storageUri) {
+    WT_SESSION* session;
+    invariantWTOK(harnessHelper->conn()->open_session(harnessHelper->conn(), NULL, NULL, &session));
+    ON_BLOCK_EXIT(session->close, session, nullptr);
+    WT_CURSOR* c;
+    invariantWTOK(session->open_cursor(
+        session, WiredTigerSizeStorer::getDeltasUri(storageUri).c_str(), NULL, NULL, &c));
+    long long rows = 0;
+    while (c->next(c) == 0) {
+        rows++;
+    }
+    return rows;
+}
+
+TEST(WiredTigerRecordStoreTest, SizeStorerDeltasAreExactWithoutSync) {
+    WiredTigerHarnessHelper harnessHelper;
+    const string uri =
+        checked_cast<WiredTigerRecordStore*>(harnessHelper.newNonCappedRecordStore().get())
+            ->getURI();
+    const string storageUri = "table:deltaTrackingSizeStorer";
+    const bool enableWtLogging = false;
+    WiredTigerSizeStorer ss(harnessHelper.conn(), storageUri, enableWtLogging);
+    unique_ptr<RecordStore> rs = openWithSizeStorer(&harnessHelper, uri, &ss);
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+    RecordId last;
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < 10; i++) {
+            last = uassertStatusOK(rs->insertRecord(opCtx.get(), "abc", 4, Timestamp(), false));
+        }
+        uow.commit();
+    }
+    {
+        // Rolled back, so its changes must not be counted.
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->insertRecord(opCtx.get(), "abc", 4, Timestamp(), false).getStatus());
+    }
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        rs->deleteRecord(opCtx.get(), last);
+        uow.commit();
+    }
+
+    // A new size storer reads the counts without the first one ever syncing its cache, as after
+    // an unclean shutdown.
+    auto loadCounts = [&] {
+        WiredTigerSizeStorer reopened(harnessHelper.conn(), storageUri, enableWtLogging);
+        reopened.fillCache();
+        long long numRecords;
+        long long dataSize;
+        reopened.loadFromCache(uri, &numRecords, &dataSize);
+        return BSON("numRecords" << numRecords << "dataSize" << dataSize);
+    };
+    ASSERT_BSONOBJ_EQ(BSON("numRecords" << 9 << "dataSize" << 36), loadCounts());
+
+    // Syncing leaves the deltas alone, and compacting folds them into a single row per record
+    // store.
+    const long long deltaRows = countDeltaRows(&harnessHelper, storageUri);
+    ASSERT_GT(deltaRows, 1);
+    ss.syncCache(false);
+    ASSERT_EQ(deltaRows, countDeltaRows(&harnessHelper, storageUri));
+    ASSERT_FALSE(ss.compactDeltas());
+    ASSERT_EQ(1, countDeltaRows(&harnessHelper, storageUri));
+    ASSERT_FALSE(ss.compactDeltas());
+    ASSERT_BSONOBJ_EQ(BSON("numRecords" << 9 << "dataSize" << 36), loadCounts());
+
+    // Repair replaces the tracked counts.
+    checked_cast<WiredTigerRecordStore*>(rs.get())->updateStatsAfterRepair(opCtx.get(), 3, 12);
+    ASSERT_BSONOBJ_EQ(BSON("numRecords" << 3 << "dataSize" << 12), loadCounts());
+
+    // Dropping the record store removes all of its rows.
+    ss.removeDeltas(uri);
+    ASSERT_EQ(0, countDeltaRows(&harnessHelper, storageUri));
+
+    rs.reset();  // this has to be deleted before ss
+}
+
+TEST(WiredTigerRecordStoreTest, SizeStorerCompactsDeltasInBoundedBatches) {
+    WiredTigerHarnessHelper harnessHelper;
+    const string uriA =
+        checked_cast<WiredTigerRecordStore*>(harnessHelper.newNonCappedRecordStore("a.a").get())
+            ->getURI();
+    const string uriB =
+        checked_cast<WiredTigerRecordStore*>(harnessHelper.newNonCappedRecordStore("a.b").get())
+            ->getURI();
+    const string storageUri = "table:batchedSizeStorer";
+    const bool enableWtLogging = false;
+    WiredTigerSizeStorer ss(harnessHelper.conn(), storageUri, enableWtLogging);
+    unique_ptr<RecordStore> rsA = openWithSizeStorer(&harnessHelper, uriA, &ss);
+    unique_ptr<RecordStore> rsB = openWithSizeStorer(&harnessHelper, uriB, &ss);
+
+    // Every transaction writes a delta row of its own: 4 for the first record store, 3 for the
+    // second, next to their base rows.
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+    auto insertOne = [&](RecordStore* rs) {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->insertRecord(opCtx.get(), "abc", 4, Timestamp(), false).getStatus());
+        uow.commit();
+    };
+    for (int i = 0; i < 4; i++) {
+        insertOne(rsA.get());
+    }
+    for (int i = 0; i < 3; i++) {
+        insertOne(rsB.get());
+    }
+    ASSERT_EQ(9, countDeltaRows(&harnessHelper, storageUri));
+
+    auto loadCounts = [&](const string& uri) {
+        WiredTigerSizeStorer reopened(harnessHelper.conn(), storageUri, enableWtLogging);
+        reopened.fillCache();
+        long long numRecords;
+        long long dataSize;
+        reopened.loadFromCache(uri, &numRecords, &dataSize);
+        return BSON("numRecords" << numRecords << "dataSize" << dataSize);
+    };
+
+    // Each batch folds 3 rows and the next one continues after it, including in the middle of a
+    // record store's rows. The counts stay exact in between.
+    ASSERT_TRUE(ss.compactDeltas(3));
+    ASSERT_EQ(6, countDeltaRows(&harnessHelper, storageUri));
+    ASSERT_TRUE(ss.compactDeltas(3));
+    ASSERT_EQ(3, countDeltaRows(&harnessHelper, storageUri));
+    ASSERT_BSONOBJ_EQ(BSON("numRecords" << 4 << "dataSize" << 16), loadCounts(uriA));
+    ASSERT_BSONOBJ_EQ(BSON("numRecords" << 3 << "dataSize" << 12), loadCounts(uriB));
+
+    // A delta committed behind the point reached is folded once the batches start over.
+    insertOne(rsA.get());
+    ASSERT_FALSE(ss.compactDeltas(3));
+    ASSERT_EQ(3, countDeltaRows(&harnessHelper, storageUri));
+    ASSERT_FALSE(ss.compactDeltas(3));
+    ASSERT_EQ(2, countDeltaRows(&harnessHelper, storageUri));
+    ASSERT_BSONOBJ_EQ(BSON("numRecords" << 5 << "dataSize" << 20), loadCounts(uriA));
+    ASSERT_BSONOBJ_EQ(BSON("numRecords" << 3 << "dataSize" << 12), loadCounts(uriB));
+
+    rsA.reset();  // these have to be deleted before ss
+    rsB.reset();
+}
+
 class GoodValidateAdaptor : public ValidateAdaptor {
 public:
     virtual Status validate(const RecordId& recordId, const RecordData& record, size_t* dataSize) {
@@ -450,5 +641,289 @@ TEST_F(SizeStorerValidateTest, InvalidSizeStorerAtCreation) {
     ASSERT_EQUALS(expectedDataSize, rs->dataSize(NULL));
 }
 
+RecordId insertDoc(OperationContext* opCtx, RecordStore* rs, const BSONObj& doc) {
+    WriteUnitOfWork uow(opCtx);
+    StatusWith<RecordId> res =
+        rs->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp(), false);
+    ASSERT_OK(res.getStatus());
+    uow.commit();
+    return res.getValue();
+}
+
+TEST(WiredTigerRecordStoreTest, SizeChangingUpdatesOfLargeRecords) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newNonCappedRecordStore());
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    const std::string pad(64 * 1024, 'x');
+    const RecordId id =
+        insertDoc(opCtx.get(), rs.get(), BSON("a" << BSON_ARRAY(1) << "pad" << pad));
+
+    // Updates that change a few bytes are written as modifies, the others replace the record.
+    for (const BSONObj& doc : {BSON("a" << BSON_ARRAY(1 << 2) << "pad" << pad),
+                               BSON("pad" << pad << "b" << 1),
+                               BSON("pad" << pad)}) {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->updateRecord(opCtx.get(), id, doc.objdata(), doc.objsize(), false, NULL));
+        uow.commit();
+
+        ASSERT_BSONOBJ_EQ(doc, rs->dataFor(opCtx.get(), id).toBson());
+        ASSERT_EQ(doc.objsize(), rs->dataSize(opCtx.get()));
+    }
+}
+
+TEST(WiredTigerRecordStoreTest, ClusteredOnIdKeysRecordsById) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newClusteredRecordStore("a.b"));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    ASSERT_EQ(RecordId(5), insertDoc(opCtx.get(), rs.get(), BSON("_id" << 5 << "x" << 1)));
+    ASSERT_EQ(RecordId(3), insertDoc(opCtx.get(), rs.get(), BSON("_id" << 3LL << "x" << 2)));
+
+    // Records come back in _id order rather than insertion order.
+    auto cursor = rs->getCursor(opCtx.get());
+    auto record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(RecordId(3), record->id);
+    ASSERT_EQ(2, record->data.toBson()["x"].numberInt());
+    record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(RecordId(5), record->id);
+    ASSERT(!cursor->next());
+}
+
+TEST(WiredTigerRecordStoreTest, ClusteredOnIdRejectsDuplicateAndNonIntegerIds) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newClusteredRecordStore("a.b"));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    insertDoc(opCtx.get(), rs.get(), BSON("_id" << 1));
+
+    auto tryInsert = [&](const BSONObj& doc) {
+        WriteUnitOfWork uow(opCtx.get());
+        return rs->insertRecord(opCtx.get(), doc.objdata(), doc.objsize(), Timestamp(), false)
+            .getStatus();
+    };
+    ASSERT_EQ(ErrorCodes::DuplicateKey, tryInsert(BSON("_id" << 1LL << "x" << 1)));
+    ASSERT_EQ(ErrorCodes::BadValue, tryInsert(BSON("_id" << 2.0)));
+    ASSERT_EQ(ErrorCodes::BadValue, tryInsert(BSON("_id" << 0)));
+    ASSERT_EQ(ErrorCodes::BadValue, tryInsert(BSON("_id" << -4)));
+    ASSERT_EQ(ErrorCodes::BadValue, tryInsert(BSON("_id" << OID::gen())));
+    ASSERT_EQ(ErrorCodes::BadValue, tryInsert(BSON("x" << 1)));
+    ASSERT_EQ(1, rs->numRecords(opCtx.get()));
+}
+
+TEST(WiredTigerRecordStoreTest, ClusteredIdIndexSeeksByIdRange) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newClusteredRecordStore("a.b"));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    for (int id : {2, 4, 6}) {
+        insertDoc(opCtx.get(), rs.get(), BSON("_id" << id));
+    }
+
+    WiredTigerClusteredIdIndex index(checked_cast<WiredTigerRecordStore*>(rs.get()), "_id_");
+    ASSERT_FALSE(index.isEmpty(opCtx.get()));
+
+    auto forward = index.newCursor(opCtx.get());
+    auto entry = forward->seek(BSON("" << 3), true);
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(4), entry->loc);
+    ASSERT_BSONOBJ_EQ(BSON("" << 4), entry->key);
+    entry = forward->seek(BSON("" << 4), false);
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(6), entry->loc);
+    ASSERT(!forward->next());
+    entry = forward->seek(BSON("" << MINKEY), true);
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(2), entry->loc);
+    ASSERT(!forward->seek(BSON("" << "abc"), true));
+
+    auto backward = index.newCursor(opCtx.get(), false);
+    entry = backward->seek(BSON("" << 5.5), true);
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(4), entry->loc);
+    entry = backward->next();
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(2), entry->loc);
+    ASSERT(!backward->next());
+
+    // The end position bounds the scan like it would on a real index.
+    forward->setEndPosition(BSON("" << 4), true);
+    entry = forward->seek(BSON("" << 1), true);
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(2), entry->loc);
+    entry = forward->next();
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(4), entry->loc);
+    ASSERT(!forward->next());
+}
+
+TEST(WiredTigerRecordStoreTest, ClusteredIdIndexBoundsForNonIntegerKeys) {
+    auto first = [](const BSONObj& obj, bool inclusive) {
+        return WiredTigerClusteredIdIndex::firstIdAtOrAfter(obj.firstElement(), inclusive);
+    };
+    auto last = [](const BSONObj& obj, bool inclusive) {
+        return WiredTigerClusteredIdIndex::lastIdAtOrBefore(obj.firstElement(), inclusive);
+    };
+
+    ASSERT_EQ(RecordId(3), *first(BSON("" << 2.5), true));
+    ASSERT_EQ(RecordId(2), *last(BSON("" << 2.5), true));
+    ASSERT_EQ(RecordId(3), *first(BSON("" << 2), false));
+    ASSERT_EQ(RecordId(1), *last(BSON("" << 2), false));
+    ASSERT_EQ(RecordId(1), *first(BSON("" << -10), true));
+    ASSERT(!last(BSON("" << 0), true));
+    ASSERT_EQ(RecordId(1), *first(BSON("" << std::nan("")), true));
+    ASSERT(!first(BSON("" << "abc"), true));
+    ASSERT(last(BSON("" << "abc"), true));
+    ASSERT_EQ(RecordId(1), *first(BSON("" << MINKEY), true));
+    ASSERT(!last(BSON("" << MINKEY), true));
+}
+
+TEST(WiredTigerRecordStoreTest, ClusteredOnIdIsRejectedForCappedCollections) {
+    CollectionOptions options;
+    options.capped = true;
+    options.storageEngine = BSON(
+        kWiredTigerEngineName << BSON(WiredTigerRecordStore::kClusteredOnIdOptionName << true));
+    const bool prefixed = false;
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              WiredTigerRecordStore::generateCreateString(
+                  kWiredTigerEngineName, "a.b", options, "", prefixed)
+                  .getStatus());
+}
+
+TEST(WiredTigerRecordStoreTest, FieldNameDictionaryRoundTrip) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newFieldNameDictionaryRecordStore(
+        "a.b", BSON_ARRAY("firstName" << "lastName" << "address")));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    const BSONObj doc = BSON("firstName"
+                             << "Ada"
+                             << "lastName"
+                             << "Lovelace"
+                             << "address"
+                             << BSON("city"
+                                     << "London"));
+    const RecordId id = insertDoc(opCtx.get(), rs.get(), doc);
+    ASSERT_BSONOBJ_EQ(doc, rs->dataFor(opCtx.get(), id).toBson());
+
+    // The data size accounts for the encoded records, which are smaller than the documents.
+    const long long insertedSize = rs->dataSize(opCtx.get());
+    ASSERT_LT(insertedSize, doc.objsize());
+
+    const BSONObj updated = BSON("firstName"
+                                 << "Ada"
+                                 << "lastName"
+                                 << "King"
+                                 << "other"
+                                 << 1);
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->updateRecord(
+            opCtx.get(), id, updated.objdata(), updated.objsize(), false, NULL));
+        uow.commit();
+    }
+
+    auto cursor = rs->getCursor(opCtx.get());
+    auto record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(id, record->id);
+    ASSERT_BSONOBJ_EQ(updated, record->data.toBson());
+    ASSERT(!cursor->next());
+    record = cursor->seekExact(id);
+    ASSERT(record);
+    ASSERT_BSONOBJ_EQ(updated, record->data.toBson());
+
+    const long long updatedSize = rs->dataSize(opCtx.get());
+    ASSERT_LT(updatedSize, updated.objsize());
+
+    // Validate recomputes the data size from the stored records and must agree with the sizes
+    // inserts and updates accounted for.
+    GoodValidateAdaptor adaptor;
+    ValidateResults results;
+    BSONObjBuilder output;
+    ASSERT_OK(rs->validate(opCtx.get(), kValidateFull, &adaptor, &results, &output));
+    ASSERT_TRUE(results.valid);
+    ASSERT_EQ(1, rs->numRecords(opCtx.get()));
+    ASSERT_EQ(updatedSize, rs->dataSize(opCtx.get()));
+
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        rs->deleteRecord(opCtx.get(), id);
+        uow.commit();
+    }
+    ASSERT_EQ(0, rs->dataSize(opCtx.get()));
+}
+
+TEST(WiredTigerRecordStoreTest, FieldNameDictionaryValidateReportsUndecodableRecords) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(
+        harnessHelper.newFieldNameDictionaryRecordStore("a.b", BSON_ARRAY("x")));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    const RecordId good = insertDoc(opCtx.get(), rs.get(), BSON("x" << 1));
+    const RecordId bad = insertDoc(opCtx.get(), rs.get(), BSON("x" << 2));
+
+    // Overwrite the stored record with one that refers to a name missing from the dictionary.
+    {
+        auto wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+        const BSONObj corrupt = BSON("\xFF\x03" << 2);
+        WriteUnitOfWork uow(opCtx.get());
+        WiredTigerCursor cursor(wtrs->getURI(), wtrs->tableId(), true, opCtx.get());
+        WT_CURSOR* c = cursor.get();
+        c->set_key(c, bad.repr());
+        WiredTigerItem value(corrupt.objdata(), corrupt.objsize());
+        c->set_value(c, value.Get());
+        invariantWTOK(c->update(c));
+        uow.commit();
+    }
+
+    // Readers get an error rather than bringing the server down.
+    ASSERT_BSONOBJ_EQ(BSON("x" << 1), rs->dataFor(opCtx.get(), good).toBson());
+    ASSERT_THROWS_CODE(
+        rs->getCursor(opCtx.get())->seekExact(bad), AssertionException, ErrorCodes::InvalidBSON);
+
+    GoodValidateAdaptor adaptor;
+    ValidateResults results;
+    BSONObjBuilder output;
+    ASSERT_OK(rs->validate(opCtx.get(), kValidateFull, &adaptor, &results, &output));
+    ASSERT_FALSE(results.valid);
+    BSONObj obj = output.obj();
+    ASSERT_EQ(2, obj.getIntField("nrecords"));
+    ASSERT_EQ(1, obj.getIntField("nInvalidDocuments"));
+}
+
+TEST(WiredTigerRecordStoreTest, FieldNameDictionaryDisablesUpdateWithDamages) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> plain(harnessHelper.newNonCappedRecordStore("a.plain"));
+    unique_ptr<RecordStore> encoded(
+        harnessHelper.newFieldNameDictionaryRecordStore("a.encoded", BSON_ARRAY("x")));
+    ASSERT_TRUE(plain->updateWithDamagesSupported());
+    ASSERT_FALSE(encoded->updateWithDamagesSupported());
+}
+
+TEST(WiredTigerRecordStoreTest, FieldNameDictionaryIsRejectedForCappedCollections) {
+    const bool prefixed = false;
+    const BSONObj engineOptions = BSON(
+        kWiredTigerEngineName << BSON(WiredTigerFieldNameDictionary::kOptionName
+                                      << BSON_ARRAY("x")));
+
+    CollectionOptions options;
+    options.capped = true;
+    options.storageEngine = engineOptions;
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              WiredTigerRecordStore::generateCreateString(
+                  kWiredTigerEngineName, "a.b", options, "", prefixed)
+                  .getStatus());
+
+    CollectionOptions oplogOptions;
+    oplogOptions.storageEngine = engineOptions;
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              WiredTigerRecordStore::generateCreateString(
+                  kWiredTigerEngineName, "local.oplog.rs", oplogOptions, "", prefixed)
+                  .getStatus());
+}
+
 }  // namespace
 }  // mongo
@@ -35,6 +35,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "mongo/base/simple_string_data_comparator.h"
@@ -557,4 +558,92 @@ Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
     return Status::OK();
 }
 
+namespace {
+
+// Each WT_MODIFY entry is stored as three size_t values ahead of its data, so two changes closer
+// together than this are cheaper to write as one entry covering the unchanged bytes between them.
+const size_t kModifyEntryOverhead = 3 * sizeof(size_t);
+
+// Beyond this many entries, or once the entries add up to this fraction of the new value, a
+// modify saves little over writing the value and makes every later read rebuild it.
+const size_t kMaxModifyEntries = 16;
+const size_t kMaxModifySizeDivisor = 10;
+
+}  // namespace
+
+// static
+bool WiredTigerUtil::computeModifies(const WT_ITEM& oldValue,
+                                     const WT_ITEM& newValue,
+                                     std::vector<WT_MODIFY>* entries) {
+    const uint8_t* const oldData = static_cast<const uint8_t*>(oldValue.data);
+    const uint8_t* const newData = static_cast<const uint8_t*>(newValue.data);
+    const size_t oldSize = oldValue.size;
+    const size_t newSize = newValue.size;
+    const size_t maxModifyBytes = newSize / kMaxModifySizeDivisor;
+
+    // Bytes past the last change line up from the end of both values. Everything before them is
+    // compared at the same offset, which catches the length prefixes that change in front of an
+    // insertion or removal, and the rest is one entry that grows or shrinks the value.
+    const size_t minSize = std::min(oldSize, newSize);
+    size_t suffix = 0;
+    while (suffix < minSize && oldData[oldSize - 1 - suffix] == newData[newSize - 1 - suffix]) {
+        ++suffix;
+    }
+    const size_t aligned = minSize - suffix;
+    const size_t oldSuffixStart = oldSize - suffix;
+    const size_t newSuffixStart = newSize - suffix;
+
+    entries->clear();
+    size_t modifyBytes = 0;
+    auto addEntry = [&](size_t offset, size_t oldLen, size_t newLen) {
+        WT_MODIFY entry;
+        entry.data.data = newData + offset;
+        entry.data.size = newLen;
+        entry.offset = offset;
+        entry.size = oldLen;
+        entries->push_back(entry);
+        modifyBytes += newLen + kModifyEntryOverhead;
+    };
+
+    size_t pos = 0;
+    while (pos < aligned) {
+        pos = std::mismatch(oldData + pos, oldData + aligned, newData + pos).first - oldData;
+        if (pos == aligned) {
+            break;
+        }
+
+        // Extend the change over later differences until the unchanged gap is too wide to be
+        // worth a separate entry.
+        const size_t start = pos;
+        size_t end = pos + 1;
+        for (size_t i = end; i < aligned && i - end < kModifyEntryOverhead; ++i) {
+            if (oldData[i] != newData[i]) {
+                end = i + 1;
+            }
+        }
+        addEntry(start, end - start, end - start);
+        pos = end;
+
+        if (entries->size() > kMaxModifyEntries || modifyBytes > maxModifyBytes) {
+            return false;
+        }
+    }
+
+    if (oldSize != newSize) {
+        const size_t lastEnd = entries->empty() ? 0 : entries->back().offset + entries->back().size;
+        if (!entries->empty() && aligned - lastEnd < kModifyEntryOverhead) {
+            // Fold the growth into the change just before it.
+            WT_MODIFY& last = entries->back();
+            modifyBytes += newSuffixStart - (last.offset + last.data.size);
+            last.size = oldSuffixStart - last.offset;
+            last.data.size = newSuffixStart - last.offset;
+        } else {
+            addEntry(aligned, oldSuffixStart - aligned, newSuffixStart - aligned);
+        }
+    }
+
+    return !entries->empty() && entries->size() <= kMaxModifyEntries &&
+        modifyBytes <= maxModifyBytes;
+}
+
 }  // namespace mongo
@@ -31,6 +31,7 @@
 #pragma once
 
 #include <limits>
+#include <vector>
 #include <wiredtiger.h>
 
 #include "mongo/base/disallow_copying.h"
@@ -225,6 +226,17 @@ public:
 
     static Status setTableLogging(WT_SESSION* session, const std::string& uri, bool on);
 
+    /**
+     * Fills 'entries' with WT_MODIFY changes that turn 'oldValue' into 'newValue' when applied in
+     * order, for writing an update with WT_CURSOR::modify instead of rewriting the whole value.
+     * The sizes of the two values may differ. Returns false, leaving 'entries' unspecified, if
+     * the values are identical or differ in too many places for a modify to be smaller than the
+     * new value.
+     */
+    static bool computeModifies(const WT_ITEM& oldValue,
+                                const WT_ITEM& newValue,
+                                std::vector<WT_MODIFY>* entries);
+
 private:
     /**
      * Casts unsigned 64-bit statistics value to T.
@@ -32,14 +32,18 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 
@@ -360,4 +364,182 @@ TEST(WiredTigerUtilTest, GetStatisticsValueAsUInt8) {
     ASSERT_EQUALS(static_cast<uint8_t>(100), resultInt16.getValue());
 }
 
+long long getGroupCommitStat(StringData name) {
+    BSONObjBuilder builder;
+    WiredTigerSessionCache::appendGroupCommitStats(&builder);
+    return builder.obj()[name].numberLong();
+}
+
+TEST(WiredTigerSessionCacheTest, GroupCommitCoversEveryWaiterOnce) {
+    WiredTigerUtilHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    const long long waitersCoveredBefore = getGroupCommitStat("waitersCovered");
+    const long long requestedFlushesBefore = getGroupCommitStat("requestedFlushes");
+
+    sessionCache->setGroupCommitEnabled(true);
+
+    const int kNumWaiters = 4;
+    AtomicInt32 waitersDone(0);
+    std::vector<stdx::thread> waiters;
+    for (int i = 0; i < kNumWaiters; ++i) {
+        waiters.emplace_back([&] {
+            sessionCache->waitUntilDurable(false, false);
+            waitersDone.fetchAndAdd(1);
+        });
+    }
+
+    // Act as the journal flusher until every waiter has been covered by a flush.
+    while (waitersDone.load() < kNumWaiters) {
+        sessionCache->groupCommit(Milliseconds(10));
+    }
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    ASSERT_EQ(kNumWaiters, getGroupCommitStat("waitersCovered") - waitersCoveredBefore);
+    const long long requestedFlushes = getGroupCommitStat("requestedFlushes");
+    ASSERT_GTE(requestedFlushes - requestedFlushesBefore, 1);
+    ASSERT_LTE(requestedFlushes - requestedFlushesBefore, kNumWaiters);
+
+    // Without group commit, waiters flush on their own and nothing is recorded.
+    sessionCache->setGroupCommitEnabled(false);
+    sessionCache->waitUntilDurable(false, false);
+    ASSERT_EQ(requestedFlushes, getGroupCommitStat("requestedFlushes"));
+}
+
+TEST(WiredTigerSessionCacheTest, ReleasedSessionIsReusedBySameThread) {
+    WiredTigerUtilHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    UniqueWiredTigerSession first = sessionCache->getSession();
+    UniqueWiredTigerSession second = sessionCache->getSession();
+    WiredTigerSession* mostRecent = second.get();
+
+    // Another thread caches a session in its own home partition.
+    WiredTigerSession* otherThreadSession = nullptr;
+    stdx::thread([&] {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        otherThreadSession = session.get();
+    }).join();
+
+    first.reset();
+    second.reset();
+
+    // This thread gets back the session it released last, not the other thread's.
+    UniqueWiredTigerSession session = sessionCache->getSession();
+    ASSERT(session.get() == mostRecent);
+    ASSERT(session.get() != otherThreadSession);
+}
+
+TEST(WiredTigerSessionCacheTest, CachedSessionsAreSharedAcrossThreads) {
+    WiredTigerUtilHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    WiredTigerSession* released = nullptr;
+    stdx::thread([&] {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        released = session.get();
+    }).join();
+
+    // This thread's home partition is empty, so the session cached by the other thread is used
+    // rather than opening a new one.
+    UniqueWiredTigerSession session = sessionCache->getSession();
+    ASSERT(session.get() == released);
+
+    // Sessions in every partition are closed when the cache is cleared.
+    session.reset();
+    sessionCache->closeAll();
+    ASSERT(sessionCache->getSession().get() != nullptr);
+}
+
+namespace {
+
+// Applies 'entries' to 'value' in order, the way WT_CURSOR::modify does.
+std::string applyModifies(std::string value, const std::vector<WT_MODIFY>& entries) {
+    for (const WT_MODIFY& entry : entries) {
+        ASSERT_LTE(entry.offset + entry.size, value.size());
+        value.replace(entry.offset,
+                      entry.size,
+                      static_cast<const char*>(entry.data.data),
+                      entry.data.size);
+    }
+    return value;
+}
+
+BSONObj makeDocWithArray(int arrayLength, const std::string& tag) {
+    BSONArrayBuilder array;
+    for (int i = 0; i < arrayLength; ++i) {
+        array.append(i);
+    }
+    return BSON("_id" << 1 << "pad" << std::string(4096, 'x') << "a" << array.arr() << "tag"
+                      << tag
+                      << "tail"
+                      << std::string(4096, 'y'));
+}
+
+}  // namespace
+
+TEST(WiredTigerUtilTest, ComputeModifiesForGrowingDocument) {
+    const BSONObj oldDoc = makeDocWithArray(10, "t");
+    const BSONObj newDoc = makeDocWithArray(11, "t");
+    const WiredTigerItem oldValue(oldDoc.objdata(), oldDoc.objsize());
+    const WiredTigerItem newValue(newDoc.objdata(), newDoc.objsize());
+
+    std::vector<WT_MODIFY> entries;
+    ASSERT_TRUE(WiredTigerUtil::computeModifies(oldValue, newValue, &entries));
+    // The document length, the array length and the new element.
+    ASSERT_EQ(3U, entries.size());
+    ASSERT_EQ(std::string(newDoc.objdata(), newDoc.objsize()),
+              applyModifies(std::string(oldDoc.objdata(), oldDoc.objsize()), entries));
+}
+
+TEST(WiredTigerUtilTest, ComputeModifiesForShrinkingDocument) {
+    const BSONObj oldDoc = makeDocWithArray(4, "a longer tag");
+    const BSONObj newDoc = makeDocWithArray(3, "short");
+    const WiredTigerItem oldValue(oldDoc.objdata(), oldDoc.objsize());
+    const WiredTigerItem newValue(newDoc.objdata(), newDoc.objsize());
+
+    std::vector<WT_MODIFY> entries;
+    ASSERT_TRUE(WiredTigerUtil::computeModifies(oldValue, newValue, &entries));
+    ASSERT_EQ(std::string(newDoc.objdata(), newDoc.objsize()),
+              applyModifies(std::string(oldDoc.objdata(), oldDoc.objsize()), entries));
+}
+
+TEST(WiredTigerUtilTest, ComputeModifiesForSameSizeChanges) {
+    std::string oldData(10000, 'a');
+    std::string newData = oldData;
+    newData[0] = 'b';
+    newData[5] = 'b';
+    newData[5000] = 'c';
+    newData[9999] = 'd';
+    const WiredTigerItem oldValue(oldData.data(), oldData.size());
+    const WiredTigerItem newValue(newData.data(), newData.size());
+
+    std::vector<WT_MODIFY> entries;
+    ASSERT_TRUE(WiredTigerUtil::computeModifies(oldValue, newValue, &entries));
+    // Nearby changes share an entry.
+    ASSERT_EQ(3U, entries.size());
+    ASSERT_EQ(newData, applyModifies(oldData, entries));
+}
+
+TEST(WiredTigerUtilTest, ComputeModifiesRejectsUnchangedAndRewrittenValues) {
+    const std::string oldData(1000, 'a');
+    const WiredTigerItem oldValue(oldData.data(), oldData.size());
+    std::vector<WT_MODIFY> entries;
+
+    ASSERT_FALSE(WiredTigerUtil::computeModifies(oldValue, oldValue, &entries));
+
+    const std::string rewritten(1000, 'b');
+    ASSERT_FALSE(WiredTigerUtil::computeModifies(
+        oldValue, WiredTigerItem(rewritten.data(), rewritten.size()), &entries));
+
+    std::string scattered = oldData;
+    for (size_t i = 0; i < scattered.size(); i += 50) {
+        scattered[i] = 'c';
+    }
+    ASSERT_FALSE(WiredTigerUtil::computeModifies(
+        oldValue, WiredTigerItem(scattered.data(), scattered.size()), &entries));
+}
+
 }  // namespace mongo
@@ -32,6 +32,9 @@
 
 #include "mongo/executor/connection_pool.h"
 
+#include <algorithm>
+#include <boost/optional.hpp>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/remote_command_request.h"
@@ -179,6 +182,16 @@ private:
 
     void updateStateInLock();
 
+    /**
+     * Returns the number of outstanding requests each connection is meant to absorb at this point.
+     */
+    size_t pendingRequestsPerConnection() const;
+
+    /**
+     * Returns the time at which queued requests stop sharing connections, if it is still ahead.
+     */
+    boost::optional<Date_t> sharedConnectionWaitDeadline() const;
+
 private:
     ConnectionPool* const _parent;
 
@@ -191,6 +204,10 @@ private:
 
     std::priority_queue<Request, std::vector<Request>, RequestComparator> _requests;
 
+    // The last time the request queue became non-empty or one of its requests was handed a
+    // connection. Connections are shared until no request was served for maxSharedConnectionWait.
+    Date_t _requestQueueStalledSince;
+
     std::unique_ptr<TimerInterface> _requestTimer;
     Date_t _requestTimerExpiration;
     size_t _activeClients;
@@ -230,6 +247,8 @@ constexpr Milliseconds ConnectionPool::kDefaultHostTimeout;
 size_t const ConnectionPool::kDefaultMaxConns = std::numeric_limits<size_t>::max();
 size_t const ConnectionPool::kDefaultMinConns = 1;
 size_t const ConnectionPool::kDefaultMaxConnecting = std::numeric_limits<size_t>::max();
+size_t const ConnectionPool::kDefaultMaxPendingRequestsPerConnection = 1;
+constexpr Milliseconds ConnectionPool::kDefaultMaxSharedConnectionWait;
 constexpr Milliseconds ConnectionPool::kDefaultRefreshRequirement;
 constexpr Milliseconds ConnectionPool::kDefaultRefreshTimeout;
 
@@ -367,7 +386,12 @@ void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
         timeout = _parent->_options.refreshTimeout;
     }
 
-    const auto expiration = _parent->_factory->now() + timeout;
+    const auto now = _parent->_factory->now();
+    const auto expiration = now + timeout;
+
+    if (_requests.empty()) {
+        _requestQueueStalledSince = now;
+    }
 
     _requests.push(make_pair(expiration, std::move(cb)));
 
@@ -594,6 +618,8 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
         // check out the connection
         _checkedOutPool[connPtr] = std::move(conn);
 
+        _requestQueueStalledSince = _parent->_factory->now();
+
         updateStateInLock();
 
         // pass it to the user
@@ -615,11 +641,13 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
     _inSpawnConnections = true;
     auto guard = MakeGuard([&] { _inSpawnConnections = false; });
 
-    // We want minConnections <= outstanding requests <= maxConnections
+    // We want minConnections <= outstanding requests / requests per connection <= maxConnections
     auto target = [&] {
-        return std::max(
-            _parent->_options.minConnections,
-            std::min(_requests.size() + _checkedOutPool.size(), _parent->_options.maxConnections));
+        const auto perConnection = pendingRequestsPerConnection();
+        const auto outstanding = _requests.size() + _checkedOutPool.size();
+        const auto wanted = (outstanding + perConnection - 1) / perConnection;
+        return std::max(_parent->_options.minConnections,
+                        std::min(wanted, _parent->_options.maxConnections));
     };
 
     // While all of our inflight connections are less than our target
@@ -732,23 +760,54 @@ ConnectionPool::SpecificPool::OwnedConnection ConnectionPool::SpecificPool::take
 }
 
 
+size_t ConnectionPool::SpecificPool::pendingRequestsPerConnection() const {
+    const auto perConnection =
+        std::max<size_t>(_parent->_options.maxPendingRequestsPerConnection, 1);
+
+    // If the queued requests have not been served for a while, the connections are most likely
+    // held by long running operations, so stop making requests wait for them
+    if (perConnection > 1 && !_requests.empty() && !sharedConnectionWaitDeadline()) {
+        return 1;
+    }
+
+    return perConnection;
+}
+
+boost::optional<Date_t> ConnectionPool::SpecificPool::sharedConnectionWaitDeadline() const {
+    const auto deadline = _requestQueueStalledSince + _parent->_options.maxSharedConnectionWait;
+    if (deadline <= _parent->_factory->now()) {
+        return boost::none;
+    }
+
+    return deadline;
+}
+
 // Updates our state and manages the request timer
 void ConnectionPool::SpecificPool::updateStateInLock() {
     if (_requests.size()) {
         // We have some outstanding requests, we're live
 
+        // Wake up for the most recent request to expire or, if connections are shared, for the
+        // queued requests to stop waiting on a shared connection, whichever comes first
+        auto expiration = _requests.top().first;
+        if (_parent->_options.maxPendingRequestsPerConnection > 1) {
+            if (auto deadline = sharedConnectionWaitDeadline()) {
+                expiration = std::min(expiration, *deadline);
+            }
+        }
+
         // If we were already running and the timer is the same as it was
         // before, nothing to do
-        if (_state == State::kRunning && _requestTimerExpiration == _requests.top().first)
+        if (_state == State::kRunning && _requestTimerExpiration == expiration)
             return;
 
         _state = State::kRunning;
 
         _requestTimer->cancelTimeout();
 
-        _requestTimerExpiration = _requests.top().first;
+        _requestTimerExpiration = expiration;
 
-        auto timeout = _requests.top().first - _parent->_factory->now();
+        auto timeout = expiration - _parent->_factory->now();
 
         // We set a timer for the most recent request, then invoke each timed
         // out request we couldn't service
@@ -772,6 +831,9 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
                     }
                 }
 
+                // Requests, which waited too long for a shared connection, get their own
+                spawnConnections(lk);
+
                 updateStateInLock();
             });
         });
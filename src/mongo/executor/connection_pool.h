@@ -72,6 +72,8 @@ public:
     static const size_t kDefaultMaxConns;
     static const size_t kDefaultMinConns;
     static const size_t kDefaultMaxConnecting;
+    static const size_t kDefaultMaxPendingRequestsPerConnection;
+    static constexpr Milliseconds kDefaultMaxSharedConnectionWait = Milliseconds(10);
     static constexpr Milliseconds kDefaultRefreshRequirement = Milliseconds(60000);  // 1min
     static constexpr Milliseconds kDefaultRefreshTimeout = Milliseconds(20000);      // 20secs
 
@@ -100,6 +102,23 @@ public:
          */
         size_t maxConnecting = kDefaultMaxConnecting;
 
+        /**
+         * The number of queued and in-use requests a single connection is expected to absorb
+         * before the pool opens another one. The default of 1 spawns a connection per
+         * outstanding request. Larger values let bursts of short requests share a small set of
+         * sockets, with the extra requests waiting for a connection to be returned rather than
+         * paying for a new connection handshake.
+         */
+        size_t maxPendingRequestsPerConnection = kDefaultMaxPendingRequestsPerConnection;
+
+        /**
+         * How long queued requests may go without any of them being handed a connection before
+         * the pool stops sharing connections and opens one per outstanding request. Bounds how
+         * long requests wait behind connections checked out by long running operations. Only
+         * matters if maxPendingRequestsPerConnection is above 1.
+         */
+        Milliseconds maxSharedConnectionWait = kDefaultMaxSharedConnectionWait;
+
         /**
          * Amount of time to wait before timing out a refresh attempt
          */
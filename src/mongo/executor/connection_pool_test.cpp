@@ -611,6 +611,113 @@ TEST_F(ConnectionPoolTest, maxPoolRespected) {
     doneWith(conn3);
 }
 
+/**
+ * Verify that maxPendingRequestsPerConnection lets outstanding requests share connections
+ */
+TEST_F(ConnectionPoolTest, maxPendingRequestsPerConnectionRespected) {
+    ConnectionPool::Options options;
+    options.minConnections = 1;
+    options.maxPendingRequestsPerConnection = 2;
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    // Freeze the time, so that the queued requests never wait long enough to stop sharing
+    PoolImpl::setNow(Date_t::now());
+
+    std::vector<ConnectionPool::ConnectionHandle> conns;
+    conns.reserve(3);
+
+    auto getConn = [&] {
+        pool.get(HostAndPort(),
+                 Milliseconds(5000),
+                 [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                     ASSERT(swConn.isOK());
+
+                     conns.push_back(std::move(swConn.getValue()));
+                 });
+    };
+
+    // Two outstanding requests only warrant a single connection
+    getConn();
+    getConn();
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 1U);
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(conns.size(), 1U);
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0U);
+
+    // A third request pushes us over the per connection budget
+    getConn();
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 1U);
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(conns.size(), 2U);
+    ASSERT_EQ(pool.getNumConnectionsPerHost(HostAndPort()), 2U);
+
+    // Returning a connection hands it to the queued request rather than opening a new one
+    auto conn1Ptr = conns[0].get();
+    doneWith(conns[0]);
+    conns[0].reset();
+
+    ASSERT_EQ(conns.size(), 3U);
+    ASSERT_EQ(conn1Ptr, conns[2].get());
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0U);
+    ASSERT_EQ(pool.getNumConnectionsPerHost(HostAndPort()), 2U);
+
+    doneWith(conns[1]);
+    doneWith(conns[2]);
+}
+
+/**
+ * Verify that requests stop sharing connections after maxSharedConnectionWait without being served
+ */
+TEST_F(ConnectionPoolTest, maxSharedConnectionWaitRespected) {
+    ConnectionPool::Options options;
+    options.minConnections = 1;
+    options.maxPendingRequestsPerConnection = 2;
+    options.maxSharedConnectionWait = Milliseconds(100);
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    std::vector<ConnectionPool::ConnectionHandle> conns;
+    conns.reserve(2);
+
+    auto getConn = [&] {
+        pool.get(HostAndPort(),
+                 Milliseconds(5000),
+                 [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                     ASSERT(swConn.isOK());
+
+                     conns.push_back(std::move(swConn.getValue()));
+                 });
+    };
+
+    // The first request holds on to the only connection, as a long running operation would
+    getConn();
+    getConn();
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 1U);
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(conns.size(), 1U);
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0U);
+
+    // The second request keeps waiting for the shared connection for a while
+    PoolImpl::setNow(now + Milliseconds(50));
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0U);
+
+    // But gets a connection of its own once it has waited for too long
+    PoolImpl::setNow(now + Milliseconds(100));
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 1U);
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(conns.size(), 2U);
+    ASSERT_EQ(pool.getNumConnectionsPerHost(HostAndPort()), 2U);
+
+    doneWith(conns[0]);
+    doneWith(conns[1]);
+}
+
 /**
  * Verify that we respect maxConnecting
  */
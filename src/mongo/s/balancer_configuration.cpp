@@ -52,6 +52,8 @@ const char kStopped[] = "stopped";
 const char kMode[] = "mode";
 const char kActiveWindow[] = "activeWindow";
 const char kWaitForDelete[] = "_waitForDelete";
+const char kBalanceByLoad[] = "balanceByLoad";
+const char kMaxConcurrentMigrationsPerShard[] = "maxConcurrentMigrationsPerShard";
 
 const NamespaceString kSettingsNamespace("config", "settings");
 
@@ -129,6 +131,16 @@ bool BalancerConfiguration::waitForDelete() const {
     return _balancerSettings.waitForDelete();
 }
 
+bool BalancerConfiguration::balanceByLoad() const {
+    stdx::lock_guard<stdx::mutex> lk(_balancerSettingsMutex);
+    return _balancerSettings.balanceByLoad();
+}
+
+int BalancerConfiguration::getMaxConcurrentMigrationsPerShard() const {
+    stdx::lock_guard<stdx::mutex> lk(_balancerSettingsMutex);
+    return _balancerSettings.getMaxConcurrentMigrationsPerShard();
+}
+
 Status BalancerConfiguration::refreshAndCheck(OperationContext* opCtx) {
     // Balancer configuration
     Status balancerSettingsStatus = _refreshBalancerSettings(opCtx);
@@ -319,6 +331,33 @@ StatusWith<BalancerSettingsType> BalancerSettingsType::fromBSON(const BSONObj& o
         settings._waitForDelete = waitForDelete;
     }
 
+    {
+        bool balanceByLoad;
+        Status status =
+            bsonExtractBooleanFieldWithDefault(obj, kBalanceByLoad, false, &balanceByLoad);
+        if (!status.isOK())
+            return status;
+
+        settings._balanceByLoad = balanceByLoad;
+    }
+
+    {
+        long long maxConcurrentMigrations;
+        Status status = bsonExtractIntegerFieldWithDefault(
+            obj, kMaxConcurrentMigrationsPerShard, 1, &maxConcurrentMigrations);
+        if (!status.isOK())
+            return status;
+
+        if (maxConcurrentMigrations < 1 || maxConcurrentMigrations > 100) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << kMaxConcurrentMigrationsPerShard
+                                  << " must be between 1 and 100, but found "
+                                  << maxConcurrentMigrations};
+        }
+
+        settings._maxConcurrentMigrationsPerShard = static_cast<int>(maxConcurrentMigrations);
+    }
+
     return settings;
 }
 
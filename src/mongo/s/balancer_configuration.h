@@ -52,7 +52,9 @@ class StatusWith;
  * balancer: {
  *  stopped: <true|false>,
  *  mode: <full|autoSplitOnly|off>,         // Only consulted if "stopped" is missing or false
- *  activeWindow: { start: "<HH:MM>", stop: "<HH:MM>" }
+ *  activeWindow: { start: "<HH:MM>", stop: "<HH:MM>" },
+ *  balanceByLoad: <true|false>,             // Also move hot chunks off of busy shards
+ *  maxConcurrentMigrationsPerShard: <int>   // Collections a shard may donate concurrently
  * }
  */
 class BalancerSettingsType {
@@ -107,6 +109,22 @@ public:
         return _waitForDelete;
     }
 
+    /**
+     * Returns whether the balancer should also move the most written chunks off of shards which
+     * serve a disproportionate share of the operations.
+     */
+    bool balanceByLoad() const {
+        return _balanceByLoad;
+    }
+
+    /**
+     * Returns the maximum number of chunks of different collections, which a shard is allowed to
+     * donate concurrently during a balancer round.
+     */
+    int getMaxConcurrentMigrationsPerShard() const {
+        return _maxConcurrentMigrationsPerShard;
+    }
+
 private:
     BalancerSettingsType();
 
@@ -118,6 +136,10 @@ private:
     MigrationSecondaryThrottleOptions _secondaryThrottle;
 
     bool _waitForDelete{false};
+
+    bool _balanceByLoad{false};
+
+    int _maxConcurrentMigrationsPerShard{1};
 };
 
 /**
@@ -234,6 +256,17 @@ public:
      */
     bool waitForDelete() const;
 
+    /**
+     * Returns whether the balancer should take the load of the shards into account in addition to
+     * the number of chunks they own.
+     */
+    bool balanceByLoad() const;
+
+    /**
+     * Returns how many migrations a single shard is allowed to donate concurrently.
+     */
+    int getMaxConcurrentMigrationsPerShard() const;
+
     /**
      * Returns the max chunk size after which a chunk would be considered jumbo.
      */
@@ -238,6 +238,31 @@ TEST(BalancerSettingsType, InvalidBalancerModeOption) {
                   .code());
 }
 
+TEST(BalancerSettingsType, BalanceByLoadOption) {
+    ASSERT(!assertGet(BalancerSettingsType::fromBSON(BSONObj())).balanceByLoad());
+    ASSERT(
+        assertGet(BalancerSettingsType::fromBSON(BSON("balanceByLoad" << true))).balanceByLoad());
+    ASSERT_EQ(ErrorCodes::TypeMismatch,
+              BalancerSettingsType::fromBSON(BSON("balanceByLoad"
+                                                  << "yes"))
+                  .getStatus()
+                  .code());
+}
+
+TEST(BalancerSettingsType, MaxConcurrentMigrationsPerShardOption) {
+    ASSERT_EQ(1,
+              assertGet(BalancerSettingsType::fromBSON(BSONObj()))
+                  .getMaxConcurrentMigrationsPerShard());
+    ASSERT_EQ(
+        4,
+        assertGet(BalancerSettingsType::fromBSON(BSON("maxConcurrentMigrationsPerShard" << 4)))
+            .getMaxConcurrentMigrationsPerShard());
+    ASSERT_EQ(ErrorCodes::BadValue,
+              BalancerSettingsType::fromBSON(BSON("maxConcurrentMigrationsPerShard" << 0))
+                  .getStatus()
+                  .code());
+}
+
 TEST(BalancerSettingsType, BalancingWindowStartLessThanStop) {
     BalancerSettingsType settings =
         assertGet(BalancerSettingsType::fromBSON(BSON("activeWindow" << BSON("start"
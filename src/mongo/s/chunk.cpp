@@ -32,7 +32,11 @@
 
 #include "mongo/s/chunk.h"
 
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -62,6 +66,26 @@ void Chunk::clearBytesWritten() {
     _dataWritten = 0;
 }
 
+uint64_t Chunk::getWriteOps() const {
+    return _writeOps.load();
+}
+
+uint64_t Chunk::addWriteOp() {
+    return _writeOps.addAndFetch(1);
+}
+
+uint64_t Chunk::decayWriteOps() {
+    // Writes may increment the count concurrently, so only halve the value which was read
+    auto writeOps = _writeOps.load();
+    while (true) {
+        const auto prevWriteOps = _writeOps.compareAndSwap(writeOps, writeOps / 2);
+        if (prevWriteOps == writeOps)
+            return writeOps;
+
+        writeOps = prevWriteOps;
+    }
+}
+
 bool Chunk::shouldSplit(uint64_t desiredChunkSize, bool minIsInf, bool maxIsInf) const {
     // If this chunk is at either end of the range, trigger auto-split at 10% less data written in
     // order to trigger the top-chunk optimization.
@@ -73,6 +97,86 @@ bool Chunk::shouldSplit(uint64_t desiredChunkSize, bool minIsInf, bool maxIsInf)
     return _dataWritten >= splitThreshold / kSplitTestFactor;
 }
 
+long long Chunk::getDataSizeBytes() const {
+    stdx::lock_guard<stdx::mutex> lk(_dataSizeMutex);
+    return _dataSizeBytes;
+}
+
+void Chunk::setDataSize(long long dataSizeBytes,
+                        long long numDocs,
+                        std::vector<BSONObj> sampledKeys) {
+    invariant(sampledKeys.size() <= kMaxSampledKeys);
+
+    stdx::lock_guard<stdx::mutex> lk(_dataSizeMutex);
+    _dataSizeBytes = std::max(0LL, dataSizeBytes);
+    _numSampledDocs = std::max(numDocs, static_cast<long long>(sampledKeys.size()));
+    _sampledKeys = std::move(sampledKeys);
+
+    if (!_random) {
+        _random.emplace(static_cast<int64_t>(Date_t::now().toMillisSinceEpoch() ^ numDocs));
+    }
+
+    _isDataSizeTracked.store(true);
+}
+
+void Chunk::recordInsert(const BSONObj& shardKey, int docSize) {
+    if (!_isDataSizeTracked.load())
+        return;
+
+    stdx::lock_guard<stdx::mutex> lk(_dataSizeMutex);
+    if (_dataSizeBytes < 0)
+        return;
+
+    _dataSizeBytes += docSize;
+    _numSampledDocs++;
+
+    // Reservoir sampling keeps every document's key in the sample with equal probability
+    if (_sampledKeys.size() < kMaxSampledKeys) {
+        _sampledKeys.push_back(shardKey.getOwned());
+    } else {
+        const int64_t slot = _random->nextInt64(_numSampledDocs);
+        if (slot < static_cast<int64_t>(kMaxSampledKeys)) {
+            _sampledKeys[slot] = shardKey.getOwned();
+        }
+    }
+}
+
+void Chunk::recordUpdate(int sizeDelta) {
+    if (!sizeDelta || !_isDataSizeTracked.load())
+        return;
+
+    stdx::lock_guard<stdx::mutex> lk(_dataSizeMutex);
+    if (_dataSizeBytes < 0)
+        return;
+
+    _dataSizeBytes = std::max(0LL, _dataSizeBytes + sizeDelta);
+}
+
+void Chunk::recordDelete(int docSize) {
+    if (!_isDataSizeTracked.load())
+        return;
+
+    stdx::lock_guard<stdx::mutex> lk(_dataSizeMutex);
+    if (_dataSizeBytes < 0)
+        return;
+
+    _dataSizeBytes = std::max(0LL, _dataSizeBytes - docSize);
+    _numSampledDocs = std::max(_numSampledDocs - 1, static_cast<long long>(_sampledKeys.size()));
+}
+
+std::vector<BSONObj> Chunk::getSampledKeys() const {
+    std::vector<BSONObj> sampledKeys;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_dataSizeMutex);
+        sampledKeys = _sampledKeys;
+    }
+
+    std::sort(sampledKeys.begin(),
+              sampledKeys.end(),
+              SimpleBSONObjComparator::kInstance.makeLessThan());
+    return sampledKeys;
+}
+
 std::string Chunk::toString() const {
     return str::stream() << ChunkType::shard() << ": " << _shardId << ", " << ChunkType::lastmod()
                          << ": " << _lastmod.toString() << ", " << _range.toString();
@@ -28,9 +28,15 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/random.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/shard_id.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
@@ -44,6 +50,9 @@ public:
     // Test whether we should split once data * kSplitTestFactor > chunkSize (approximately)
     const uint64_t kSplitTestFactor = 5;
 
+    // Maximum number of shard keys kept in the sample used to choose split points
+    static const size_t kMaxSampledKeys = 256;
+
     explicit Chunk(const ChunkType& from);
 
     const BSONObj& getMin() const {
@@ -84,8 +93,55 @@ public:
     uint64_t addBytesWritten(uint64_t bytesWrittenIncrement);
     void clearBytesWritten();
 
+    /**
+     * Get/increment the decayed count of writes applied to this chunk. Unlike the bytes written
+     * estimate, it is not reset when the chunk is checked for splitting, so it can be used to
+     * compare how hot the chunks are relative to each other. Cache entries of unchanged chunks
+     * survive routing table refreshes, so the count is instead halved periodically through
+     * decayWriteOps, which weighs recent writes over older ones.
+     *
+     * addWriteOp returns the count after the increment.
+     */
+    uint64_t getWriteOps() const;
+    uint64_t addWriteOp();
+
+    /**
+     * Halves the count of writes and returns the count before halving it.
+     */
+    uint64_t decayWriteOps();
+
     bool shouldSplit(uint64_t desiredChunkSize, bool minIsInf, bool maxIsInf) const;
 
+    /**
+     * Returns the tracked size in bytes of the documents in this chunk, or -1 if it has not been
+     * established yet through a call to setDataSize.
+     */
+    long long getDataSizeBytes() const;
+
+    /**
+     * Establishes that the chunk contains 'numDocs' documents of 'dataSizeBytes' bytes in total and
+     * seeds the shard key sample with 'sampledKeys', which must be a uniform sample of the shard
+     * keys of these documents. From then on, the size and the sample are kept up to date by the
+     * write paths through recordInsert, recordUpdate and recordDelete.
+     */
+    void setDataSize(long long dataSizeBytes, long long numDocs, std::vector<BSONObj> sampledKeys);
+
+    /**
+     * Adjust the tracked size of the chunk for a document of 'docSize' bytes having been inserted
+     * into or deleted from it, or for a document in it having grown by 'sizeDelta' bytes (negative
+     * if it shrank). The shard keys of inserted documents take part in the sample. Updates cannot
+     * change the shard key, so they leave the sample alone. Do nothing if the size of the chunk
+     * has not been established yet.
+     */
+    void recordInsert(const BSONObj& shardKey, int docSize);
+    void recordUpdate(int sizeDelta);
+    void recordDelete(int docSize);
+
+    /**
+     * Returns the currently sampled shard keys in ascending order.
+     */
+    std::vector<BSONObj> getSampledKeys() const;
+
     /**
      * Marks this chunk as jumbo. Only moves from false to true once and is used by the balancer.
      */
@@ -104,6 +160,28 @@ private:
 
     // Statistics for the approximate data written to this chunk
     mutable uint64_t _dataWritten;
+
+    // Decayed count of the writes applied to this chunk. Unlike the statistics above, it is
+    // reported to the balancer while writes keep incrementing it, so it must not lose updates.
+    AtomicWord<unsigned long long> _writeOps{0};
+
+    // Allows the write paths to skip the mutex below for chunks, whose size is not tracked
+    AtomicWord<bool> _isDataSizeTracked{false};
+
+    // Protects the data size tracking state below. Unlike the statistics above, the key sample
+    // cannot tolerate racy updates.
+    mutable stdx::mutex _dataSizeMutex;
+
+    // Tracked size of the chunk's data, -1 if not established yet
+    long long _dataSizeBytes{-1};
+
+    // Number of documents from which the shard key sample was drawn
+    long long _numSampledDocs{0};
+
+    // Uniform sample of the shard keys of the documents in the chunk and the random number
+    // generator used to maintain it
+    std::vector<BSONObj> _sampledKeys;
+    boost::optional<PseudoRandom> _random;
 };
 
 }  // namespace mongo
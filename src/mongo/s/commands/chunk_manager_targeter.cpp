@@ -245,6 +245,29 @@ bool wasMetadataRefreshed(const std::shared_ptr<ChunkManager>& managerA,
     return false;
 }
 
+/**
+ * Extracts the shard key from a document which is about to be inserted. Inserts must contain the
+ * exact shard key, which must also fit within the maximum shard key size.
+ */
+StatusWith<BSONObj> extractShardKeyForInsert(const ShardKeyPattern& shardKeyPattern,
+                                             const BSONObj& doc) {
+    BSONObj shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+
+    // Check shard key exists
+    if (shardKey.isEmpty()) {
+        return {ErrorCodes::ShardKeyNotFound,
+                str::stream() << "document " << doc << " does not contain shard key for pattern "
+                              << shardKeyPattern.toString()};
+    }
+
+    // Check shard key size on insert
+    Status status = ShardKeyPattern::checkShardKeySize(shardKey);
+    if (!status.isOK())
+        return status;
+
+    return shardKey;
+}
+
 }  // namespace
 
 ChunkManagerTargeter::ChunkManagerTargeter(const NamespaceString& nss, TargeterStats* stats)
@@ -277,26 +300,12 @@ StatusWith<ShardEndpoint> ChunkManagerTargeter::targetInsert(OperationContext* o
     BSONObj shardKey;
 
     if (_routingInfo->cm()) {
-        //
-        // Sharded collections have the following requirements for targeting:
-        //
-        // Inserts must contain the exact shard key.
-        //
+        auto swShardKey =
+            extractShardKeyForInsert(_routingInfo->cm()->getShardKeyPattern(), doc);
+        if (!swShardKey.isOK())
+            return swShardKey.getStatus();
 
-        shardKey = _routingInfo->cm()->getShardKeyPattern().extractShardKeyFromDoc(doc);
-
-        // Check shard key exists
-        if (shardKey.isEmpty()) {
-            return {ErrorCodes::ShardKeyNotFound,
-                    str::stream() << "document " << doc
-                                  << " does not contain shard key for pattern "
-                                  << _routingInfo->cm()->getShardKeyPattern().toString()};
-        }
-
-        // Check shard key size on insert
-        Status status = ShardKeyPattern::checkShardKeySize(shardKey);
-        if (!status.isOK())
-            return status;
+        shardKey = std::move(swShardKey.getValue());
     }
 
     // Target the shard key or database primary
@@ -315,6 +324,90 @@ StatusWith<ShardEndpoint> ChunkManagerTargeter::targetInsert(OperationContext* o
     return Status::OK();
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_routingInfo->cm()) {
+        // Unsharded collections always target the database primary, so there is nothing to share
+        // between the documents
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    const auto& cm = _routingInfo->cm();
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+
+    // Consecutive documents of a batch very often fall in the same chunk (monotonically increasing
+    // or clustered shard keys), so only go back to the chunk map when a key falls outside of the
+    // last chunk found
+    std::shared_ptr<Chunk> lastChunk;
+    boost::optional<ShardEndpoint> lastEndpoint;
+
+    for (const auto& doc : docs) {
+        auto swShardKey = extractShardKeyForInsert(cm->getShardKeyPattern(), doc);
+        if (!swShardKey.isOK()) {
+            endpoints.push_back(swShardKey.getStatus());
+            continue;
+        }
+
+        const auto& shardKey = swShardKey.getValue();
+
+        if (!lastChunk || !lastChunk->containsKey(shardKey)) {
+            try {
+                lastChunk = cm->findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
+            } catch (const DBException& ex) {
+                lastChunk.reset();
+                endpoints.push_back(ex.toStatus());
+                continue;
+            }
+
+            lastEndpoint.emplace(lastChunk->getShardId(), cm->getVersion(lastChunk->getShardId()));
+        }
+
+        endpoints.push_back(*lastEndpoint);
+    }
+
+    return endpoints;
+}
+
+void ChunkManagerTargeter::noteInsertsSent(OperationContext* opCtx,
+                                           const std::vector<BSONObj>& docs) const {
+    if (!_routingInfo->cm()) {
+        return;
+    }
+
+    const auto& cm = _routingInfo->cm();
+
+    // Track autosplit stats for sharded collections. The estimate is accumulated for each run of
+    // documents in the same chunk and applied to the stats once per run instead of once per
+    // document.
+    // Note: this is only best effort accounting and is not accurate.
+    std::shared_ptr<Chunk> lastChunk;
+    long long lastChunkSizeDelta = 0;
+
+    const auto flushChunkSizeDelta = [&] {
+        if (lastChunkSizeDelta > 0) {
+            _stats->chunkSizeDelta[lastChunk->getMin()] += lastChunkSizeDelta;
+            lastChunkSizeDelta = 0;
+        }
+    };
+
+    for (const auto& doc : docs) {
+        // The documents were targeted successfully against the same routing info, so they have a
+        // valid shard key which falls in a chunk
+        const BSONObj shardKey = cm->getShardKeyPattern().extractShardKeyFromDoc(doc);
+
+        if (!lastChunk || !lastChunk->containsKey(shardKey)) {
+            flushChunkSizeDelta();
+            lastChunk = cm->findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
+        }
+
+        lastChunkSizeDelta += doc.objsize();
+    }
+
+    flushChunkSizeDelta();
+}
+
 StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::targetUpdate(
     OperationContext* opCtx, const write_ops::UpdateOpEntry& updateDoc) const {
     //
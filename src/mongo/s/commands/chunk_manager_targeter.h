@@ -70,6 +70,15 @@ public:
     StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
                                            const BSONObj& doc) const override;
 
+    // Same as targetInsert for every document, but looks up each chunk only once per run of
+    // consecutive documents which fall in it and leaves the autosplit stats to noteInsertsSent.
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
+    // Adds the sizes of the documents to the autosplit stats, once per run of consecutive
+    // documents which fall in the same chunk.
+    void noteInsertsSent(OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     // Returns ShardKeyNotFound if the update can't be targeted without a shard key.
     StatusWith<std::vector<ShardEndpoint>> targetUpdate(
         OperationContext* opCtx, const write_ops::UpdateOpEntry& updateDoc) const override;
@@ -36,6 +36,7 @@
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/shard_id.h"
+#include "mongo/util/assert_util.h"
 
 namespace mongo {
 
@@ -97,6 +98,41 @@ public:
     virtual StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
                                                    const BSONObj& doc) const = 0;
 
+    /**
+     * Returns a ShardEndpoint, or the targeting error, for each document of a batch of single
+     * document writes, in the same order as 'docs'. An error targeting one document does not
+     * affect the targeting of the others.
+     *
+     * Callers may target more documents than they end up sending, so they report the documents
+     * which they do send through noteInsertsSent, and only those should be accounted in the write
+     * statistics the targeter keeps.
+     *
+     * The default implementation calls targetInsert for each document, and so accounts whatever
+     * targetInsert accounts. Targeters whose targetInsert keeps write statistics must override it,
+     * which also lets them share lookups across the batch.
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+        std::vector<StatusWith<ShardEndpoint>> endpoints;
+        endpoints.reserve(docs.size());
+
+        for (const auto& doc : docs) {
+            try {
+                endpoints.push_back(targetInsert(opCtx, doc));
+            } catch (const DBException& ex) {
+                endpoints.push_back(ex.toStatus());
+            }
+        }
+
+        return endpoints;
+    }
+
+    /**
+     * Accounts documents, which were targeted through targetInserts, in the write statistics kept
+     * by the targeter, once they have been placed into a child batch.
+     */
+    virtual void noteInsertsSent(OperationContext* opCtx, const std::vector<BSONObj>& docs) const {}
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update.
      *
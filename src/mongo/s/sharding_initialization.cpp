@@ -32,6 +32,7 @@
 
 #include "mongo/s/sharding_initialization.h"
 
+#include <algorithm>
 #include <string>
 
 #include "mongo/base/status.h"
@@ -98,6 +99,19 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolRefreshTimeoutMS,
                                       int,
                                       ConnectionPool::kDefaultRefreshTimeout.count());
 
+// Number of outstanding remote commands a pooled connection is expected to absorb before the pool
+// opens another socket to the same host. Values above one trade a little queueing latency for far
+// fewer connections between mongos and the shards under bursty fan-out.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxPendingRequestsPerConnection,
+                                      int,
+                                      1);
+
+// How long queued remote commands may go without being handed a shared connection before the pool
+// opens connections for them, so that they don't queue behind long running commands
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxSharedConnectionWaitMS,
+                                      int,
+                                      ConnectionPool::kDefaultMaxSharedConnectionWait.count());
+
 namespace {
 
 using executor::NetworkInterface;
@@ -193,6 +207,12 @@ Status initializeGlobalShardingState(OperationContext* opCtx,
     connPoolOptions.minConnections = ShardingTaskExecutorPoolMinSize;
     connPoolOptions.refreshRequirement = Milliseconds(ShardingTaskExecutorPoolRefreshRequirementMS);
     connPoolOptions.refreshTimeout = Milliseconds(ShardingTaskExecutorPoolRefreshTimeoutMS);
+    connPoolOptions.maxPendingRequestsPerConnection =
+        (ShardingTaskExecutorPoolMaxPendingRequestsPerConnection > 0)
+        ? ShardingTaskExecutorPoolMaxPendingRequestsPerConnection
+        : ConnectionPool::kDefaultMaxPendingRequestsPerConnection;
+    connPoolOptions.maxSharedConnectionWait =
+        Milliseconds(std::max(ShardingTaskExecutorPoolMaxSharedConnectionWaitMS, 0));
 
     if (connPoolOptions.refreshRequirement <= connPoolOptions.refreshTimeout) {
         auto newRefreshTimeout = connPoolOptions.refreshRequirement - Milliseconds(1);
@@ -30,6 +30,7 @@
 
 #include "mongo/s/write_ops/batch_write_op.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include "mongo/base/error_codes.h"
@@ -57,6 +58,12 @@ struct WriteErrorDetailComp {
     }
 };
 
+// Number of documents of an insert batch which are targeted together the first time through the
+// targeter. Every following window is twice as big as the previous one, so that ordered batches,
+// which stop at the first document going to a different shard, don't target the whole remainder of
+// the batch on every round.
+const size_t kInitialInsertTargetingWindow = 8;
+
 // MAGIC NUMBERS
 //
 // Before serializing updates/deletes, we don't know how big their fields would be, but we break
@@ -239,6 +246,41 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    //
+    // Inserts only depend on the shard key of the document, so they are targeted through the
+    // targeter in bulk, one window of ready documents at a time
+    //
+
+    const bool targetInsertsInBulk =
+        _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert &&
+        !_clientRequest.isInsertIndexRequest();
+
+    std::vector<StatusWith<ShardEndpoint>> insertEndpoints;
+    size_t nextInsertEndpoint = 0;
+    size_t nextInsertToTarget = 0;
+    size_t insertTargetingWindow = kInitialInsertTargetingWindow;
+
+    const auto targetNextInsertWindow = [&] {
+        std::vector<BSONObj> docs;
+        docs.reserve(std::min(insertTargetingWindow, numWriteOps - nextInsertToTarget));
+
+        for (; nextInsertToTarget < numWriteOps && docs.size() < insertTargetingWindow;
+             ++nextInsertToTarget) {
+            const WriteOp& writeOp = _writeOps[nextInsertToTarget];
+            if (writeOp.getWriteState() == WriteOpState_Ready) {
+                docs.push_back(writeOp.getWriteItem().getDocument());
+            }
+        }
+
+        insertEndpoints = targeter.targetInserts(_opCtx, docs);
+        nextInsertEndpoint = 0;
+        insertTargetingWindow *= 2;
+    };
+
+    // Documents of the window which don't make it into this round's batches are targeted again on
+    // the next round, so only the ones actually placed are reported back to the targeter
+    std::vector<BSONObj> sentInsertDocs;
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -254,7 +296,18 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         OwnedPointerVector<TargetedWrite> writesOwned;
         vector<TargetedWrite*>& writes = writesOwned.mutableVector();
 
-        Status targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+        Status targetStatus = Status::OK();
+        if (targetInsertsInBulk) {
+            if (nextInsertEndpoint == insertEndpoints.size()) {
+                targetNextInsertWindow();
+            }
+
+            invariant(nextInsertEndpoint < insertEndpoints.size());
+            targetStatus = writeOp.targetInsertWrite(
+                std::move(insertEndpoints[nextInsertEndpoint++]), &writes);
+        } else {
+            targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+        }
 
         if (!targetStatus.isOK()) {
             WriteErrorDetail targetError;
@@ -326,6 +379,10 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         // Relinquish ownership of TargetedWrites, now the TargetedBatches own them
         writesOwned.mutableVector().clear();
 
+        if (targetInsertsInBulk) {
+            sentInsertDocs.push_back(writeOp.getWriteItem().getDocument());
+        }
+
         //
         // Break if we're ordered and we have more than one endpoint - later writes cannot be
         // enforced as ordered across multiple shard endpoints.
@@ -335,6 +392,10 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
             break;
     }
 
+    if (!sentInsertDocs.empty()) {
+        targeter.noteInsertsSent(_opCtx, sentInsertDocs);
+    }
+
     //
     // Send back our targeted batches
     //
@@ -369,25 +430,38 @@ BatchedCommandRequest BatchWriteOp::buildBatchRequest(
     boost::optional<std::vector<write_ops::UpdateOpEntry>> updates;
     boost::optional<std::vector<write_ops::DeleteOpEntry>> deletes;
 
+    // The child batch has exactly one entry per targeted write, so size it up front instead of
+    // growing it one write at a time
+    const size_t numWrites = targetedBatch.getWrites().size();
+    if (stmtIdsForOp) {
+        stmtIdsForOp->reserve(numWrites);
+    }
+
     for (const auto& targetedWrite : targetedBatch.getWrites()) {
         const WriteOpRef& writeOpRef = targetedWrite->writeOpRef;
 
         switch (batchType) {
             case BatchedCommandRequest::BatchType_Insert:
-                if (!insertDocs)
+                if (!insertDocs) {
                     insertDocs.emplace();
+                    insertDocs->reserve(numWrites);
+                }
                 insertDocs->emplace_back(
                     _clientRequest.getInsertRequest().getDocuments().at(writeOpRef.first));
                 break;
             case BatchedCommandRequest::BatchType_Update:
-                if (!updates)
+                if (!updates) {
                     updates.emplace();
+                    updates->reserve(numWrites);
+                }
                 updates->emplace_back(
                     _clientRequest.getUpdateRequest().getUpdates().at(writeOpRef.first));
                 break;
             case BatchedCommandRequest::BatchType_Delete:
-                if (!deletes)
+                if (!deletes) {
                     deletes.emplace();
+                    deletes->reserve(numWrites);
+                }
                 deletes->emplace_back(
                     _clientRequest.getDeleteRequest().getDeletes().at(writeOpRef.first));
                 break;
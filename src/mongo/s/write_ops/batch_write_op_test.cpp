@@ -519,6 +519,116 @@ TEST_F(BatchWriteOpTest, MultiOpTwoShardsUnordered) {
     ASSERT_EQUALS(clientResponse.getN(), 2);
 }
 
+// Multi-op, multi-endpoint insert targeting test (unordered) with more inserts than are targeted
+// in bulk at once. There should be one set of two batches (one to each shard).
+TEST_F(BatchWriteOpTest, ManyInsertsTwoShardsUnordered) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED());
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED());
+    MockNSTargeter targeter;
+    initTargeterSplitRange(nss, endpointA, endpointB, &targeter);
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < 100; ++i) {
+            docs.push_back(BSON("x" << (i % 2 == 0 ? -(i + 1) : i)));
+        }
+        insertOp.setDocuments(docs);
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(operationContext(), request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT(!batchOp.isFinished());
+    ASSERT_EQUALS(targeted.size(), 2u);
+    verifyTargetedBatches({{endpointA.shardName, 50u}, {endpointB.shardName, 50u}}, targeted);
+
+    BatchedCommandResponse response;
+    buildResponse(50, &response);
+
+    // Respond to both targeted batches
+    for (auto it = targeted.begin(); it != targeted.end(); ++it) {
+        ASSERT(!batchOp.isFinished());
+        batchOp.noteBatchResponse(*it->second, response, NULL);
+    }
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 100);
+}
+
+// Multi-op, multi-endpoint insert targeting test (ordered) where the inserts change shards past the
+// first set of inserts targeted in bulk. There should be two batches, one to each shard.
+TEST_F(BatchWriteOpTest, ManyInsertsTwoShardsOrdered) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED());
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED());
+    MockNSTargeter targeter;
+    initTargeterSplitRange(nss, endpointA, endpointB, &targeter);
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < 20; ++i) {
+            docs.push_back(BSON("x" << -(i + 1)));
+        }
+        for (int i = 0; i < 30; ++i) {
+            docs.push_back(BSON("x" << i));
+        }
+        insertOp.setDocuments(docs);
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(operationContext(), request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT(!batchOp.isFinished());
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 20u);
+    assertEndpointsEqual(targeted.begin()->second->getEndpoint(), endpointA);
+
+    // The inserts targeted in bulk past the shard change are not reported as sent
+    ASSERT_EQUALS(targeter.getNumInsertsSent(), 20u);
+
+    BatchedCommandResponse response;
+    buildResponse(20, &response);
+
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, NULL);
+    ASSERT(!batchOp.isFinished());
+
+    targetedOwned.clear();
+
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT(!batchOp.isFinished());
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 30u);
+    assertEndpointsEqual(targeted.begin()->second->getEndpoint(), endpointB);
+    ASSERT_EQUALS(targeter.getNumInsertsSent(), 50u);
+
+    buildResponse(30, &response);
+
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, NULL);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 50);
+}
+
 // Multi-op (ordered) targeting test where each op goes to both shards. There should be two sets of
 // two batches to each shard (two for each delete op).
 TEST_F(BatchWriteOpTest, MultiOpTwoShardsEachOrdered) {
@@ -1225,6 +1335,61 @@ TEST_F(BatchWriteOpTest, MultiOpFailedTargetUnordered) {
     ASSERT_EQUALS(clientResponse.getErrDetailsAt(0)->getIndex(), 1);
 }
 
+// Targeting exception on the second of several inserts targeted together (unordered). Only the
+// second insert should get an error.
+TEST_F(BatchWriteOpTest, MultiOpTargetExceptionUnordered) {
+    // Throws when targeting the document { x : -2 }, as chunk lookups do on a bad shard key
+    class ThrowingTargeter : public MockNSTargeter {
+    public:
+        StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
+                                               const BSONObj& doc) const override {
+            uassert(ErrorCodes::ShardKeyNotFound, "mock error", doc["x"].numberInt() != -2);
+            return MockNSTargeter::targetInsert(opCtx, doc);
+        }
+    };
+
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpoint(ShardId("shard"), ChunkVersion::IGNORED());
+    ThrowingTargeter targeter;
+    initTargeterFullRange(nss, endpoint, &targeter);
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        insertOp.setDocuments({BSON("x" << -1), BSON("x" << -2), BSON("x" << -3)});
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(operationContext(), request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, true, &targeted));
+    ASSERT(!batchOp.isFinished());
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 2u);
+    ASSERT_EQUALS(targeter.getNumInsertsSent(), 2u);
+
+    BatchedCommandResponse response;
+    buildResponse(2, &response);
+
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, NULL);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 2);
+    ASSERT_EQUALS(clientResponse.sizeErrDetails(), 1u);
+    ASSERT_EQUALS(clientResponse.getErrDetailsAt(0)->getIndex(), 1);
+    ASSERT_EQUALS(clientResponse.getErrDetailsAt(0)->toStatus().code(),
+                  ErrorCodes::ShardKeyNotFound);
+}
+
 // Batch failure (ok : 0) reported in a multi-op batch (ordered). Expect this gets translated down
 // into write errors for first affected write.
 TEST_F(BatchWriteOpTest, MultiOpFailedBatchOrdered) {
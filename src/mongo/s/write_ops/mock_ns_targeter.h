@@ -82,6 +82,17 @@ public:
         return swEndpoints.getValue().front();
     }
 
+    /**
+     * Remembers how many inserts were reported as sent
+     */
+    void noteInsertsSent(OperationContext* opCtx, const std::vector<BSONObj>& docs) const override {
+        _numInsertsSent += docs.size();
+    }
+
+    size_t getNumInsertsSent() const {
+        return _numInsertsSent;
+    }
+
     /**
      * Returns the first ShardEndpoint for the query from the mock ranges.  Only can handle
      * queries of the form { field : { $gte : <value>, $lt : <value> } }.
@@ -178,6 +189,8 @@ private:
     NamespaceString _nss;
 
     std::vector<MockRange> _mockRanges;
+
+    mutable size_t _numInsertsSent{0};
 };
 
 inline void assertEndpointsEqual(const ShardEndpoint& endpointA, const ShardEndpoint& endpointB) {
@@ -90,8 +90,27 @@ Status WriteOp::targetWrites(OperationContext* opCtx,
     if (!swEndpoints.isOK())
         return swEndpoints.getStatus();
 
-    auto& endpoints = swEndpoints.getValue();
+    _targetEndpoints(std::move(swEndpoints.getValue()), targetedWrites);
+    return Status::OK();
+}
+
+Status WriteOp::targetInsertWrite(StatusWith<ShardEndpoint> swEndpoint,
+                                  std::vector<TargetedWrite*>* targetedWrites) {
+    invariant(_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert);
+    invariant(!_itemRef.getRequest()->isInsertIndexRequest());
+
+    if (!swEndpoint.isOK())
+        return swEndpoint.getStatus();
+
+    std::vector<ShardEndpoint> endpoints;
+    endpoints.push_back(std::move(swEndpoint.getValue()));
 
+    _targetEndpoints(std::move(endpoints), targetedWrites);
+    return Status::OK();
+}
+
+void WriteOp::_targetEndpoints(std::vector<ShardEndpoint> endpoints,
+                               std::vector<TargetedWrite*>* targetedWrites) {
     for (auto&& endpoint : endpoints) {
         _childOps.emplace_back(this);
 
@@ -109,7 +128,6 @@ Status WriteOp::targetWrites(OperationContext* opCtx,
     }
 
     _state = WriteOpState_Pending;
-    return Status::OK();
 }
 
 size_t WriteOp::getNumTargeted() {
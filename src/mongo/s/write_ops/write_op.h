@@ -121,6 +121,13 @@ public:
                         const NSTargeter& targeter,
                         std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites, but for a single document insert which has already been targeted to
+     * 'swEndpoint' along with the rest of its batch through NSTargeter::targetInserts.
+     */
+    Status targetInsertWrite(StatusWith<ShardEndpoint> swEndpoint,
+                             std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -159,6 +166,12 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates a TargetedWrite for each of the targeted endpoints and moves the op to _Pending.
+     */
+    void _targetEndpoints(std::vector<ShardEndpoint> endpoints,
+                          std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
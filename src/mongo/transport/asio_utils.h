@@ -28,8 +28,11 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/base/status.h"
 #include "mongo/base/system_error.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/net/sockaddr.h"
 
@@ -65,5 +68,26 @@ inline Status errorCodeToStatus(const std::error_code& ec) {
     return {errorCode, ec.message()};
 }
 
+/**
+ * Advances a buffer sequence past the first 'size' bytes, such as after a partial write.
+ */
+template <typename Buffer>
+void consumeBuffers(Buffer* buffer, size_t size) {
+    *buffer += size;
+}
+
+inline void consumeBuffers(std::vector<asio::const_buffer>* buffers, size_t size) {
+    auto it = buffers->begin();
+    while (it != buffers->end() && size >= asio::buffer_size(*it)) {
+        size -= asio::buffer_size(*it);
+        ++it;
+    }
+    buffers->erase(buffers->begin(), it);
+    if (size > 0) {
+        invariant(!buffers->empty());
+        buffers->front() += size;
+    }
+}
+
 }  // namespace transport
 }  // namespace mongo
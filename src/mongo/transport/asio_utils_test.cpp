@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/transport/asio_utils.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+std::string remainingData(const std::vector<asio::const_buffer>& buffers) {
+    std::string out;
+    for (const auto& buffer : buffers) {
+        out.append(asio::buffer_cast<const char*>(buffer), asio::buffer_size(buffer));
+    }
+    return out;
+}
+
+class ConsumeBuffersTest : public unittest::Test {
+protected:
+    std::vector<asio::const_buffer> makeBuffers() const {
+        return {asio::buffer(_first), asio::buffer(_second), asio::buffer(_third)};
+    }
+
+private:
+    const std::string _first = "abcd";
+    const std::string _second = "ef";
+    const std::string _third = "ghijk";
+};
+
+TEST_F(ConsumeBuffersTest, ShortWriteWithinFirstBuffer) {
+    auto buffers = makeBuffers();
+    consumeBuffers(&buffers, 3);
+    ASSERT_EQ(buffers.size(), 3U);
+    ASSERT_EQ(remainingData(buffers), "defghijk");
+}
+
+TEST_F(ConsumeBuffersTest, ShortWriteEndingOnBufferBoundary) {
+    auto buffers = makeBuffers();
+    consumeBuffers(&buffers, 4);
+    ASSERT_EQ(buffers.size(), 2U);
+    ASSERT_EQ(remainingData(buffers), "efghijk");
+
+    consumeBuffers(&buffers, 2);
+    ASSERT_EQ(buffers.size(), 1U);
+    ASSERT_EQ(remainingData(buffers), "ghijk");
+}
+
+TEST_F(ConsumeBuffersTest, ShortWriteSpanningSeveralBuffers) {
+    auto buffers = makeBuffers();
+    consumeBuffers(&buffers, 7);
+    ASSERT_EQ(buffers.size(), 1U);
+    ASSERT_EQ(remainingData(buffers), "hijk");
+
+    // A second short write keeps advancing from where the first one stopped.
+    consumeBuffers(&buffers, 2);
+    ASSERT_EQ(buffers.size(), 1U);
+    ASSERT_EQ(remainingData(buffers), "jk");
+}
+
+TEST_F(ConsumeBuffersTest, CompleteWriteConsumesEverything) {
+    auto buffers = makeBuffers();
+    consumeBuffers(&buffers, 11);
+    ASSERT_TRUE(buffers.empty());
+}
+
+TEST_F(ConsumeBuffersTest, EmptyWriteConsumesNothing) {
+    auto buffers = makeBuffers();
+    consumeBuffers(&buffers, 0);
+    ASSERT_EQ(buffers.size(), 3U);
+    ASSERT_EQ(remainingData(buffers), "abcdefghijk");
+}
+
+TEST(ConsumeBuffersSingleBufferTest, ShortWriteAdvancesBuffer) {
+    const std::string data = "abcdef";
+    auto buffer = asio::buffer(data);
+    consumeBuffers(&buffer, 4);
+    ASSERT_EQ(asio::buffer_size(buffer), 2U);
+    ASSERT_EQ(std::string(asio::buffer_cast<const char*>(buffer), 2), "ef");
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace mongo
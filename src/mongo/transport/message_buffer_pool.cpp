@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_buffer_pool.h"
+
+#include <cstdlib>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/allocator.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+// The most memory the receive buffer pool keeps around in unused buffers. Zero disables pooling.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(messageBufferPoolMaxCachedBytes,
+                                      long long,
+                                      64 * 1024 * 1024);
+
+}  // namespace
+
+constexpr size_t MessageBufferPool::kMinPooledSize;
+constexpr size_t MessageBufferPool::kMaxPooledSize;
+
+MessageBufferPool::MessageBufferPool(size_t maxCachedBytes)
+    : _maxCachedBytes(static_cast<int64_t>(maxCachedBytes)) {}
+
+MessageBufferPool::~MessageBufferPool() {
+    for (auto& sizeClass : _sizeClasses) {
+        for (auto ptr : sizeClass.freeList) {
+            std::free(ptr);
+        }
+    }
+}
+
+MessageBufferPool& MessageBufferPool::get() {
+    static auto pool =
+        new MessageBufferPool(static_cast<size_t>(std::max(messageBufferPoolMaxCachedBytes, 0LL)));
+    return *pool;
+}
+
+size_t MessageBufferPool::_sizeClassIndex(size_t bytes) {
+    if (bytes <= kMinPooledSize)
+        return 0;
+
+    // 'bytes' falls in (2^log2, 2^(log2 + 1)], which is split into equally sized steps.
+    const int log2 = 63 - countLeadingZeros64(bytes - 1);
+    const int stepShift = log2 - kSizeClassesPerPowerOfTwoLog2;
+    const size_t step = ((bytes - (size_t{1} << log2)) + (size_t{1} << stepShift) - 1) >> stepShift;
+    return (log2 - kMinPooledSizeLog2) * kSizeClassesPerPowerOfTwo + step;
+}
+
+size_t MessageBufferPool::_sizeClassCapacity(size_t index) {
+    if (index == 0)
+        return kMinPooledSize;
+
+    const int log2 = kMinPooledSizeLog2 + static_cast<int>((index - 1) / kSizeClassesPerPowerOfTwo);
+    const size_t step = (index - 1) % kSizeClassesPerPowerOfTwo + 1;
+    return (size_t{1} << log2) + step * (size_t{1} << (log2 - kSizeClassesPerPowerOfTwoLog2));
+}
+
+size_t MessageBufferPool::roundUpToSizeClass(size_t bytes) {
+    invariant(bytes <= kMaxPooledSize);
+    return _sizeClassCapacity(_sizeClassIndex(bytes));
+}
+
+SharedBuffer MessageBufferPool::allocate(size_t bytes) {
+    if (_maxCachedBytes == 0 || bytes > kMaxPooledSize) {
+        return SharedBuffer::allocate(bytes);
+    }
+
+    const auto index = _sizeClassIndex(bytes);
+    const auto capacity = _sizeClassCapacity(index);
+
+    void* ptr = nullptr;
+    {
+        auto& sizeClass = _sizeClasses[index];
+        stdx::lock_guard<stdx::mutex> lk(sizeClass.mutex);
+        if (!sizeClass.freeList.empty()) {
+            ptr = sizeClass.freeList.back();
+            sizeClass.freeList.pop_back();
+        }
+    }
+
+    if (ptr) {
+        _cachedBytes.subtractAndFetch(capacity);
+        _hits.addAndFetch(1);
+    } else {
+        ptr = mongoMalloc(SharedBuffer::kRecyclableHeaderSize + capacity);
+        _misses.addAndFetch(1);
+    }
+
+    return SharedBuffer::takeRecyclableOwnership(ptr, capacity, this);
+}
+
+void MessageBufferPool::recycle(void* headerPrefixedData, size_t capacity) {
+    // Reserve room in the cache before handing the buffer to its free list, so that concurrent
+    // releases can never push the pool over its limit.
+    if (_cachedBytes.addAndFetch(capacity) > _maxCachedBytes) {
+        _cachedBytes.subtractAndFetch(capacity);
+        _discarded.addAndFetch(1);
+        std::free(headerPrefixedData);
+        return;
+    }
+
+    auto& sizeClass = _sizeClasses[_sizeClassIndex(capacity)];
+    {
+        stdx::lock_guard<stdx::mutex> lk(sizeClass.mutex);
+        sizeClass.freeList.push_back(headerPrefixedData);
+    }
+    _recycled.addAndFetch(1);
+}
+
+MessageBufferPool::Stats MessageBufferPool::getStats() const {
+    Stats stats;
+    stats.hits = _hits.load();
+    stats.misses = _misses.load();
+    stats.recycled = _recycled.load();
+    stats.discarded = _discarded.load();
+    stats.cachedBytes = _cachedBytes.load();
+    return stats;
+}
+
+void MessageBufferPool::appendStats(BSONObjBuilder* bob) const {
+    const auto stats = getStats();
+    BSONObjBuilder section(bob->subobjStart("messageBufferPool"));
+    section.append("hits", stats.hits);
+    section.append("misses", stats.misses);
+    section.append("recycled", stats.recycled);
+    section.append("discarded", stats.discarded);
+    section.append("cachedBytes", stats.cachedBytes);
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+namespace transport {
+
+/**
+ * A size-classed free list of SharedBuffers used to receive incoming messages.
+ *
+ * Buffers are rounded up to one of eight size classes per power of two between kMinPooledSize and
+ * kMaxPooledSize, so at most an eighth of each buffer is wasted. When the last reference to a
+ * pooled buffer goes away its memory returns to the pool, as long as the pool caches fewer than
+ * its configured number of bytes. This keeps a steady stream of large messages, such as full
+ * insert batches, from going through the allocator on every receive.
+ */
+class MessageBufferPool final : public SharedBuffer::Recycler {
+    MONGO_DISALLOW_COPYING(MessageBufferPool);
+
+public:
+    static constexpr size_t kMinPooledSize = 1024;
+    static constexpr size_t kMaxPooledSize = 64 * 1024 * 1024;
+
+    struct Stats {
+        int64_t hits = 0;
+        int64_t misses = 0;
+        int64_t recycled = 0;
+        int64_t discarded = 0;
+        int64_t cachedBytes = 0;
+    };
+
+    /**
+     * Constructs a pool which keeps at most 'maxCachedBytes' of unused buffers. A value of zero
+     * disables pooling entirely.
+     */
+    explicit MessageBufferPool(size_t maxCachedBytes);
+    ~MessageBufferPool();
+
+    /**
+     * Returns the process-wide pool for receive buffers, sized by the
+     * messageBufferPoolMaxCachedBytes startup parameter. It is never destroyed, since pooled
+     * buffers may be released during shutdown.
+     */
+    static MessageBufferPool& get();
+
+    /**
+     * Returns a buffer with a capacity of at least 'bytes'.
+     */
+    SharedBuffer allocate(size_t bytes);
+
+    void recycle(void* headerPrefixedData, size_t capacity) override;
+
+    Stats getStats() const;
+
+    void appendStats(BSONObjBuilder* bob) const;
+
+    /**
+     * Returns the capacity of the size class 'bytes' is rounded up to. Only valid for sizes up
+     * to kMaxPooledSize.
+     */
+    static size_t roundUpToSizeClass(size_t bytes);
+
+private:
+    static constexpr int kSizeClassesPerPowerOfTwoLog2 = 3;
+    static constexpr size_t kSizeClassesPerPowerOfTwo = size_t{1} << kSizeClassesPerPowerOfTwoLog2;
+    static constexpr int kMinPooledSizeLog2 = 10;
+    static constexpr int kMaxPooledSizeLog2 = 26;
+    static constexpr size_t kNumSizeClasses =
+        (kMaxPooledSizeLog2 - kMinPooledSizeLog2) * kSizeClassesPerPowerOfTwo + 1;
+
+    struct SizeClass {
+        stdx::mutex mutex;
+        std::vector<void*> freeList;
+    };
+
+    static size_t _sizeClassIndex(size_t bytes);
+    static size_t _sizeClassCapacity(size_t index);
+
+    const int64_t _maxCachedBytes;
+
+    std::array<SizeClass, kNumSizeClasses> _sizeClasses;
+
+    AtomicWord<int64_t> _cachedBytes{0};
+    AtomicWord<int64_t> _hits{0};
+    AtomicWord<int64_t> _misses{0};
+    AtomicWord<int64_t> _recycled{0};
+    AtomicWord<int64_t> _discarded{0};
+};
+
+}  // namespace transport
+}  // namespace mongo
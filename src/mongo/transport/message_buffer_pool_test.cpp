@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_buffer_pool.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+TEST(MessageBufferPoolTest, SizesRoundUpToEighthPowerOfTwoSteps) {
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(1), 1024U);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(1024), 1024U);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(1025), 1152U);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(1152), 1152U);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(2048), 2048U);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(2049), 2304U);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(3000), 3072U);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(16 * 1024 * 1024 + 16),
+              18U * 1024 * 1024);
+    ASSERT_EQ(MessageBufferPool::roundUpToSizeClass(MessageBufferPool::kMaxPooledSize),
+              MessageBufferPool::kMaxPooledSize);
+}
+
+TEST(MessageBufferPoolTest, ReleasedBufferIsReused) {
+    MessageBufferPool pool(1024 * 1024);
+
+    auto buffer = pool.allocate(3000);
+    ASSERT_GTE(buffer.capacity(), 3000U);
+    const auto ptr = buffer.get();
+    memset(ptr, 'x', 3000);
+
+    buffer = {};
+    ASSERT_EQ(pool.getStats().recycled, 1);
+    ASSERT_EQ(pool.getStats().cachedBytes, 3072);
+
+    // Any size in the same size class gets the cached buffer back.
+    auto reused = pool.allocate(2900);
+    ASSERT_EQ(reused.get(), ptr);
+    ASSERT_EQ(pool.getStats().hits, 1);
+    ASSERT_EQ(pool.getStats().misses, 1);
+    ASSERT_EQ(pool.getStats().cachedBytes, 0);
+}
+
+TEST(MessageBufferPoolTest, BufferIsOnlyRecycledOnceAllReferencesAreGone) {
+    MessageBufferPool pool(1024 * 1024);
+
+    auto buffer = pool.allocate(100);
+    ConstSharedBuffer view(buffer);
+
+    buffer = {};
+    ASSERT_EQ(pool.getStats().recycled, 0);
+
+    view = {};
+    ASSERT_EQ(pool.getStats().recycled, 1);
+}
+
+TEST(MessageBufferPoolTest, CacheLimitIsRespected) {
+    MessageBufferPool pool(4096);
+
+    auto first = pool.allocate(4096);
+    auto second = pool.allocate(4096);
+
+    first = {};
+    second = {};
+    ASSERT_EQ(pool.getStats().recycled, 1);
+    ASSERT_EQ(pool.getStats().discarded, 1);
+    ASSERT_EQ(pool.getStats().cachedBytes, 4096);
+}
+
+TEST(MessageBufferPoolTest, OversizedAndUnpooledBuffersBypassThePool) {
+    MessageBufferPool disabled(0);
+    auto buffer = disabled.allocate(100);
+    ASSERT_EQ(buffer.capacity(), 100U);
+    buffer = {};
+    ASSERT_EQ(disabled.getStats().recycled, 0);
+    ASSERT_EQ(disabled.getStats().misses, 0);
+
+    MessageBufferPool pool(1024 * 1024);
+    auto large = pool.allocate(MessageBufferPool::kMaxPooledSize + 1);
+    ASSERT_EQ(large.capacity(), MessageBufferPool::kMaxPooledSize + 1);
+    large = {};
+    ASSERT_EQ(pool.getStats().recycled, 0);
+}
+
+TEST(MessageBufferPoolTest, ReallocatedBufferLeavesThePool) {
+    MessageBufferPool pool(1024 * 1024);
+
+    auto buffer = pool.allocate(100);
+    memcpy(buffer.get(), "hello", 6);
+
+    // The contents move into a plain buffer and the pooled one is handed back right away.
+    buffer.realloc(5000);
+    ASSERT_EQ(StringData(buffer.get()), "hello"_sd);
+    ASSERT_EQ(buffer.capacity(), 5000U);
+    ASSERT_EQ(pool.getStats().recycled, 1);
+
+    buffer = {};
+    ASSERT_EQ(pool.getStats().recycled, 1);
+}
+
+TEST(MessageBufferPoolTest, PlainBuffersDoNotPayForRecycling) {
+    static_assert(SharedBuffer::kHolderSize == 8, "plain SharedBuffers carry an 8 byte header");
+
+    auto buffer = SharedBuffer::allocate(100);
+    ASSERT_EQ(buffer.capacity(), 100U);
+    buffer.realloc(200);
+    ASSERT_EQ(buffer.capacity(), 200U);
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace mongo
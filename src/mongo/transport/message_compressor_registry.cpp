@@ -35,6 +35,7 @@
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/transport/message_compressor_zstd.h"
 #include "mongo/util/options_parser/option_section.h"
 
 #include <boost/algorithm/string/classification.hpp>
@@ -54,6 +55,8 @@ StringData getMessageCompressorName(MessageCompressor id) {
             return "snappy"_sd;
         case MessageCompressor::kZlib:
             return "zlib"_sd;
+        case MessageCompressor::kZstd:
+            return "zstd"_sd;
         default:
             fassert(40269, "Invalid message compressor ID");
     }
@@ -124,6 +127,21 @@ Status addMessageCompressionOptions(moe::OptionSection* options, bool forShell)
     } else {
         ret.setDefault(moe::Value(kDefaultConfigValue.toString()));
     }
+
+    auto& level = options->addOptionChaining(
+        "net.compression.zstdCompressionLevel",
+        "networkMessageZstdCompressionLevel",
+        moe::Int,
+        "Compression level used by the zstd network message compressor");
+    auto& dictionary = options->addOptionChaining(
+        "net.compression.zstdDictionaryFile",
+        "networkMessageZstdDictionaryFile",
+        moe::String,
+        "Trained zstd dictionary used by the zstd network message compressor");
+    if (forShell) {
+        level.hidden();
+        dictionary.hidden();
+    }
     return Status::OK();
 }
 
@@ -136,6 +154,15 @@ Status storeMessageCompressionOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("net.compression.zstdCompressionLevel")) {
+        zstdMessageCompressorSettings.compressionLevel =
+            params["net.compression.zstdCompressionLevel"].as<int>();
+    }
+    if (params.count("net.compression.zstdDictionaryFile")) {
+        zstdMessageCompressorSettings.dictionaryFile =
+            params["net.compression.zstdDictionaryFile"].as<std::string>();
+    }
+
     auto& compressorFactory = MessageCompressorRegistry::get();
     compressorFactory.setSupportedCompressors(std::move(restrict));
 
@@ -0,0 +1,227 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_compressor_zstd.h"
+
+#include "mongo/config.h"
+
+namespace mongo {
+ZstdMessageCompressorSettings zstdMessageCompressorSettings;
+}  // namespace mongo
+
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+
+#include <fstream>
+#include <sstream>
+#include <zstd.h>
+
+#include "mongo/base/init.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+// The registry shares one compressor instance between every session, so the (comparatively
+// expensive) zstd contexts are cached per thread rather than per compressor or per call.
+ZSTD_CCtx* threadCompressionContext() {
+    thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx(ZSTD_createCCtx());
+    return ctx.get();
+}
+
+ZSTD_DCtx* threadDecompressionContext() {
+    thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx(ZSTD_createDCtx());
+    return ctx.get();
+}
+
+}  // namespace
+
+struct ZstdMessageCompressor::Dictionaries {
+    ~Dictionaries() {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+    }
+
+    unsigned id = 0;
+    ZSTD_CDict* cdict = nullptr;
+    ZSTD_DDict* ddict = nullptr;
+};
+
+ZstdMessageCompressor::ZstdMessageCompressor(int compressionLevel, const std::string& dictionary)
+    : MessageCompressorBase(MessageCompressor::kZstd), _compressionLevel(compressionLevel) {
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "zstd compression level must be between 1 and " << ZSTD_maxCLevel()
+                          << ", got "
+                          << compressionLevel,
+            compressionLevel >= 1 && compressionLevel <= ZSTD_maxCLevel());
+
+    if (dictionary.empty())
+        return;
+
+    // Only trained dictionaries carry an ID; without one a peer using a different dictionary
+    // could not be detected and would silently decompress garbage.
+    const auto id = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+    uassert(ErrorCodes::BadValue, "zstd dictionary is not a trained zstd dictionary", id != 0);
+
+    _dictionaries = stdx::make_unique<Dictionaries>();
+    _dictionaries->id = id;
+    _dictionaries->cdict =
+        ZSTD_createCDict(dictionary.data(), dictionary.size(), _compressionLevel);
+    _dictionaries->ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+    uassert(ErrorCodes::BadValue,
+            "Could not load zstd dictionary",
+            _dictionaries->cdict && _dictionaries->ddict);
+}
+
+ZstdMessageCompressor::~ZstdMessageCompressor() = default;
+
+std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ZSTD_compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
+                                                            DataRange output) {
+    auto ctx = threadCompressionContext();
+    if (!ctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate zstd context"};
+    }
+
+    auto outData = const_cast<char*>(output.data());
+    size_t ret = _dictionaries
+        ? ZSTD_compress_usingCDict(ctx,
+                                   outData,
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   _dictionaries->cdict)
+        : ZSTD_compressCCtx(
+              ctx, outData, output.length(), input.data(), input.length(), _compressionLevel);
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input: " << ZSTD_getErrorName(ret)};
+    }
+    counterHitCompress(input.length(), ret);
+    return {ret};
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
+                                                              DataRange output) {
+    auto ctx = threadDecompressionContext();
+    if (!ctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate zstd context"};
+    }
+
+    auto outData = const_cast<char*>(output.data());
+    const auto frameDictId = ZSTD_getDictID_fromFrame(input.data(), input.length());
+    size_t ret;
+    if (frameDictId == 0) {
+        ret = ZSTD_decompressDCtx(ctx, outData, output.length(), input.data(), input.length());
+    } else if (_dictionaries && frameDictId == _dictionaries->id) {
+        ret = ZSTD_decompress_usingDDict(
+            ctx, outData, output.length(), input.data(), input.length(), _dictionaries->ddict);
+    } else {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Compressed message requires unknown zstd dictionary "
+                                    << frameDictId};
+    }
+
+    if (ZSTD_isError(ret) || ret != output.length()) {
+        return Status{ErrorCodes::BadValue, "Compressed message was invalid or corrupted"};
+    }
+
+    counterHitDecompress(input.length(), output.length());
+    return {output.length()};
+}
+
+namespace {
+
+StatusWith<std::string> readDictionaryFile(const std::string& path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return Status{ErrorCodes::FileOpenFailed,
+                      str::stream() << "Could not open zstd dictionary file " << path};
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    if (file.bad()) {
+        return Status{ErrorCodes::FileStreamFailed,
+                      str::stream() << "Could not read zstd dictionary file " << path};
+    }
+    return contents.str();
+}
+
+}  // namespace
+
+MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    std::string dictionary;
+    if (!zstdMessageCompressorSettings.dictionaryFile.empty()) {
+        auto swDictionary = readDictionaryFile(zstdMessageCompressorSettings.dictionaryFile);
+        if (!swDictionary.isOK()) {
+            return swDictionary.getStatus();
+        }
+        dictionary = std::move(swDictionary.getValue());
+        log() << "Loaded " << dictionary.size() << " byte zstd message compression dictionary from "
+              << zstdMessageCompressorSettings.dictionaryFile;
+    }
+
+    try {
+        auto& compressorRegistry = MessageCompressorRegistry::get();
+        compressorRegistry.registerImplementation(stdx::make_unique<ZstdMessageCompressor>(
+            zstdMessageCompressorSettings.compressionLevel, dictionary));
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+    return Status::OK();
+}
+}  // namespace mongo
+
+#endif  // MONGO_CONFIG_HAVE_ZSTD
@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/transport/message_compressor_base.h"
+
+#include <memory>
+#include <string>
+
+namespace mongo {
+
+/**
+ * Settings for the "zstd" compressor, populated during startup option storage.
+ */
+struct ZstdMessageCompressorSettings {
+    static constexpr int kDefaultCompressionLevel = 3;
+
+    int compressionLevel = kDefaultCompressionLevel;
+
+    // Path to a dictionary trained (e.g. with "zstd --train") from sampled BSON messages. Every
+    // member of a deployment that negotiates "zstd" must be configured with the same dictionary.
+    std::string dictionaryFile;
+};
+
+extern ZstdMessageCompressorSettings zstdMessageCompressorSettings;
+
+/**
+ * Message compressor backed by Zstandard. It is only registered when the server is built with
+ * MONGO_CONFIG_HAVE_ZSTD.
+ *
+ * When constructed with a dictionary, outgoing frames are compressed against it and tagged with
+ * its ID. Incoming frames that carry no dictionary ID are decompressed without one, so peers that
+ * were started without a dictionary can still be understood; frames tagged with any other
+ * dictionary are rejected.
+ */
+class ZstdMessageCompressor final : public MessageCompressorBase {
+public:
+    /**
+     * Throws a DBException if the dictionary contents are not a trained zstd dictionary.
+     */
+    explicit ZstdMessageCompressor(
+        int compressionLevel = ZstdMessageCompressorSettings::kDefaultCompressionLevel,
+        const std::string& dictionary = std::string());
+
+    ~ZstdMessageCompressor();
+
+    std::size_t getMaxCompressedSize(size_t inputSize) override;
+
+    StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
+
+    StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+private:
+    struct Dictionaries;
+
+    const int _compressionLevel;
+    std::unique_ptr<Dictionaries> _dictionaries;
+};
+
+}  // namespace mongo
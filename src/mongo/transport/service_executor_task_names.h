@@ -35,6 +35,7 @@ enum class ServiceExecutorTaskName {
     kSSMSourceMessage,
     kSSMExhaustMessage,
     kSSMStartSession,
+    kSSMDeferredResponse,
     kMaxTaskName
 };
 
@@ -42,6 +43,7 @@ constexpr auto kSSMProcessMessageName = "processMessage"_sd;
 constexpr auto kSSMSourceMessageName = "sourceMessage"_sd;
 constexpr auto kSSMExhaustMessageName = "exhaustMessage"_sd;
 constexpr auto kSSMStartSessionName = "startSession"_sd;
+constexpr auto kSSMDeferredResponseName = "deferredResponse"_sd;
 
 inline StringData taskNameToString(ServiceExecutorTaskName taskName) {
     switch (taskName) {
@@ -53,6 +55,8 @@ inline StringData taskNameToString(ServiceExecutorTaskName taskName) {
             return kSSMExhaustMessageName;
         case ServiceExecutorTaskName::kSSMStartSession:
             return kSSMStartSessionName;
+        case ServiceExecutorTaskName::kSSMDeferredResponse:
+            return kSSMDeferredResponseName;
         default:
             MONGO_UNREACHABLE;
     }
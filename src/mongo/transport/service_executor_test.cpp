@@ -35,10 +35,12 @@
 #include "mongo/db/service_context_noop.h"
 #include "mongo/transport/service_executor_adaptive.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/service_executor_work_stealing.h"
 #include "mongo/transport/service_executor_task_names.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 #include <asio.hpp>
 
@@ -106,6 +108,43 @@ protected:
     std::unique_ptr<ServiceExecutorSynchronous> executor;
 };
 
+struct WorkStealingTestOptions : public ServiceExecutorWorkStealing::Options {
+    int workerThreads() const final {
+        return 2;
+    }
+
+    int recursionLimit() const final {
+        return 0;
+    }
+
+    Milliseconds idlePollInterval() const final {
+        return Milliseconds{10};
+    }
+
+    Milliseconds stuckThreadTimeout() const final {
+        return Milliseconds{50};
+    }
+
+    Milliseconds extraThreadIdleTimeout() const final {
+        return Milliseconds{100};
+    }
+};
+
+class ServiceExecutorWorkStealingFixture : public unittest::Test {
+protected:
+    void setUp() override {
+        auto scOwned = stdx::make_unique<ServiceContextNoop>();
+        setGlobalServiceContext(std::move(scOwned));
+        asioIOCtx = std::make_shared<asio::io_context>();
+
+        executor = stdx::make_unique<ServiceExecutorWorkStealing>(
+            getGlobalServiceContext(), asioIOCtx, stdx::make_unique<WorkStealingTestOptions>());
+    }
+
+    std::unique_ptr<ServiceExecutorWorkStealing> executor;
+    std::shared_ptr<asio::io_context> asioIOCtx;
+};
+
 void scheduleBasicTask(ServiceExecutor* exec, bool expectSuccess) {
     stdx::condition_variable cond;
     stdx::mutex mutex;
@@ -147,6 +186,145 @@ TEST_F(ServiceExecutorSynchronousFixture, ScheduleFailsBeforeStartup) {
     scheduleBasicTask(executor.get(), false);
 }
 
+TEST_F(ServiceExecutorWorkStealingFixture, BasicTaskRuns) {
+    ASSERT_OK(executor->start());
+    auto guard = MakeGuard([this] { ASSERT_OK(executor->shutdown(Milliseconds{500})); });
+
+    scheduleBasicTask(executor.get(), true);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, ScheduleFailsBeforeStartup) {
+    scheduleBasicTask(executor.get(), false);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, QueuedTaskIsStolenFromBusyWorker) {
+    stdx::mutex mutex;
+    stdx::condition_variable cond;
+    bool blockerRunning = false;
+    bool releaseBlocker = false;
+    bool stolenTaskRan = false;
+    Status followUpStatus = Status::OK();
+
+    ASSERT_OK(executor->start());
+    auto guard = MakeGuard([&] {
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            releaseBlocker = true;
+            cond.notify_all();
+        }
+        ASSERT_OK(executor->shutdown(Milliseconds{500}));
+    });
+
+    // The blocking task queues its follow-up onto its own worker's run queue and then refuses to
+    // return until that follow-up has run, so the follow-up can only run if it is stolen.
+    auto status = executor->schedule(
+        [&] {
+            auto status = executor->schedule(
+                [&] {
+                    stdx::lock_guard<stdx::mutex> lk(mutex);
+                    stolenTaskRan = true;
+                    cond.notify_all();
+                },
+                ServiceExecutor::kEmptyFlags,
+                ServiceExecutorTaskName::kSSMProcessMessage);
+
+            stdx::unique_lock<stdx::mutex> lk(mutex);
+            followUpStatus = std::move(status);
+            blockerRunning = true;
+            cond.notify_all();
+            cond.wait(lk, [&] { return releaseBlocker; });
+        },
+        ServiceExecutor::kEmptyFlags,
+        ServiceExecutorTaskName::kSSMStartSession);
+    ASSERT_OK(status);
+
+    stdx::unique_lock<stdx::mutex> lk(mutex);
+    ASSERT_TRUE(cond.wait_for(
+        lk, Seconds{10}.toSystemDuration(), [&] { return blockerRunning && stolenTaskRan; }));
+    ASSERT_OK(followUpStatus);
+    lk.unlock();
+
+    BSONObjBuilder bob;
+    executor->appendStats(&bob);
+    auto obj = bob.obj();
+    auto stats = obj.getObjectField("serviceExecutorTaskStats");
+    ASSERT_EQ(stats.getStringField("executor"), std::string("workStealing"));
+    ASSERT_EQ(stats.getIntField("threadsRunning"), 2);
+    ASSERT_GTE(stats["totalStolen"].numberLong(), 1);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, ExtraThreadStartedWhenAllWorkersBlocked) {
+    stdx::mutex mutex;
+    stdx::condition_variable cond;
+    int blockersRunning = 0;
+    bool releaseBlockers = false;
+    bool queuedTaskRan = false;
+
+    ASSERT_OK(executor->start());
+    auto guard = MakeGuard([&] {
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            releaseBlockers = true;
+            cond.notify_all();
+        }
+        ASSERT_OK(executor->shutdown(Milliseconds{500}));
+    });
+
+    // Occupy both workers with tasks that block until the end of the test, as operations waiting
+    // for write concern or on a lock would
+    auto blocker = [&] {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        ++blockersRunning;
+        cond.notify_all();
+        cond.wait(lk, [&] { return releaseBlockers; });
+    };
+    for (int i = 0; i < 2; i++) {
+        ASSERT_OK(executor->schedule(
+            blocker, ServiceExecutor::kEmptyFlags, ServiceExecutorTaskName::kSSMProcessMessage));
+    }
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        ASSERT_TRUE(cond.wait_for(
+            lk, Seconds{10}.toSystemDuration(), [&] { return blockersRunning == 2; }));
+    }
+
+    // Nothing but an extra worker can run this task
+    ASSERT_OK(executor->schedule(
+        [&] {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            queuedTaskRan = true;
+            cond.notify_all();
+        },
+        ServiceExecutor::kEmptyFlags,
+        ServiceExecutorTaskName::kSSMProcessMessage));
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        ASSERT_TRUE(
+            cond.wait_for(lk, Seconds{10}.toSystemDuration(), [&] { return queuedTaskRan; }));
+    }
+
+    BSONObjBuilder bob;
+    executor->appendStats(&bob);
+    auto obj = bob.obj();
+    auto stats = obj.getObjectField("serviceExecutorTaskStats");
+    ASSERT_GTE(stats["totalExtraThreadsStarted"].numberLong(), 1);
+
+    // Once the blockers are done, the extra workers go away after being idle for a while
+    {
+        stdx::lock_guard<stdx::mutex> lk(mutex);
+        releaseBlockers = true;
+        cond.notify_all();
+    }
+
+    const auto deadline = Date_t::now() + Seconds{10};
+    while (executor->threadsRunning() > 2 && Date_t::now() < deadline) {
+        sleepmillis(10);
+    }
+    ASSERT_EQ(executor->threadsRunning(), 2);
+}
+
 
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,462 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kExecutor;
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/service_executor_work_stealing.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/transport/service_entry_point_utils.h"
+#include "mongo/transport/service_executor_task_names.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/net/thread_idle_callback.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
+
+#include <asio.hpp>
+
+namespace mongo {
+namespace transport {
+namespace {
+// The number of worker threads, each with its own run queue. If the value is -1 (the default)
+// then it will be set to the number of cores.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(workStealingServiceExecutorThreads, int, -1);
+
+// Tasks scheduled with MayRecurse may be called recursively if the recursion depth is below this
+// value.
+MONGO_EXPORT_SERVER_PARAMETER(workStealingServiceExecutorRecursionLimit, int, 8);
+
+// Idle workers block on network I/O for at most this many milliseconds before re-checking the
+// run queues. Newly queued work wakes them sooner, so this only bounds missed wakeups.
+MONGO_EXPORT_SERVER_PARAMETER(workStealingServiceExecutorIdlePollMillis, int, 50);
+
+// If every worker has been busy for this many milliseconds without a new task starting, an extra
+// worker is started so that queued work and network I/O are not starved by blocked tasks.
+MONGO_EXPORT_SERVER_PARAMETER(workStealingServiceExecutorStuckThreadTimeoutMillis, int, 250);
+
+// Extra workers exit once they have not run a task for this many milliseconds.
+MONGO_EXPORT_SERVER_PARAMETER(workStealingServiceExecutorExtraThreadIdleMillis, int, 30000);
+
+// A worker with a steady backlog polls the io_context once every this many tasks so that network
+// completions are not starved by queued work.
+constexpr int64_t kTasksPerIOPoll = 16;
+
+constexpr auto kTotalQueued = "totalQueued"_sd;
+constexpr auto kTotalQueuedLocally = "totalQueuedLocally"_sd;
+constexpr auto kTotalExecuted = "totalExecuted"_sd;
+constexpr auto kTotalStolen = "totalStolen"_sd;
+constexpr auto kTasksQueued = "tasksQueued"_sd;
+constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kThreadsIdle = "threadsIdle"_sd;
+constexpr auto kThreadsInUse = "threadsInUse"_sd;
+constexpr auto kTotalExtraThreadsStarted = "totalExtraThreadsStarted"_sd;
+constexpr auto kRunQueues = "runQueues"_sd;
+constexpr auto kDepth = "depth"_sd;
+constexpr auto kExecutorLabel = "executor"_sd;
+constexpr auto kExecutorName = "workStealing"_sd;
+
+struct ServerParameterOptions : public ServiceExecutorWorkStealing::Options {
+    int workerThreads() const final {
+        int value = workStealingServiceExecutorThreads;
+        if (value <= 0) {
+            ProcessInfo pi;
+            value = std::max(static_cast<int>(pi.getNumAvailableCores().value_or(pi.getNumCores())),
+                             2);
+            log() << "No thread count configured for executor. Using number of cores: " << value;
+        }
+        return value;
+    }
+
+    int recursionLimit() const final {
+        return workStealingServiceExecutorRecursionLimit.load();
+    }
+
+    Milliseconds idlePollInterval() const final {
+        return Milliseconds{std::max(workStealingServiceExecutorIdlePollMillis.load(), 1)};
+    }
+
+    Milliseconds stuckThreadTimeout() const final {
+        return Milliseconds{
+            std::max(workStealingServiceExecutorStuckThreadTimeoutMillis.load(), 10)};
+    }
+
+    Milliseconds extraThreadIdleTimeout() const final {
+        return Milliseconds{std::max(workStealingServiceExecutorExtraThreadIdleMillis.load(), 0)};
+    }
+};
+
+}  // namespace
+
+thread_local ServiceExecutorWorkStealing::ThreadState
+    ServiceExecutorWorkStealing::_localThreadState = {};
+
+ServiceExecutorWorkStealing::ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                                         std::shared_ptr<asio::io_context> ioCtx)
+    : ServiceExecutorWorkStealing(
+          ctx, std::move(ioCtx), stdx::make_unique<ServerParameterOptions>()) {}
+
+ServiceExecutorWorkStealing::ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                                         std::shared_ptr<asio::io_context> ioCtx,
+                                                         std::unique_ptr<Options> config)
+    : _ioContext(std::move(ioCtx)), _config(std::move(config)) {}
+
+ServiceExecutorWorkStealing::~ServiceExecutorWorkStealing() {
+    invariant(!_isRunning.load());
+}
+
+Status ServiceExecutorWorkStealing::start() {
+    invariant(!_isRunning.load());
+
+    const auto numQueues = static_cast<size_t>(std::max(_config->workerThreads(), 1));
+    _queues.clear();
+    for (size_t i = 0; i < numQueues; i++) {
+        _queues.emplace_back(stdx::make_unique<RunQueue>());
+    }
+
+    _isRunning.store(true);
+
+    // A queue whose worker failed to launch is still drained by the other workers stealing from
+    // it, so only fail startup if no worker at all could be started.
+    Status lastError = Status::OK();
+    for (size_t i = 0; i < numQueues; i++) {
+        _threadsRunning.addAndFetch(1);
+        auto launchResult =
+            launchServiceWorkerThread([this, i] { _workerThreadRoutine(i, false); });
+        if (!launchResult.isOK()) {
+            warning() << "Failed to launch new worker thread: " << launchResult;
+            _threadsRunning.subtractAndFetch(1);
+            lastError = std::move(launchResult);
+        }
+    }
+
+    if (_threadsRunning.load() == 0) {
+        _isRunning.store(false);
+        return lastError;
+    }
+
+    _controllerThread =
+        stdx::thread(&ServiceExecutorWorkStealing::_controllerThreadRoutine, this);
+
+    return Status::OK();
+}
+
+Status ServiceExecutorWorkStealing::shutdown(Milliseconds timeout) {
+    if (!_isRunning.load())
+        return Status::OK();
+
+    LOG(3) << "Shutting down work stealing executor";
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _isRunning.store(false);
+        _controllerCondition.notify_one();
+    }
+    _controllerThread.join();
+
+    stdx::unique_lock<stdx::mutex> lk(_threadsMutex);
+    _ioContext->stop();
+    bool result = _deathCondition.wait_for(
+        lk, timeout.toSystemDuration(), [&] { return _threadsRunning.load() == 0; });
+
+    return result
+        ? Status::OK()
+        : Status(ErrorCodes::Error::ExceededTimeLimit,
+                 "work stealing executor couldn't shutdown all worker threads within time limit.");
+}
+
+Status ServiceExecutorWorkStealing::schedule(Task task,
+                                             ScheduleFlags flags,
+                                             ServiceExecutorTaskName taskName) {
+    if (!_isRunning.load()) {
+        return {ErrorCodes::ShutdownInProgress, "Executor is not running"};
+    }
+
+    const bool isLocalWorker = _isLocalWorker();
+
+    // Run the task inline if the caller allows it and we are not over the depth limit. This keeps
+    // a session's next step on the thread (and core) that just finished the previous one.
+    if (isLocalWorker && (flags & kMayRecurse) &&
+        (_localThreadState.recursionDepth < _config->recursionLimit())) {
+        ++_localThreadState.recursionDepth;
+        const auto guard = MakeGuard([] { --_localThreadState.recursionDepth; });
+
+        _totalQueued.addAndFetch(1);
+        _totalQueuedLocally.addAndFetch(1);
+        task();
+        _queues[_localThreadState.queueIndex]->totalExecuted.addAndFetch(1);
+        _totalExecuted.addAndFetch(1);
+        return Status::OK();
+    }
+
+    // Work scheduled by a worker stays on that worker's queue. Everything else, which is mostly
+    // new sessions, is spread over the queues round-robin.
+    const auto queueIndex = isLocalWorker
+        ? _localThreadState.queueIndex
+        : static_cast<size_t>(_nextQueue.fetchAndAdd(1) % _queues.size());
+    auto& queue = *_queues[queueIndex];
+
+    bool hadBacklog;
+    {
+        stdx::lock_guard<stdx::mutex> lk(queue.mutex);
+        hadBacklog = !queue.tasks.empty();
+        queue.tasks.emplace_back(std::move(task));
+    }
+
+    _tasksQueued.addAndFetch(1);
+    _totalQueued.addAndFetch(1);
+    if (isLocalWorker) {
+        _totalQueuedLocally.addAndFetch(1);
+    }
+
+    // A worker scheduling onto its own empty queue will pick the task up as soon as it returns,
+    // so there is only something for an idle sibling to do if the task can be stolen.
+    if (!isLocalWorker || hadBacklog) {
+        _wakeIdleWorker();
+    }
+
+    return Status::OK();
+}
+
+bool ServiceExecutorWorkStealing::_isLocalWorker() const {
+    return _localThreadState.executor == this;
+}
+
+void ServiceExecutorWorkStealing::_wakeIdleWorker() {
+    if (_threadsIdle.load() > 0) {
+        // Any worker blocked in run_one_for() will return after running this no-op handler and
+        // then find the new task in its own queue or by stealing it.
+        _ioContext->post([] {});
+    }
+}
+
+bool ServiceExecutorWorkStealing::_runNextTask(size_t queueIndex) {
+    Task task;
+    const auto tryPop = [&task](RunQueue& queue) {
+        stdx::lock_guard<stdx::mutex> lk(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    };
+
+    if (!tryPop(*_queues[queueIndex])) {
+        if (_tasksQueued.load() == 0)
+            return false;
+
+        // Steal the oldest task from the first sibling that has one, so that a session stuck
+        // behind a long-running task on a busy worker is picked up by an idle one.
+        bool stolen = false;
+        for (size_t i = 1; i < _queues.size() && !stolen; i++) {
+            auto& victim = *_queues[(queueIndex + i) % _queues.size()];
+            if (tryPop(victim)) {
+                victim.totalStolen.addAndFetch(1);
+                _totalStolen.addAndFetch(1);
+                stolen = true;
+            }
+        }
+
+        if (!stolen)
+            return false;
+    }
+
+    _tasksQueued.subtractAndFetch(1);
+    _tasksStarted.addAndFetch(1);
+
+    _threadsInUse.addAndFetch(1);
+    const auto inUseGuard = MakeGuard([this] { _threadsInUse.subtractAndFetch(1); });
+
+    _localThreadState.recursionDepth = 1;
+    task();
+
+    _queues[queueIndex]->totalExecuted.addAndFetch(1);
+    _totalExecuted.addAndFetch(1);
+    return true;
+}
+
+void ServiceExecutorWorkStealing::_controllerThreadRoutine() {
+    setThreadName("worker-controller"_sd);
+
+    auto lastTasksStarted = _tasksStarted.load();
+    while (true) {
+        {
+            stdx::unique_lock<stdx::mutex> lk(_threadsMutex);
+            _controllerCondition.wait_for(lk,
+                                          _config->stuckThreadTimeout().toSystemDuration(),
+                                          [this] { return !_isRunning.load(); });
+        }
+
+        if (!_isRunning.load())
+            break;
+
+        // If every worker is running a task, none of them started a new one during the whole
+        // timeout and there is still work waiting in the run queues, then they are all blocked
+        // and nothing is draining the queues, so start another worker to unblock the executor.
+        // Workers that are merely busy with long-running tasks while the queues are empty don't
+        // need any help.
+        const auto tasksStarted = _tasksStarted.load();
+        const bool madeProgress = tasksStarted != lastTasksStarted;
+        lastTasksStarted = tasksStarted;
+
+        if (madeProgress || _threadsInUse.load() < _threadsRunning.load())
+            continue;
+
+        if (_tasksQueued.load() == 0)
+            continue;
+
+        log() << "Detected blocked worker threads, "
+              << "starting new thread to unblock service executor";
+        _startExtraWorkerThread();
+    }
+}
+
+void ServiceExecutorWorkStealing::_startExtraWorkerThread() {
+    // Extra workers have no run queue of their own, so they adopt one to schedule their local
+    // work onto. Whatever they leave behind is stolen by the other workers.
+    const auto threadNum = _totalExtraThreadsStarted.fetchAndAdd(1);
+    const auto queueIndex = static_cast<size_t>(threadNum) % _queues.size();
+
+    _threadsRunning.addAndFetch(1);
+    auto launchResult = launchServiceWorkerThread(
+        [this, queueIndex] { _workerThreadRoutine(queueIndex, true); });
+    if (!launchResult.isOK()) {
+        warning() << "Failed to launch new worker thread: " << launchResult;
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _threadsRunning.subtractAndFetch(1);
+        _deathCondition.notify_one();
+    }
+}
+
+void ServiceExecutorWorkStealing::_workerThreadRoutine(size_t queueIndex, bool isExtraThread) {
+    {
+        std::string threadName = str::stream() << "worker-" << (isExtraThread ? "extra-" : "")
+                                               << queueIndex;
+        setThreadName(threadName);
+    }
+
+    log() << "Started new work stealing " << (isExtraThread ? "extra " : "") << "worker thread "
+          << queueIndex;
+
+    _localThreadState.executor = this;
+    _localThreadState.queueIndex = queueIndex;
+
+    const auto guard = MakeGuard([this] {
+        _localThreadState = ThreadState{};
+
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _threadsRunning.subtractAndFetch(1);
+        _deathCondition.notify_one();
+    });
+
+    int64_t tasksSinceIOPoll = 0;
+    int64_t markIdleCounter = 0;
+    auto lastTaskRun = Date_t::now();
+    while (_isRunning.load()) {
+        try {
+            if (_runNextTask(queueIndex)) {
+                if (isExtraThread) {
+                    lastTaskRun = Date_t::now();
+                }
+
+                if ((markIdleCounter++ & 0xf) == 0) {
+                    markThreadIdle();
+                }
+
+                if (++tasksSinceIOPoll >= kTasksPerIOPoll) {
+                    tasksSinceIOPoll = 0;
+                    _ioContext->poll_one();
+                }
+                continue;
+            }
+
+            tasksSinceIOPoll = 0;
+
+            // Advertise ourselves as idle before the final check of the queues. schedule()
+            // counts the task before looking for idle workers, so one of the two sides is
+            // guaranteed to see the other.
+            _threadsIdle.addAndFetch(1);
+            const auto idleGuard = MakeGuard([this] { _threadsIdle.subtractAndFetch(1); });
+            if (_tasksQueued.load() > 0)
+                continue;
+
+            asio::io_context::work work(*_ioContext);
+            _ioContext->run_one_for(_config->idlePollInterval().toSystemDuration());
+
+            // run_one_for() returns immediately once the io_context has stopped, which happens
+            // whenever it runs out of work, so restart it unless we are shutting down.
+            if (_ioContext->stopped() && _isRunning.load())
+                _ioContext->restart();
+
+            if (isExtraThread &&
+                Date_t::now() - lastTaskRun >= _config->extraThreadIdleTimeout()) {
+                LOG(1) << "Extra work stealing worker thread " << queueIndex
+                       << " is idle, exiting";
+                break;
+            }
+        } catch (const std::exception& e) {
+            log() << "Exception escaped work stealing worker thread: " << e.what();
+        } catch (...) {
+            log() << "Unknown exception escaped work stealing worker thread";
+        }
+    }
+}
+
+void ServiceExecutorWorkStealing::appendStats(BSONObjBuilder* bob) const {
+    BSONObjBuilder section(bob->subobjStart("serviceExecutorTaskStats"));
+    section << kExecutorLabel << kExecutorName                    //
+            << kTotalQueued << _totalQueued.load()                //
+            << kTotalQueuedLocally << _totalQueuedLocally.load()  //
+            << kTotalExecuted << _totalExecuted.load()            //
+            << kTotalStolen << _totalStolen.load()                //
+            << kTasksQueued << _tasksQueued.load()                //
+            << kThreadsRunning << _threadsRunning.load()          //
+            << kThreadsIdle << _threadsIdle.load()                //
+            << kThreadsInUse << _threadsInUse.load()              //
+            << kTotalExtraThreadsStarted << _totalExtraThreadsStarted.load();
+
+    BSONArrayBuilder runQueues(section.subarrayStart(kRunQueues));
+    for (const auto& queue : _queues) {
+        long long depth;
+        {
+            stdx::lock_guard<stdx::mutex> lk(queue->mutex);
+            depth = static_cast<long long>(queue->tasks.size());
+        }
+
+        runQueues.append(BSON(kDepth << depth << kTotalExecuted << queue->totalExecuted.load()
+                                     << kTotalStolen
+                                     << queue->totalStolen.load()));
+    }
+    runQueues.doneFast();
+}
+
+}  // namespace transport
+}  // namespace mongo
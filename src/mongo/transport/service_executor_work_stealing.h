@@ -0,0 +1,184 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_task_names.h"
+
+#include <asio.hpp>
+
+namespace mongo {
+namespace transport {
+
+/**
+ * This is an ASIO-based ServiceExecutor with one run queue per worker thread. Worker threads are
+ * sized to the number of cores and stay up for as long as the executor is running.
+ *
+ * Tasks scheduled from a worker thread go onto that worker's own queue, so the continuation of a
+ * ServiceStateMachine stays on the core that just ran it or completed its network I/O. Tasks
+ * scheduled from outside the executor (such as new sessions) are spread round-robin. Workers
+ * that run out of local work steal the oldest task from their siblings, and service network
+ * I/O on the shared io_context while there is nothing to run.
+ *
+ * A controller thread watches for every worker being stuck in a long running task, such as a
+ * write concern wait or a blocking getMore, while no new task gets to start. When that happens
+ * it starts an extra worker, which steals queued work and services network I/O until it has been
+ * idle for a while, so that replication heartbeats and progress updates can't be starved.
+ */
+class ServiceExecutorWorkStealing final : public ServiceExecutor {
+public:
+    struct Options {
+        virtual ~Options() = default;
+        // The number of worker threads (and run queues) the executor starts.
+        virtual int workerThreads() const = 0;
+
+        // The maximum allowable depth of recursion for tasks scheduled with the MayRecurse flag
+        // before stack unwinding is forced.
+        virtual int recursionLimit() const = 0;
+
+        // The longest an idle worker waits on network I/O before checking the run queues again.
+        virtual Milliseconds idlePollInterval() const = 0;
+
+        // How long every worker must be busy without a new task starting before an extra worker
+        // is started to unblock the executor.
+        virtual Milliseconds stuckThreadTimeout() const = 0;
+
+        // How long an extra worker may go without running a task before it exits.
+        virtual Milliseconds extraThreadIdleTimeout() const = 0;
+    };
+
+    explicit ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                         std::shared_ptr<asio::io_context> ioCtx);
+    explicit ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                         std::shared_ptr<asio::io_context> ioCtx,
+                                         std::unique_ptr<Options> config);
+
+    ~ServiceExecutorWorkStealing();
+
+    Status start() override;
+    Status shutdown(Milliseconds timeout) override;
+    Status schedule(Task task, ScheduleFlags flags, ServiceExecutorTaskName taskName) override;
+
+    Mode transportMode() const override {
+        return Mode::kAsynchronous;
+    }
+
+    void appendStats(BSONObjBuilder* bob) const override;
+
+    int threadsRunning() const {
+        return _threadsRunning.load();
+    }
+
+private:
+    struct RunQueue {
+        stdx::mutex mutex;
+        std::deque<Task> tasks;
+
+        AtomicWord<int64_t> totalExecuted{0};
+        AtomicWord<int64_t> totalStolen{0};
+    };
+
+    struct ThreadState {
+        const ServiceExecutorWorkStealing* executor = nullptr;
+        size_t queueIndex = 0;
+        int recursionDepth = 0;
+    };
+
+    void _workerThreadRoutine(size_t queueIndex, bool isExtraThread);
+
+    void _controllerThreadRoutine();
+
+    /**
+     * Starts an extra worker to unblock a stuck executor. Extra workers are assigned run queues
+     * round-robin (the Nth extra worker gets queue N % _queues.size()) and, like every other
+     * worker, steal from the remaining queues when theirs is empty.
+     */
+    void _startExtraWorkerThread();
+
+    /**
+     * Runs the next task from the given worker's own queue or, failing that, one stolen from
+     * another queue. Returns false if every queue was empty.
+     */
+    bool _runNextTask(size_t queueIndex);
+
+    /**
+     * Wakes a worker blocked waiting on network I/O so it can pick up newly queued work.
+     */
+    void _wakeIdleWorker();
+
+    bool _isLocalWorker() const;
+
+    std::shared_ptr<asio::io_context> _ioContext;
+
+    std::unique_ptr<Options> _config;
+
+    std::vector<std::unique_ptr<RunQueue>> _queues;
+
+    AtomicWord<bool> _isRunning{false};
+    AtomicWord<uint64_t> _nextQueue{0};
+
+    AtomicWord<int> _threadsRunning{0};
+    AtomicWord<int> _threadsIdle{0};
+    AtomicWord<int> _threadsInUse{0};
+    AtomicWord<int64_t> _tasksQueued{0};
+
+    // Counts every task a worker dequeued and started, so that the controller can tell whether
+    // the executor made any progress since it last checked.
+    AtomicWord<int64_t> _tasksStarted{0};
+
+    // These counters are only used for reporting in serverStatus.
+    AtomicWord<int64_t> _totalQueued{0};
+    AtomicWord<int64_t> _totalQueuedLocally{0};
+    AtomicWord<int64_t> _totalExecuted{0};
+    AtomicWord<int64_t> _totalStolen{0};
+    AtomicWord<int64_t> _totalExtraThreadsStarted{0};
+
+    // Threads signal this condition variable when they exit so we can gracefully shutdown
+    // the executor.
+    mutable stdx::mutex _threadsMutex;
+    stdx::condition_variable _deathCondition;
+
+    // Signalled on shutdown to stop the controller thread.
+    stdx::condition_variable _controllerCondition;
+    stdx::thread _controllerThread;
+
+    static thread_local ThreadState _localThreadState;
+};
+
+}  // namespace transport
+}  // namespace mongo
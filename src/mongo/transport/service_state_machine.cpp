@@ -35,6 +35,7 @@
 #include "mongo/config.h"
 #include "mongo/db/client.h"
 #include "mongo/db/dbmessage.h"
+#include "mongo/db/deferred_response.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_manager.h"
@@ -56,6 +57,19 @@
 
 namespace mongo {
 namespace {
+// Exhaust replies are held back and sent together with the ones that follow them, in a single
+// gather write, until either limit below would be exceeded.
+constexpr size_t kMaxCoalescedExhaustBytes = 64 * 1024;
+constexpr size_t kMaxCoalescedExhaustReplies = 16;
+
+// A getMore on a tailable cursor may wait for new data to arrive, so replies to those are never
+// held back.
+bool isTailableQuery(const Message& m) {
+    if (m.operation() != dbQuery)
+        return false;
+    return DbMessage(m).reservedField() & QueryOption_CursorTailable;
+}
+
 // Set up proper headers for formatting an exhaust request, if we need to
 bool setExhaustMessage(Message* m, const DbResponse& dbresponse) {
     MsgData::View header = dbresponse.response.header();
@@ -231,7 +245,10 @@ ServiceStateMachine::ServiceStateMachine(ServiceContext* svcContext,
       _sessionHandle(session),
       _dbClient{svcContext->makeClient("conn", std::move(session))},
       _dbClientPtr{_dbClient.get()},
-      _threadName{str::stream() << "conn" << _session()->id()} {}
+      _threadName{str::stream() << "conn" << _session()->id()} {
+    // Only asynchronous sessions give their thread back while a response is deferred.
+    DeferredResponse::setAllowed(_dbClient.get(), _transportMode == transport::Mode::kAsynchronous);
+}
 
 const transport::SessionHandle& ServiceStateMachine::_session() const {
     return _sessionHandle;
@@ -256,8 +273,17 @@ void ServiceStateMachine::_sourceMessage(ThreadGuard guard) {
 }
 
 void ServiceStateMachine::_sinkMessage(ThreadGuard guard, Message toSink) {
-    // Sink our response to the client
-    auto ticket = _session()->sinkMessage(toSink);
+    // Sink our response to the client, along with any exhaust replies held back to share its write
+    auto ticket = [&] {
+        if (_pendingExhaustReplies.empty())
+            return _session()->sinkMessage(toSink);
+
+        _pendingExhaustReplies.push_back(std::move(toSink));
+        auto batchTicket = _session()->sinkMessages(_pendingExhaustReplies);
+        _pendingExhaustReplies.clear();
+        _pendingExhaustBytes = 0;
+        return batchTicket;
+    }();
 
     _state.store(State::SinkWait);
     guard.release();
@@ -343,32 +369,74 @@ void ServiceStateMachine::_sinkCallback(Status status) {
     }
 }
 
+void ServiceStateMachine::_deferredResponseCallback() {
+    // The first thing to do is create a ThreadGuard which will take ownership of the SSM in this
+    // thread.
+    ThreadGuard guard(this);
+
+    dassert(state() == State::ProcessWait);
+    _state.store(State::Process);
+    _runNextInGuard(std::move(guard));
+}
+
+void ServiceStateMachine::_waitForDeferredResponse(ThreadGuard guard) {
+    auto deferred = _deferredResponse;
+
+    _state.store(State::ProcessWait);
+    guard.release();
+
+    // The callback may run on any thread, including this one before whenReady() returns, and
+    // possibly with locks held, so all it does is hand the SSM back to the executor.
+    deferred->whenReady([ssm = shared_from_this()] {
+        Status status = ssm->_serviceContext->getServiceExecutor()->schedule(
+            [ssm] { ssm->_deferredResponseCallback(); },
+            ServiceExecutor::kEmptyFlags,
+            transport::ServiceExecutorTaskName::kSSMDeferredResponse);
+
+        // The executor is most likely shutting down. Nothing can run the SSM again, so at least
+        // close the connection rather than leave the client waiting.
+        ssm->_terminateAndLogIfError(status);
+    });
+}
+
 void ServiceStateMachine::_processMessage(ThreadGuard guard) {
     invariant(!_inMessage.empty());
 
     auto& compressorMgr = MessageCompressorManager::forSession(_session());
 
-    _compressorId = boost::none;
-    if (_inMessage.operation() == dbCompressed) {
-        MessageCompressorId compressorId;
-        auto swm = compressorMgr.decompressMessage(_inMessage, &compressorId);
-        uassertStatusOK(swm.getStatus());
-        _inMessage = swm.getValue();
-        _compressorId = compressorId;
-    }
+    // Each opCtx below is destroyed before the response is sunk, so that the operation cannot show
+    // up in currentOp results after the response reaches the client.
+    DbResponse dbresponse;
+    if (_deferredResponse) {
+        // A previous call to handleRequest() left its response to be finished now.
+        auto deferred = std::move(_deferredResponse);
+        auto opCtx = Client::getCurrent()->makeOperationContext();
+        dbresponse = deferred->finish(opCtx.get());
+    } else {
+        _compressorId = boost::none;
+        if (_inMessage.operation() == dbCompressed) {
+            MessageCompressorId compressorId;
+            auto swm = compressorMgr.decompressMessage(_inMessage, &compressorId);
+            uassertStatusOK(swm.getStatus());
+            _inMessage = swm.getValue();
+            _compressorId = compressorId;
+        }
 
-    networkCounter.hitLogicalIn(_inMessage.size());
+        networkCounter.hitLogicalIn(_inMessage.size());
 
-    // Pass sourced Message to handler to generate response.
-    auto opCtx = Client::getCurrent()->makeOperationContext();
+        // Pass sourced Message to handler to generate response.
+        auto opCtx = Client::getCurrent()->makeOperationContext();
 
-    // The handleRequest is implemented in a subclass for mongod/mongos and actually all the
-    // database work for this request.
-    DbResponse dbresponse = _sep->handleRequest(opCtx.get(), _inMessage);
+        // The handleRequest is implemented in a subclass for mongod/mongos and actually all the
+        // database work for this request.
+        dbresponse = _sep->handleRequest(opCtx.get(), _inMessage);
+    }
 
-    // opCtx must be destroyed here so that the operation cannot show
-    // up in currentOp results after the response reaches the client
-    opCtx.reset();
+    if (dbresponse.deferred) {
+        invariant(dbresponse.response.empty());
+        _deferredResponse = std::move(dbresponse.deferred);
+        return _waitForDeferredResponse(std::move(guard));
+    }
 
     // Format our response, if we have one
     Message& toSink = dbresponse.response;
@@ -377,6 +445,11 @@ void ServiceStateMachine::_processMessage(ThreadGuard guard) {
         toSink.header().setId(nextMessageId());
         toSink.header().setResponseToMsgId(_inMessage.header().getId());
 
+        if (!_inExhaust && dbresponse.exhaustNS.size() > 0) {
+            _coalesceExhaustReplies = _session()->getTransportLayer()->supportsBatchedSink() &&
+                !isTailableQuery(_inMessage);
+        }
+
         // If this is an exhaust cursor, don't source more Messages
         if (dbresponse.exhaustNS.size() > 0 && setExhaustMessage(&_inMessage, dbresponse)) {
             _inExhaust = true;
@@ -392,8 +465,30 @@ void ServiceStateMachine::_processMessage(ThreadGuard guard) {
             uassertStatusOK(swm.getStatus());
             toSink = swm.getValue();
         }
+
+        // Hold small exhaust replies back so that several of them go out with a single write,
+        // and go straight on to producing the next batch.
+        if (_inExhaust && _coalesceExhaustReplies &&
+            _pendingExhaustReplies.size() + 1 < kMaxCoalescedExhaustReplies &&
+            _pendingExhaustBytes + toSink.size() < kMaxCoalescedExhaustBytes) {
+            _pendingExhaustBytes += toSink.size();
+            _pendingExhaustReplies.push_back(std::move(toSink));
+            return _scheduleNextWithGuard(std::move(guard),
+                                          ServiceExecutor::kDeferredTask |
+                                              ServiceExecutor::kMayYieldBeforeSchedule,
+                                          transport::ServiceExecutorTaskName::kSSMExhaustMessage);
+        }
+
         _sinkMessage(std::move(guard), std::move(toSink));
 
+    } else if (!_pendingExhaustReplies.empty()) {
+        // Nothing more to add to the held back exhaust replies, so send them on their own.
+        _inExhaust = false;
+        _inMessage.reset();
+        auto last = std::move(_pendingExhaustReplies.back());
+        _pendingExhaustReplies.pop_back();
+        _pendingExhaustBytes -= last.size();
+        _sinkMessage(std::move(guard), std::move(last));
     } else {
         _state.store(State::Source);
         _inMessage.reset();
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <atomic>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/config.h"
@@ -47,6 +48,8 @@
 
 namespace mongo {
 
+class DeferredResponse;
+
 /*
  * The ServiceStateMachine holds the state of a single client connection and represents the
  * lifecycle of each user request as a state machine. It is the glue between the stateless
@@ -80,16 +83,18 @@ public:
      * Source -> SourceWait -> Process -> SinkWait -> Source (standard RPC)
      * Source -> SourceWait -> Process -> SinkWait -> Process -> SinkWait ... (exhaust)
      * Source -> SourceWait -> Process -> Source (fire-and-forget)
+     * Source -> SourceWait -> Process -> ProcessWait -> Process -> SinkWait (deferred response)
      */
     enum class State {
-        Created,     // The session has been created, but no operations have been performed yet
-        Source,      // Request a new Message from the network to handle
-        SourceWait,  // Wait for the new Message to arrive from the network
-        Process,     // Run the Message through the database
-        SinkWait,    // Wait for the database result to be sent by the network
-        EndSession,  // End the session - the ServiceStateMachine will be invalid after this
-        Ended        // The session has ended. It is illegal to call any method besides
-                     // state() if this is the current state.
+        Created,      // The session has been created, but no operations have been performed yet
+        Source,       // Request a new Message from the network to handle
+        SourceWait,   // Wait for the new Message to arrive from the network
+        Process,      // Run the Message through the database
+        ProcessWait,  // Wait, without a thread, for the database to be ready to finish a response
+        SinkWait,     // Wait for the database result to be sent by the network
+        EndSession,   // End the session - the ServiceStateMachine will be invalid after this
+        Ended         // The session has ended. It is illegal to call any method besides
+                      // state() if this is the current state.
     };
 
     /*
@@ -200,6 +205,13 @@ private:
      */
     void _sourceCallback(Status status);
     void _sinkCallback(Status status);
+    void _deferredResponseCallback();
+
+    /*
+     * Parks the session until _deferredResponse is ready to be finished. This invalidates the
+     * ThreadGuard, and the SSM is not run again until the response is ready.
+     */
+    void _waitForDeferredResponse(ThreadGuard guard);
 
     /*
      * Source/Sink message from the TransportLayer. These will invalidate the ThreadGuard just
@@ -230,6 +242,14 @@ private:
     boost::optional<MessageCompressorId> _compressorId;
     Message _inMessage;
 
+    // Set while the response to _inMessage is waiting on something, see _waitForDeferredResponse().
+    std::shared_ptr<DeferredResponse> _deferredResponse;
+
+    // Small exhaust replies which have not been sunk yet, see _processMessage().
+    bool _coalesceExhaustReplies = false;
+    std::vector<Message> _pendingExhaustReplies;
+    size_t _pendingExhaustBytes = 0;
+
     AtomicWord<Ownership> _owned{Ownership::kUnowned};
 #if MONGO_CONFIG_DEBUG_BUILD
     AtomicWord<stdx::thread::id> _owningThread;
@@ -252,6 +272,9 @@ T& operator<<(T& stream, const ServiceStateMachine::State& state) {
         case ServiceStateMachine::State::Process:
             stream << "process";
             break;
+        case ServiceStateMachine::State::ProcessWait:
+            stream << "processWait";
+            break;
         case ServiceStateMachine::State::SinkWait:
             stream << "sinkWait";
             break;
@@ -30,10 +30,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <boost/optional.hpp>
+#include <deque>
+#include <vector>
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/dbmessage.h"
+#include "mongo/db/deferred_response.h"
 #include "mongo/db/service_context_noop.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/mock_session.h"
@@ -57,6 +62,40 @@ inline std::string stateToString(ServiceStateMachine::State state) {
     return ret;
 }
 
+Message buildPingReply() {
+    OpMsgBuilder builder;
+    builder.setBody(BSON("ok" << 1));
+    return builder.finish();
+}
+
+class MockDeferredResponse : public DeferredResponse {
+public:
+    void whenReady(stdx::function<void()> onReady) override {
+        _onReady = std::move(onReady);
+    }
+
+    DbResponse finish(OperationContext* opCtx) override {
+        ASSERT_TRUE(haveClient());
+        ASSERT_TRUE(opCtx);
+        _finished = true;
+        return DbResponse{buildPingReply()};
+    }
+
+    void signalReady() {
+        ASSERT_TRUE(_onReady);
+        auto onReady = std::move(_onReady);
+        onReady();
+    }
+
+    bool finished() const {
+        return _finished;
+    }
+
+private:
+    stdx::function<void()> _onReady;
+    bool _finished = false;
+};
+
 class MockSEP : public ServiceEntryPoint {
 public:
     virtual ~MockSEP() = default;
@@ -68,17 +107,30 @@ public:
         _ranHandler = true;
         ASSERT_TRUE(haveClient());
 
+        if (!_exhaustCursorIds.empty()) {
+            auto cursorId = _exhaustCursorIds.front();
+            _exhaustCursorIds.pop_front();
+            if (!cursorId)
+                return DbResponse{};
+
+            auto batch = BSON("x" << 1);
+            auto dbresponse =
+                replyToQuery(0, batch.objdata(), batch.objsize(), /*nReturned*/ 1, 0, *cursorId);
+            dbresponse.exhaustNS = "test.exhaust";
+            return dbresponse;
+        }
+
         auto req = OpMsgRequest::parse(request);
         ASSERT_BSONOBJ_EQ(BSON("ping" << 1), req.body);
 
-        // Build out a dummy reply
-        OpMsgBuilder builder;
-        builder.setBody(BSON("ok" << 1));
-
         if (_uassertInHandler)
             uassert(40469, "Synthetic uassert failure", false);
 
-        return DbResponse{builder.finish()};
+        if (_deferredResponse)
+            return DbResponse{Message(), std::string(), std::move(_deferredResponse)};
+
+        // Build out a dummy reply
+        return DbResponse{buildPingReply()};
     }
 
     void endAllSessions(transport::Session::TagMask tags) override {}
@@ -99,6 +151,16 @@ public:
         _uassertInHandler = true;
     }
 
+    void setDeferredResponse(std::shared_ptr<DeferredResponse> deferred) {
+        _deferredResponse = std::move(deferred);
+    }
+
+    // Answers the next requests, and the getMores the SSM issues for them, with exhaust cursor
+    // batches. A cursor id of zero ends the cursor and boost::none produces no reply at all.
+    void setExhaustCursorIds(std::deque<boost::optional<long long>> cursorIds) {
+        _exhaustCursorIds = std::move(cursorIds);
+    }
+
     bool ranHandler() {
         bool ret = _ranHandler;
         _ranHandler = false;
@@ -108,6 +170,8 @@ public:
 private:
     bool _uassertInHandler = false;
     bool _ranHandler = false;
+    std::shared_ptr<DeferredResponse> _deferredResponse;
+    std::deque<boost::optional<long long>> _exhaustCursorIds;
 };
 
 using namespace transport;
@@ -149,10 +213,30 @@ public:
         }
 
         _lastSunk = message;
+        _sunkBatchSizes.push_back(1);
 
         return TransportLayerMock::sinkMessage(session, message, expiration);
     }
 
+    Ticket sinkMessages(const SessionHandle& session,
+                        const std::vector<Message>& messages,
+                        Date_t expiration = Ticket::kNoExpirationDate) override {
+        ASSERT_EQ(_ssm->state(), ServiceStateMachine::State::Process);
+        _lastTicketSource = false;
+
+        log() << "In sinkMessages";
+        _ranSink = true;
+
+        _lastSunk = messages.back();
+        _sunkBatchSizes.push_back(messages.size());
+
+        return TransportLayerMock::sinkMessage(session, messages.back(), expiration);
+    }
+
+    bool supportsBatchedSink() const override {
+        return _supportsBatchedSink;
+    }
+
     Status wait(Ticket&& ticket) override {
         if (!ticket.valid()) {
             return ticket.status();
@@ -197,6 +281,15 @@ public:
         _waitHook = std::move(hook);
     }
 
+    void setSupportsBatchedSink(bool supportsBatchedSink) {
+        _supportsBatchedSink = supportsBatchedSink;
+    }
+
+    // The number of Messages passed to each sink, in order.
+    const std::vector<size_t>& sunkBatchSizes() const {
+        return _sunkBatchSizes;
+    }
+
 private:
     bool _lastTicketSource = true;
     bool _ranSink = false;
@@ -205,6 +298,8 @@ private:
     Message _lastSunk;
     ServiceStateMachine* _ssm;
     stdx::function<void()> _waitHook;
+    bool _supportsBatchedSink = false;
+    std::vector<size_t> _sunkBatchSizes;
 };
 
 Message buildRequest(BSONObj input) {
@@ -368,6 +463,41 @@ TEST_F(ServiceStateMachineFixture, TestSinkError) {
     ASSERT_TRUE(_tl->ranSink());
 }
 
+// This tests that a deferred response parks the SSM without a thread until it is ready, and is
+// then finished and sunk from a newly scheduled task.
+TEST_F(ServiceStateMachineFixture, DeferredResponseResumesWhenReady) {
+    auto deferred = std::make_shared<MockDeferredResponse>();
+    _sep->setDeferredResponse(deferred);
+
+    ServiceExecutor::Task resumeTask;
+    _sexec->setScheduleHook([&resumeTask](auto task) {
+        resumeTask = std::move(task);
+        return true;
+    });
+
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Process);
+
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::ProcessWait);
+    ASSERT_FALSE(haveClient());
+    ASSERT_FALSE(_tl->ranSink());
+    ASSERT_FALSE(deferred->finished());
+
+    resumeTask = nullptr;
+    deferred->signalReady();
+    ASSERT_EQ(_ssm->state(), State::ProcessWait);
+    ASSERT_TRUE(resumeTask);
+
+    auto task = std::move(resumeTask);
+    task();
+    ASSERT_FALSE(haveClient());
+    ASSERT_TRUE(deferred->finished());
+    ASSERT_TRUE(_tl->ranSink());
+    ASSERT_EQ(_ssm->state(), State::Source);
+    checkPingOk();
+}
+
 // This test checks that after the SSM has been cleaned up, the SessionHandle that it passed
 // into the Client doesn't have any dangling shared_ptr copies.
 TEST_F(ServiceStateMachineFixture, TestSessionCleanupOnDestroy) {
@@ -574,5 +704,65 @@ TEST_F(ServiceStateMachineFixture, SSMRunsRecursively) {
     ASSERT_EQ(_ssm->state(), State::Ended);
 }
 
+// This tests that small exhaust replies are held back while the following getMores run, and are
+// sunk together with the final batch of the cursor.
+TEST_F(ServiceStateMachineFixture, ExhaustRepliesAreCoalescedIntoOneSink) {
+    _tl->setSupportsBatchedSink(true);
+    _sep->setExhaustCursorIds({1LL, 1LL, 0LL});
+
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Process);
+
+    // Each batch but the last one is held back and the SSM goes straight on to the next getMore
+    for (int i = 0; i < 2; i++) {
+        _ssm->runNext();
+        ASSERT_TRUE(_sep->ranHandler());
+        ASSERT_EQ(_ssm->state(), State::Process);
+        ASSERT_FALSE(_tl->ranSink());
+    }
+
+    _ssm->runNext();
+    ASSERT_TRUE(_sep->ranHandler());
+    ASSERT_EQ(_ssm->state(), State::Source);
+    ASSERT_TRUE(_tl->ranSink());
+    ASSERT_EQ(_tl->sunkBatchSizes().size(), 1U);
+    ASSERT_EQ(_tl->sunkBatchSizes()[0], 3U);
+}
+
+// This tests that held back exhaust replies are still sunk if the getMore that follows them
+// produces no reply.
+TEST_F(ServiceStateMachineFixture, PendingExhaustRepliesAreSunkWithoutFinalReply) {
+    _tl->setSupportsBatchedSink(true);
+    _sep->setExhaustCursorIds({1LL, 1LL, boost::none});
+
+    _ssm->runNext();
+    _ssm->runNext();
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Process);
+    ASSERT_FALSE(_tl->ranSink());
+
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Source);
+    ASSERT_EQ(_tl->sunkBatchSizes().size(), 1U);
+    ASSERT_EQ(_tl->sunkBatchSizes()[0], 2U);
+}
+
+// This tests that exhaust replies are sunk one at a time by transport layers which can't send
+// several messages at once.
+TEST_F(ServiceStateMachineFixture, ExhaustRepliesAreNotCoalescedWithoutBatchedSink) {
+    _sep->setExhaustCursorIds({1LL, 0LL});
+
+    _ssm->runNext();
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Process);
+    ASSERT_TRUE(_tl->ranSink());
+
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Source);
+    ASSERT_EQ(_tl->sunkBatchSizes().size(), 2U);
+    ASSERT_EQ(_tl->sunkBatchSizes()[0], 1U);
+    ASSERT_EQ(_tl->sunkBatchSizes()[1], 1U);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -53,6 +53,10 @@ Ticket Session::sinkMessage(const Message& message, Date_t expiration) {
     return getTransportLayer()->sinkMessage(shared_from_this(), message, expiration);
 }
 
+Ticket Session::sinkMessages(const std::vector<Message>& messages, Date_t expiration) {
+    return getTransportLayer()->sinkMessages(shared_from_this(), messages, expiration);
+}
+
 void Session::setTags(TagMask tagsToSet) {
     mutateTags([tagsToSet](TagMask originalTags) { return (originalTags | tagsToSet); });
 }
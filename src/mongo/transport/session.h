@@ -108,6 +108,14 @@ public:
     virtual Ticket sinkMessage(const Message& message,
                                Date_t expiration = Ticket::kNoExpirationDate);
 
+    /**
+     * Sink (send) several Messages back to back for this Session.
+     *
+     * This method will forward to sinkMessages on this Session's transport layer.
+     */
+    virtual Ticket sinkMessages(const std::vector<Message>& messages,
+                                Date_t expiration = Ticket::kNoExpirationDate);
+
     /**
      * Return the remote host for this session.
      */
@@ -210,7 +210,7 @@ private:
             // size is > 0.
             ConstBufferSequence asyncBuffers(buffers);
             if (size > 0) {
-                asyncBuffers += size;
+                consumeBuffers(&asyncBuffers, size);
             }
             asio::async_write(stream, asyncBuffers, std::forward<CompleteHandler>(handler));
         } else {
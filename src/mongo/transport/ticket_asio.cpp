@@ -33,6 +33,7 @@
 #include "mongo/base/system_error.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/transport/asio_utils.h"
+#include "mongo/transport/message_buffer_pool.h"
 #include "mongo/transport/ticket_asio.h"
 #include "mongo/util/log.h"
 
@@ -70,7 +71,14 @@ TransportLayerASIO::ASIOSourceTicket::ASIOSourceTicket(const ASIOSessionHandle&
 TransportLayerASIO::ASIOSinkTicket::ASIOSinkTicket(const ASIOSessionHandle& session,
                                                    Date_t expiration,
                                                    const Message& msg)
-    : ASIOTicket(session, expiration), _msgToSend(msg) {}
+    : ASIOTicket(session, expiration), _msgsToSend{msg} {}
+
+TransportLayerASIO::ASIOSinkTicket::ASIOSinkTicket(const ASIOSessionHandle& session,
+                                                   Date_t expiration,
+                                                   const std::vector<Message>& msgs)
+    : ASIOTicket(session, expiration), _msgsToSend(msgs) {
+    invariant(!_msgsToSend.empty());
+}
 
 void TransportLayerASIO::ASIOSourceTicket::_bodyCallback(const std::error_code& ec, size_t size) {
     if (ec) {
@@ -93,7 +101,7 @@ void TransportLayerASIO::ASIOSourceTicket::_headerCallback(const std::error_code
     if (!session)
         return;
 
-    MSGHEADER::View headerView(_buffer.get());
+    MSGHEADER::View headerView(_headerBuffer.data());
     auto msgLen = static_cast<size_t>(headerView.getMessageLength());
     if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
         StringBuilder sb;
@@ -110,7 +118,8 @@ void TransportLayerASIO::ASIOSourceTicket::_headerCallback(const std::error_code
         return;
     }
 
-    _buffer.realloc(msgLen);
+    _buffer = MessageBufferPool::get().allocate(msgLen);
+    memcpy(_buffer.get(), _headerBuffer.data(), kHeaderSize);
     MsgData::View msgView(_buffer.get());
 
     session->read(isSync(),
@@ -123,16 +132,15 @@ void TransportLayerASIO::ASIOSourceTicket::fillImpl() {
     if (!session)
         return;
 
-    const auto initBufSize = kHeaderSize;
-    _buffer = SharedBuffer::allocate(initBufSize);
-
     session->read(isSync(),
-                  asio::buffer(_buffer.get(), initBufSize),
+                  asio::buffer(_headerBuffer.data(), kHeaderSize),
                   [this](const std::error_code& ec, size_t size) { _headerCallback(ec, size); });
 }
 
 void TransportLayerASIO::ASIOSinkTicket::_sinkCallback(const std::error_code& ec, size_t size) {
-    networkCounter.hitPhysicalOut(_msgToSend.size());
+    for (const auto& msg : _msgsToSend) {
+        networkCounter.hitPhysicalOut(msg.size());
+    }
     finishFill(ec ? errorCodeToStatus(ec) : Status::OK());
 }
 
@@ -141,9 +149,24 @@ void TransportLayerASIO::ASIOSinkTicket::fillImpl() {
     if (!session)
         return;
 
-    session->write(isSync(),
-                   asio::buffer(_msgToSend.buf(), _msgToSend.size()),
-                   [this](const std::error_code& ec, size_t size) { _sinkCallback(ec, size); });
+    if (_msgsToSend.size() == 1) {
+        const auto& msg = _msgsToSend.front();
+        session->write(
+            isSync(),
+            asio::buffer(msg.buf(), msg.size()),
+            [this](const std::error_code& ec, size_t size) { _sinkCallback(ec, size); });
+        return;
+    }
+
+    std::vector<asio::const_buffer> buffers;
+    buffers.reserve(_msgsToSend.size());
+    for (const auto& msg : _msgsToSend) {
+        buffers.emplace_back(msg.buf(), msg.size());
+    }
+
+    session->write(isSync(), buffers, [this](const std::error_code& ec, size_t size) {
+        _sinkCallback(ec, size);
+    });
 }
 
 void TransportLayerASIO::ASIOTicket::finishFill(Status status) {
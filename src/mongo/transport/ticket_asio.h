@@ -28,7 +28,11 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/util/net/message.h"
 
 #include "asio.hpp"
 
@@ -83,6 +87,9 @@ private:
     void _headerCallback(const std::error_code& ec, size_t size);
     void _bodyCallback(const std::error_code& ec, size_t size);
 
+    // The header is read here first so that the message buffer can be taken from the
+    // MessageBufferPool at its final size once the message length is known.
+    std::array<char, sizeof(MSGHEADER::Value)> _headerBuffer;
     SharedBuffer _buffer;
     Message* _target;
 };
@@ -90,13 +97,19 @@ private:
 class TransportLayerASIO::ASIOSinkTicket : public TransportLayerASIO::ASIOTicket {
 public:
     ASIOSinkTicket(const ASIOSessionHandle& session, Date_t expiration, const Message& msg);
+    ASIOSinkTicket(const ASIOSessionHandle& session,
+                   Date_t expiration,
+                   const std::vector<Message>& msgs);
 
 protected:
     void fillImpl() final;
 
 private:
     void _sinkCallback(const std::error_code& ec, size_t size);
-    Message _msgToSend;
+
+    // Usually holds a single Message. When several are sunk together they are written with one
+    // gather write.
+    std::vector<Message> _msgsToSend;
 };
 
 }  // namespace transport
@@ -46,5 +46,12 @@ const Status TransportLayer::TicketSessionUnknownStatus = Status(
 const Status TransportLayer::TicketSessionClosedStatus = Status(
     ErrorCodes::TransportSessionClosed, "Operation attempted on a closed transport Session.");
 
+Ticket TransportLayer::sinkMessages(const SessionHandle& session,
+                                    const std::vector<Message>& messages,
+                                    Date_t expiration) {
+    invariant(messages.size() == 1);
+    return sinkMessage(session, messages.front(), expiration);
+}
+
 }  // namespace transport
 }  // namespace mongo
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/base/status.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/transport/session.h"
@@ -101,6 +103,25 @@ public:
                                const Message& message,
                                Date_t expiration = Ticket::kNoExpirationDate) = 0;
 
+    /**
+     * Like sinkMessage(), but sends all of 'messages' back to back. TransportLayers that
+     * return true from supportsBatchedSink() send them with a single gather write, without
+     * copying them into one buffer. All others only accept a single Message here.
+     *
+     * This method does NOT take ownership of the sunk Messages, which must be cleaned
+     * up by the caller.
+     */
+    virtual Ticket sinkMessages(const SessionHandle& session,
+                                const std::vector<Message>& messages,
+                                Date_t expiration = Ticket::kNoExpirationDate);
+
+    /**
+     * Returns true if sinkMessages() accepts more than one Message at a time.
+     */
+    virtual bool supportsBatchedSink() const {
+        return false;
+    }
+
     /**
      * Perform a synchronous wait on the given work Ticket. When this call returns,
      * the Ticket will have been completed. A call to wait() consumes the Ticket.
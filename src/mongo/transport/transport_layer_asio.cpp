@@ -101,6 +101,14 @@ Ticket TransportLayerASIO::sinkMessage(const SessionHandle& session,
     return {this, std::move(ticket)};
 }
 
+Ticket TransportLayerASIO::sinkMessages(const SessionHandle& session,
+                                        const std::vector<Message>& messages,
+                                        Date_t expiration) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    auto ticket = stdx::make_unique<ASIOSinkTicket>(asioSession, expiration, messages);
+    return {this, std::move(ticket)};
+}
+
 Status TransportLayerASIO::wait(Ticket&& ticket) {
     auto ownedASIOTicket = getOwnedTicketImpl(std::move(ticket));
     auto asioTicket = checked_cast<ASIOTicket*>(ownedASIOTicket.get());
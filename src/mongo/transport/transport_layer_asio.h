@@ -101,6 +101,14 @@ public:
                        const Message& message,
                        Date_t expiration = Ticket::kNoExpirationDate) final;
 
+    Ticket sinkMessages(const SessionHandle& session,
+                        const std::vector<Message>& messages,
+                        Date_t expiration = Ticket::kNoExpirationDate) final;
+
+    bool supportsBatchedSink() const final {
+        return true;
+    }
+
     Status wait(Ticket&& ticket) final;
 
     void asyncWait(Ticket&& ticket, TicketCallback callback) final;
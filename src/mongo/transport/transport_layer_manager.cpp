@@ -36,6 +36,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/service_executor_adaptive.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/service_executor_work_stealing.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_asio.h"
 #include "mongo/util/net/ssl_types.h"
@@ -61,6 +62,12 @@ Ticket TransportLayerManager::sinkMessage(const SessionHandle& session,
     return session->getTransportLayer()->sinkMessage(session, message, expiration);
 }
 
+Ticket TransportLayerManager::sinkMessages(const SessionHandle& session,
+                                           const std::vector<Message>& messages,
+                                           Date_t expiration) {
+    return session->getTransportLayer()->sinkMessages(session, messages, expiration);
+}
+
 Status TransportLayerManager::wait(Ticket&& ticket) {
     return getTicketTransportLayer(ticket)->wait(std::move(ticket));
 }
@@ -129,7 +136,7 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
     auto sep = ctx->getServiceEntryPoint();
 
     transport::TransportLayerASIO::Options opts(config);
-    if (config->serviceExecutor == "adaptive") {
+    if (config->serviceExecutor == "adaptive" || config->serviceExecutor == "workStealing") {
         opts.transportMode = transport::Mode::kAsynchronous;
     } else if (config->serviceExecutor == "synchronous") {
         opts.transportMode = transport::Mode::kSynchronous;
@@ -142,6 +149,9 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
     if (config->serviceExecutor == "adaptive") {
         ctx->setServiceExecutor(
             stdx::make_unique<ServiceExecutorAdaptive>(ctx, transportLayerASIO->getIOContext()));
+    } else if (config->serviceExecutor == "workStealing") {
+        ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorWorkStealing>(
+            ctx, transportLayerASIO->getIOContext()));
     } else if (config->serviceExecutor == "synchronous") {
         ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorSynchronous>(ctx));
     }
@@ -65,6 +65,9 @@ public:
     Ticket sinkMessage(const SessionHandle& session,
                        const Message& message,
                        Date_t expiration = Ticket::kNoExpirationDate) override;
+    Ticket sinkMessages(const SessionHandle& session,
+                        const std::vector<Message>& messages,
+                        Date_t expiration = Ticket::kNoExpirationDate) override;
 
     Status wait(Ticket&& ticket) override;
     void asyncWait(Ticket&& ticket, TicketCallback callback) override;
@@ -31,186 +31,239 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
+#include <algorithm>
 
-#include "mongo/util/log.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
-#if defined(__linux__)
 namespace {
-void _check(int ret) {
-    if (ret == 0)
-        return;
-    int err = errno;
-    severe() << "error in Ticketholder: " << errnoWithDescription(err);
-    fassertFailed(28604);
+// Upper bounds, in microseconds, of all but the last wait time histogram bucket, and the names
+// under which the buckets are reported.
+const long long kWaitBucketBounds[] = {100, 1000, 10000, 100000, 1000000};
+const char* const kWaitBucketNames[] = {"lt100us", "lt1ms", "lt10ms", "lt100ms", "lt1s", "ge1s"};
+
+const char* const kPriorityNames[] = {"low", "normal", "high"};
+}  // namespace
+
+struct TicketHolder::Waiter {
+    explicit Waiter(Priority priority) : priority(priority) {}
+
+    const Priority priority;
+    bool granted = false;
+    stdx::condition_variable cv;
+
+    Waiter* prev = nullptr;
+    Waiter* next = nullptr;
+};
+
+void TicketHolder::WaitQueue::push(Waiter* waiter) {
+    waiter->prev = tail;
+    waiter->next = nullptr;
+    if (tail) {
+        tail->next = waiter;
+    } else {
+        head = waiter;
+    }
+    tail = waiter;
+    size.fetchAndAdd(1);
 }
+
+void TicketHolder::WaitQueue::remove(Waiter* waiter) {
+    if (waiter->prev) {
+        waiter->prev->next = waiter->next;
+    } else {
+        head = waiter->next;
+    }
+    if (waiter->next) {
+        waiter->next->prev = waiter->prev;
+    } else {
+        tail = waiter->prev;
+    }
+    waiter->prev = waiter->next = nullptr;
+    size.fetchAndSubtract(1);
 }
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
-    _check(sem_init(&_sem, 0, num));
+void TicketHolder::WaitStats::record(long long micros) {
+    waits.fetchAndAdd(1);
+    totalWaitMicros.fetchAndAdd(micros);
+
+    int bucket = 0;
+    while (bucket < kNumBuckets - 1 && micros >= kWaitBucketBounds[bucket]) {
+        ++bucket;
+    }
+    histogram[bucket].fetchAndAdd(1);
 }
 
-TicketHolder::~TicketHolder() {
-    _check(sem_destroy(&_sem));
+TicketHolder::TicketHolder(int num) : _available(num), _outof(num) {}
+
+TicketHolder::~TicketHolder() = default;
+
+bool TicketHolder::tryAcquire(Priority priority) {
+    // Never overtake a queued thread that could use an available ticket, since it is about to be
+    // handed one. Threads kept away from the remaining tickets by their reserve don't count.
+    if (_numQueued.load() > 0 && _queuedWaiterCanAcquire())
+        return false;
+    return _tryAcquireAvailable(priority);
 }
 
-bool TicketHolder::tryAcquire() {
-    while (0 != sem_trywait(&_sem)) {
-        if (errno == EAGAIN)
-            return false;
-        if (errno != EINTR)
-            _check(-1);
-    }
-    return true;
+void TicketHolder::waitForTicket(Priority priority) {
+    const bool acquired = waitForTicketUntil(Date_t::max(), priority);
+    invariant(acquired);
 }
 
-void TicketHolder::waitForTicket() {
-    while (0 != sem_wait(&_sem)) {
-        if (errno != EINTR)
-            _check(-1);
+bool TicketHolder::waitForTicketUntil(Date_t until, Priority priority) {
+    if (tryAcquire(priority)) {
+        _immediateAcquisitions.fetchAndAdd(1);
+        return true;
     }
-}
 
-bool TicketHolder::waitForTicketUntil(Date_t until) {
-    const long long millisSinceEpoch = until.toMillisSinceEpoch();
-    struct timespec ts;
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+    auto& queue = _queues[static_cast<int>(priority)];
+    auto& stats = _waitStats[static_cast<int>(priority)];
+
+    // Publish the queued thread before looking for a ticket, so that a concurrent release() either
+    // sees it or leaves behind a ticket that the grant below picks up. Granting here, rather than
+    // only taking a free ticket, keeps the priority order when lower priority threads are queued.
+    Waiter waiter(priority);
+    queue.push(&waiter);
+    _numQueued.fetchAndAdd(1);
+    _grantTickets_inlock();
+    if (waiter.granted) {
+        _immediateAcquisitions.fetchAndAdd(1);
+        return true;
+    }
+
+    const auto start = curTimeMicros64();
 
-    ts.tv_sec = millisSinceEpoch / 1000;
-    ts.tv_nsec = (millisSinceEpoch % 1000) * (1000 * 1000);
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT)
-            return false;
+    if (until == Date_t::max()) {
+        waiter.cv.wait(lk, [&] { return waiter.granted; });
+    } else {
+        waiter.cv.wait_until(lk, until.toSystemTimePoint(), [&] { return waiter.granted; });
+    }
 
-        if (errno != EINTR)
-            _check(-1);
+    if (!waiter.granted) {
+        queue.remove(&waiter);
+        _numQueued.fetchAndSubtract(1);
+        stats.timeouts.fetchAndAdd(1);
+        return false;
     }
+
+    stats.record(curTimeMicros64() - start);
     return true;
 }
 
 void TicketHolder::release() {
-    _check(sem_post(&_sem));
+    _available.fetchAndAdd(1);
+    if (_numQueued.load() == 0)
+        return;
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _grantTickets_inlock();
 }
 
 Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<stdx::mutex> lk(_resizeMutex);
-
-    if (newSize < 5)
+    if (newSize < 5) {
         return Status(ErrorCodes::BadValue,
                       str::stream() << "Minimum value for semaphore is 5; given " << newSize);
-
-    if (newSize > SEM_VALUE_MAX)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
-                                    << "; given "
-                                    << newSize);
-
-    while (_outof.load() < newSize) {
-        release();
-        _outof.fetchAndAdd(1);
     }
 
-    while (_outof.load() > newSize) {
-        waitForTicket();
-        _outof.subtractAndFetch(1);
-    }
-
-    invariant(_outof.load() == newSize);
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    const int delta = newSize - _outof.load();
+    _outof.store(newSize);
+    _available.fetchAndAdd(delta);
+    _grantTickets_inlock();
     return Status::OK();
 }
 
 int TicketHolder::available() const {
-    int val = 0;
-    _check(sem_getvalue(&_sem, &val));
-    return val;
+    return std::max(_available.load(), 0);
 }
 
 int TicketHolder::used() const {
-    return outof() - available();
+    return outof() - _available.load();
 }
 
 int TicketHolder::outof() const {
     return _outof.load();
 }
 
-#else
-
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
-
-TicketHolder::~TicketHolder() = default;
-
-bool TicketHolder::tryAcquire() {
+void TicketHolder::setReserved(Priority priority, int tickets) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    return _tryAcquire();
+    _reserved[static_cast<int>(priority)].store(tickets);
+    _grantTickets_inlock();
 }
 
-void TicketHolder::waitForTicket() {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+int TicketHolder::queued() const {
+    return _numQueued.load();
+}
 
-    while (!_tryAcquire()) {
-        _newTicket.wait(lk);
+void TicketHolder::appendStats(BSONObjBuilder* b) const {
+    b->append("out", used());
+    b->append("available", available());
+    b->append("totalTickets", outof());
+    b->append("queued", queued());
+    b->append("immediate", _immediateAcquisitions.load());
+
+    BSONObjBuilder waitsBuilder(b->subobjStart("waits"));
+    for (int i = 0; i < kNumPriorities; ++i) {
+        const auto& stats = _waitStats[i];
+        BSONObjBuilder priorityBuilder(waitsBuilder.subobjStart(kPriorityNames[i]));
+        priorityBuilder.append("reservedTickets", _reserved[i].load());
+        priorityBuilder.append("count", stats.waits.load());
+        priorityBuilder.append("timeouts", stats.timeouts.load());
+        priorityBuilder.append("totalWaitMicros", stats.totalWaitMicros.load());
+
+        BSONObjBuilder histogramBuilder(priorityBuilder.subobjStart("histogram"));
+        for (int bucket = 0; bucket < WaitStats::kNumBuckets; ++bucket) {
+            histogramBuilder.append(kWaitBucketNames[bucket], stats.histogram[bucket].load());
+        }
     }
 }
 
-bool TicketHolder::waitForTicketUntil(Date_t until) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-
-    return _newTicket.wait_until(lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+int TicketHolder::_reservedFor(Priority priority) const {
+    const int reserved =
+        std::min(_reserved[static_cast<int>(priority)].load(), _outof.load() - 1);
+    return std::max(reserved, 0);
 }
 
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
-        _num++;
+bool TicketHolder::_queuedWaiterCanAcquire() const {
+    const int available = _available.load();
+    for (int i = 0; i < kNumPriorities; ++i) {
+        if (_queues[i].size.load() > 0 && available > _reservedFor(static_cast<Priority>(i)))
+            return true;
     }
-    _newTicket.notify_one();
+    return false;
 }
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
-
-        std::string errmsg = ss.str();
-        log() << errmsg;
-        return Status(ErrorCodes::BadValue, errmsg);
+bool TicketHolder::_tryAcquireAvailable(Priority priority) {
+    const int reserved = _reservedFor(priority);
+    int available = _available.load();
+    while (available > reserved) {
+        const int previous = _available.compareAndSwap(available, available - 1);
+        if (previous == available)
+            return true;
+        available = previous;
     }
-
-    _outof.store(newSize);
-    _num = _outof.load() - used;
-
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
-    return Status::OK();
-}
-
-int TicketHolder::available() const {
-    return _num;
-}
-
-int TicketHolder::used() const {
-    return outof() - _num;
+    return false;
 }
 
-int TicketHolder::outof() const {
-    return _outof.load();
-}
-
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
+void TicketHolder::_grantTickets_inlock() {
+    for (int i = kNumPriorities - 1; i >= 0; --i) {
+        auto& queue = _queues[i];
+        while (queue.head && _tryAcquireAvailable(static_cast<Priority>(i))) {
+            // The waiter owns the ticket from here on, even if its deadline passes before it
+            // wakes up.
+            auto waiter = queue.head;
+            queue.remove(waiter);
+            _numQueued.fetchAndSubtract(1);
+            waiter->granted = true;
+            waiter->cv.notify_one();
         }
-        return false;
     }
-    _num--;
-    return true;
-}
-#endif
 }
+
+}  // namespace mongo
@@ -26,56 +26,142 @@
  */
 #pragma once
 
-#if defined(__linux__)
-#include <semaphore.h>
-#endif
+#include <array>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
-#include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+
+/**
+ * Counting semaphore that queues waiters instead of letting them race for released tickets.
+ *
+ * While nobody is queued, tickets are taken and returned with a single atomic operation. Once
+ * threads have to wait, each one sleeps on its own condition variable in a FIFO queue for its
+ * priority, and a released ticket is handed directly to the oldest waiter of the highest priority
+ * that has one. This avoids waking every waiter on each release and keeps newly arriving threads
+ * from overtaking ones that have been queued for longer.
+ *
+ * Each priority can additionally be kept away from a number of reserved tickets, so that for
+ * example background work cannot take the last tickets needed by user operations.
+ */
 class TicketHolder {
     MONGO_DISALLOW_COPYING(TicketHolder);
 
 public:
+    enum class Priority { kLow = 0, kNormal = 1, kHigh = 2 };
+    static constexpr int kNumPriorities = 3;
+
     explicit TicketHolder(int num);
     ~TicketHolder();
 
-    bool tryAcquire();
+    bool tryAcquire(Priority priority = Priority::kNormal);
 
-    void waitForTicket();
+    void waitForTicket(Priority priority = Priority::kNormal);
 
-    bool waitForTicketUntil(Date_t until);
+    bool waitForTicketUntil(Date_t until, Priority priority = Priority::kNormal);
 
     void release();
 
+    /**
+     * Changes the number of tickets, which must be at least 5. Shrinking never blocks: tickets in
+     * use above the new limit are retired as they are released.
+     */
     Status resize(int newSize);
 
+    /**
+     * Number of tickets that can be acquired. Never negative, even while tickets in use above a
+     * shrunk limit are yet to be released.
+     */
     int available() const;
 
     int used() const;
 
     int outof() const;
 
-private:
-#if defined(__linux__)
-    mutable sem_t _sem;
+    /**
+     * Makes the last 'tickets' available tickets unusable for acquisitions at 'priority'. The
+     * reserve is capped so that every priority can always use at least one ticket.
+     */
+    void setReserved(Priority priority, int tickets);
 
-    // You can read _outof without a lock, but have to hold _resizeMutex to change.
-    AtomicInt32 _outof;
-    stdx::mutex _resizeMutex;
-#else
-    bool _tryAcquire();
+    /**
+     * Number of threads currently queued for a ticket.
+     */
+    int queued() const;
 
+    /**
+     * Appends the ticket counts, the current queue length and per-priority wait time histograms.
+     */
+    void appendStats(BSONObjBuilder* b) const;
+
+private:
+    struct Waiter;
+
+    /**
+     * FIFO of waiters linked through the Waiter nodes, which live on the waiting threads' stacks.
+     */
+    struct WaitQueue {
+        void push(Waiter* waiter);
+        void remove(Waiter* waiter);
+
+        Waiter* head = nullptr;
+        Waiter* tail = nullptr;
+
+        // Only changed under the mutex, but read without it by tryAcquire().
+        AtomicInt32 size;
+    };
+
+    struct WaitStats {
+        // Waits are bucketed by powers of ten from under 100us up to 1s and above.
+        static constexpr int kNumBuckets = 6;
+
+        void record(long long micros);
+
+        AtomicInt64 waits;
+        AtomicInt64 timeouts;
+        AtomicInt64 totalWaitMicros;
+        std::array<AtomicInt64, kNumBuckets> histogram;
+    };
+
+    bool _tryAcquireAvailable(Priority priority);
+
+    /**
+     * Number of available tickets that acquisitions at 'priority' have to leave alone.
+     */
+    int _reservedFor(Priority priority) const;
+
+    /**
+     * Returns true if a queued thread could take one of the currently available tickets.
+     */
+    bool _queuedWaiterCanAcquire() const;
+
+    /**
+     * Hands available tickets to queued waiters, highest priority first.
+     */
+    void _grantTickets_inlock();
+
+    // Number of tickets that can be acquired. Goes negative after shrinking while more tickets
+    // than the new total are in use.
+    AtomicInt32 _available;
     AtomicInt32 _outof;
-    int _num;
+
+    // Incremented before a thread enqueues so that release() knows to take the mutex.
+    AtomicInt32 _numQueued;
+
+    AtomicInt64 _immediateAcquisitions;
+
+    std::array<AtomicInt32, kNumPriorities> _reserved;
+
     stdx::mutex _mutex;
-    stdx::condition_variable _newTicket;
-#endif
+    std::array<WaitQueue, kNumPriorities> _queues;
+    std::array<WaitStats, kNumPriorities> _waitStats;
 };
 
 class ScopedTicket {
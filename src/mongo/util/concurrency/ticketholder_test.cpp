@@ -31,8 +31,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
@@ -71,4 +78,147 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+void waitForQueued(const TicketHolder& holder, int n) {
+    while (holder.queued() != n) {
+        sleepmillis(1);
+    }
+}
+
+TEST(TicketholderTest, WaitersAreServedByPriorityThenArrival) {
+    TicketHolder holder(1);
+    holder.waitForTicket();
+
+    stdx::mutex mutex;
+    std::vector<int> order;
+    std::vector<stdx::thread> threads;
+    const TicketHolder::Priority priorities[] = {TicketHolder::Priority::kNormal,
+                                                 TicketHolder::Priority::kLow,
+                                                 TicketHolder::Priority::kNormal,
+                                                 TicketHolder::Priority::kHigh};
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            holder.waitForTicket(priorities[i]);
+            {
+                stdx::lock_guard<stdx::mutex> lk(mutex);
+                order.push_back(i);
+            }
+            holder.release();
+        });
+        waitForQueued(holder, i + 1);
+    }
+
+    // An arriving thread must not take a ticket in front of the queued ones.
+    ASSERT_FALSE(holder.tryAcquire());
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(order.size(), 4U);
+    ASSERT_EQ(order[0], 3);
+    ASSERT_EQ(order[1], 0);
+    ASSERT_EQ(order[2], 2);
+    ASSERT_EQ(order[3], 1);
+    ASSERT_EQ(holder.used(), 0);
+    ASSERT_EQ(holder.queued(), 0);
+
+    BSONObjBuilder builder;
+    holder.appendStats(&builder);
+    const auto stats = builder.obj();
+    ASSERT_EQ(stats["waits"]["normal"]["count"].numberLong(), 2);
+    ASSERT_EQ(stats["waits"]["high"]["count"].numberLong(), 1);
+    ASSERT_EQ(stats["waits"]["low"]["count"].numberLong(), 1);
+}
+
+TEST(TicketholderTest, ResizeHandsTicketsToWaiters) {
+    TicketHolder holder(5);
+    for (int i = 0; i < 5; ++i) {
+        holder.waitForTicket();
+    }
+
+    stdx::thread waiter([&] {
+        holder.waitForTicket();
+        holder.release();
+    });
+    waitForQueued(holder, 1);
+
+    ASSERT_OK(holder.resize(6));
+    waiter.join();
+    ASSERT_EQ(holder.used(), 5);
+
+    // Shrinking below the number of tickets in use retires them as they come back, without
+    // reporting a negative number of available tickets in the meantime.
+    ASSERT(holder.tryAcquire());
+    ASSERT_OK(holder.resize(5));
+    ASSERT_EQ(holder.available(), 0);
+    ASSERT_EQ(holder.used(), 6);
+    ASSERT_FALSE(holder.tryAcquire());
+    holder.release();
+    ASSERT_EQ(holder.available(), 0);
+    ASSERT_EQ(holder.used(), 5);
+    ASSERT_FALSE(holder.tryAcquire());
+    holder.release();
+    ASSERT_EQ(holder.available(), 1);
+    ASSERT_EQ(holder.used(), 4);
+
+    ASSERT_NOT_OK(holder.resize(4));
+    ASSERT_NOT_OK(holder.resize(0));
+    ASSERT_EQ(holder.outof(), 5);
+
+    for (int i = 0; i < 4; ++i) {
+        holder.release();
+    }
+    ASSERT_EQ(holder.used(), 0);
+}
+
+TEST(TicketholderTest, ReservedTicketsAreKeptFromLowerPriorities) {
+    TicketHolder holder(3);
+    holder.setReserved(TicketHolder::Priority::kLow, 2);
+
+    ASSERT(holder.tryAcquire(TicketHolder::Priority::kLow));
+    ASSERT_FALSE(holder.tryAcquire(TicketHolder::Priority::kLow));
+    ASSERT_FALSE(
+        holder.waitForTicketUntil(Date_t::now() + Milliseconds(1), TicketHolder::Priority::kLow));
+
+    // A queued low priority thread does not hold back higher priorities.
+    stdx::thread lowWaiter([&] {
+        holder.waitForTicket(TicketHolder::Priority::kLow);
+        holder.release();
+    });
+    waitForQueued(holder, 1);
+    ASSERT(holder.waitForTicketUntil(Date_t::now(), TicketHolder::Priority::kNormal));
+    ASSERT(holder.waitForTicketUntil(Date_t::now(), TicketHolder::Priority::kHigh));
+    ASSERT_EQ(holder.queued(), 1);
+
+    // Lowering the reserve lets the queued thread in once a ticket comes back.
+    holder.setReserved(TicketHolder::Priority::kLow, 0);
+    holder.release();
+    lowWaiter.join();
+    holder.release();
+    holder.release();
+    ASSERT_EQ(holder.used(), 0);
+
+    // A queued thread held back only by its reserve does not push others off the fast path.
+    holder.setReserved(TicketHolder::Priority::kLow, 2);
+    ASSERT(holder.tryAcquire(TicketHolder::Priority::kNormal));
+    lowWaiter = stdx::thread([&] {
+        holder.waitForTicket(TicketHolder::Priority::kLow);
+        holder.release();
+    });
+    waitForQueued(holder, 1);
+    ASSERT(holder.tryAcquire(TicketHolder::Priority::kNormal));
+    holder.release();
+    holder.release();
+    lowWaiter.join();
+    ASSERT_EQ(holder.used(), 0);
+    ASSERT_EQ(holder.queued(), 0);
+
+    // Every priority can use at least one ticket, however large the reserve.
+    TicketHolder single(1);
+    single.setReserved(TicketHolder::Priority::kLow, 10);
+    ASSERT(single.tryAcquire(TicketHolder::Priority::kLow));
+    single.release();
+}
 }  // namespace
@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/intrusive_ptr.hpp>
+#include <cstring>
 
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/allocator.h"
@@ -40,7 +42,38 @@ namespace mongo {
  * A mutable, ref-counted buffer.
  */
 class SharedBuffer {
+private:
+    class Holder;
+
 public:
+    /**
+     * Implemented by allocators that want buffers handed back to them for reuse rather than
+     * freed once the last reference goes away. A Recycler must outlive every buffer it hands out.
+     */
+    class Recycler {
+    public:
+        /**
+         * Takes back the memory of a buffer with the given capacity. 'headerPrefixedData' is the
+         * pointer originally passed to takeRecyclableOwnership() and was allocated with
+         * mongoMalloc(kRecyclableHeaderSize + capacity).
+         */
+        virtual void recycle(void* headerPrefixedData, size_t capacity) = 0;
+
+    protected:
+        ~Recycler() = default;
+    };
+
+    /**
+     * The number of bytes which precede the data of every buffer for its bookkeeping.
+     */
+    static constexpr size_t kHolderSize = 8;
+
+    /**
+     * The number of bytes which must precede the data of a recyclable buffer. Only these buffers
+     * pay for the pointer to their Recycler, which is stored just ahead of their Holder.
+     */
+    static constexpr size_t kRecyclableHeaderSize = sizeof(Recycler*) + kHolderSize;
+
     SharedBuffer() = default;
 
     void swap(SharedBuffer& other) {
@@ -48,7 +81,7 @@ public:
     }
 
     static SharedBuffer allocate(size_t bytes) {
-        return takeOwnership(mongoMalloc(sizeof(Holder) + bytes), bytes);
+        return takeOwnership(mongoMalloc(kHolderSize + bytes), bytes);
     }
 
     /**
@@ -62,7 +95,16 @@ public:
     void realloc(size_t size) {
         invariant(!_holder || !_holder->isShared());
 
-        const size_t realSize = size + sizeof(Holder);
+        // The memory of a recyclable buffer does not start at its Holder and belongs to its
+        // Recycler, so copy the contents into a plain buffer and hand the old one back.
+        if (_holder && _holder->isRecyclable()) {
+            auto tmp = SharedBuffer::allocate(size);
+            memcpy(tmp.get(), get(), std::min(size, capacity()));
+            swap(tmp);
+            return;
+        }
+
+        const size_t realSize = size + kHolderSize;
         void* newPtr = mongoRealloc(_holder.get(), realSize);
 
         // Get newPtr into _holder with a ref-count of 1 without touching the current pointee of
@@ -72,6 +114,20 @@ public:
         _holder = std::move(tmp._holder);
     }
 
+    /**
+     * Like allocate(), but over memory supplied by the caller, which must have been allocated
+     * with mongoMalloc(kRecyclableHeaderSize + capacity). Once the last reference goes away the
+     * memory is passed to 'recycler' instead of being freed.
+     */
+    static SharedBuffer takeRecyclableOwnership(void* headerPrefixedData,
+                                                size_t capacity,
+                                                Recycler* recycler) {
+        invariant(recycler);
+        *static_cast<Recycler**>(headerPrefixedData) = recycler;
+        return SharedBuffer(new (static_cast<char*>(headerPrefixedData) + sizeof(Recycler*))
+                                Holder(1U, capacity, /*recyclable=*/true));
+    }
+
     char* get() const {
         return _holder ? _holder->data() : NULL;
     }
@@ -93,15 +149,18 @@ public:
      * Users of this type must maintain the "used" size separately.
      */
     size_t capacity() const {
-        return _holder ? _holder->_capacity : 0;
+        return _holder ? _holder->capacity() : 0;
     }
 
 private:
     class Holder {
     public:
-        explicit Holder(AtomicUInt32::WordType initial, size_t capacity)
+        explicit Holder(AtomicUInt32::WordType initial, size_t capacity, bool recyclable = false)
             : _refCount(initial), _capacity(capacity) {
-            invariant(capacity == _capacity);
+            invariant(capacity < kRecyclableFlag);
+            if (recyclable) {
+                _capacity |= kRecyclableFlag;
+            }
         }
 
         // these are called automatically by boost::intrusive_ptr
@@ -113,8 +172,15 @@ private:
             if (h->_refCount.subtractAndFetch(1) == 0) {
                 // We placement new'ed a Holder in takeOwnership above,
                 // so we must destroy the object here.
+                const bool recyclable = h->isRecyclable();
+                const size_t capacity = h->capacity();
                 h->~Holder();
-                free(h);
+                if (recyclable) {
+                    auto header = reinterpret_cast<char*>(h) - sizeof(Recycler*);
+                    (*reinterpret_cast<Recycler**>(header))->recycle(header, capacity);
+                } else {
+                    free(h);
+                }
             }
         }
 
@@ -130,10 +196,26 @@ private:
             return _refCount.load() > 1;
         }
 
+        size_t capacity() const {
+            return _capacity & ~kRecyclableFlag;
+        }
+
+        // Recyclable buffers keep a pointer to their Recycler just ahead of the Holder.
+        bool isRecyclable() const {
+            return _capacity & kRecyclableFlag;
+        }
+
+    private:
+        // Capacities are limited to 31 bits, so the top bit of _capacity marks recyclable buffers
+        // without growing the Holder of every other buffer.
+        static constexpr uint32_t kRecyclableFlag = 1U << 31;
+
         AtomicUInt32 _refCount;
         uint32_t _capacity;
     };
 
+    static_assert(sizeof(Holder) == kHolderSize, "SharedBuffer::Holder must be kHolderSize bytes");
+
     explicit SharedBuffer(Holder* holder) : _holder(holder, /*add_ref=*/false) {
         // NOTE: The 'false' above is because we have already initialized the Holder with a
         // refcount of '1' in takeOwnership below. This avoids an atomic increment.